@@ -63,7 +63,7 @@ exact_mig_command::exact_mig_command( const environment::ptr& env )
     ( "start_depth",       value_with_default( &start_depth ), "start value for depth enumeration" )
     ( "mig,m",                                                 "load spec from MIG instead of truth table" )
     ( "incremental,i",                                         "incremental SAT solving" )
-    ( "all_solutions,a",                                       "enumerate all solutions (only with non incremental)" )
+    ( "all_solutions,a",                                       "enumerate all solutions" )
     ( "breaking",          value_with_default( &breaking ),    "symmetry breaking\ns: structural hashing\na: associativity\nl: co-lexicographic ordering\nt: support\ny: symmetric variables" )
     ( "print_solutions",                                       "print solutions" )
     ( "enc_int",                                               "encode numbers as integers (not bit-vectors)" )
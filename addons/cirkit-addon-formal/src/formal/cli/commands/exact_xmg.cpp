@@ -91,9 +91,9 @@ bool exact_xmg_command::execute()
     settings->set( "timeout_heuristic", is_set( "timeout_heuristic" ) );
   }
 
-  const auto& tts = env->store<tt>();
-  auto& migs = env->store<mig_graph>();
-  auto& xmgs = env->store<xmg_graph>();
+  const auto& tts  = env->store<tt>();
+  const auto& migs = env->store<mig_graph>();
+  auto& xmgs       = env->store<xmg_graph>();
 
   if ( is_set( "mig" ) )
   {
@@ -87,8 +87,8 @@ command::rules_t xmglut_command::validity_rules() const
 
 bool xmglut_command::execute()
 {
-  auto& aigs = env->store<aig_graph>();
-  auto& xmgs = env->store<xmg_graph>();
+  const auto& aigs = env->store<aig_graph>();
+  auto& xmgs       = env->store<xmg_graph>();
 
   auto settings = make_settings();
   settings->set( "lut_size", lut_size );
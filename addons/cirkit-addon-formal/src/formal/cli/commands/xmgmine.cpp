@@ -58,7 +58,7 @@ command::rules_t xmgmine_command::validity_rules() const
     {[this]() { return is_set( "verify" ) || is_set( "add" ) || is_set( "lut_file" ); }, "lut_file or verify needs to be set" },
     {[this]() { return is_set( "verify" ) || is_set( "add" ) || boost::filesystem::exists( lut_file ); }, "lut_file does not exist" },
     {[this]() { return !is_set( "add" ) || env->store<xmg_graph>().current_index() != -1; }, "no XMG in store" },
-    {[this]() { return !is_set( "add" ) || env->store<xmg_graph>().current().outputs().size() == 1u; }, "XMG can only have one output" },
+    {[this]() { const auto& xmgs = env->store<xmg_graph>(); return !is_set( "add" ) || xmgs.current().outputs().size() == 1u; }, "XMG can only have one output" },
     file_exists_if_set( *this, opt_file, "opt_file" )
   };
 }
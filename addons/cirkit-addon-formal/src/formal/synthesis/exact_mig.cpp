@@ -567,7 +567,7 @@ struct exact_mig_instance
     }
   }
 
-  void constrain( const mig_graph& mig )
+  z3::expr spec_equivalence( const mig_graph& mig )
   {
     z3::params p( ctx );
     p.set( "mbqi", true );
@@ -658,60 +658,122 @@ struct exact_mig_instance
     const auto out2 = logic_xor( *node_to_expr[o.node], ctx.bool_val( o.complemented ) );
 
     /* build everything */
-    const auto forall_expr = forall( all_vars, out1 == out2 );
-    solver.add( forall_expr );
+    return forall( all_vars, out1 == out2 );
   }
 
-  void constrain( const tt& spec )
+  void constrain( const mig_graph& mig )
   {
-    auto N = 1u << num_vars;
+    solver.add( spec_equivalence( mig ) );
+  }
 
-    std::vector<std::vector<z3::expr>> out( N );
-    std::vector<std::vector<std::vector<z3::expr>>> in( 3u, std::vector<std::vector<z3::expr>>( N ) );
+  /* the quantified encoding cannot be shared among levels, but the solver
+   * (and everything it learned about the gate selectors) is kept */
+  void constrain_incremental( const mig_graph& mig )
+  {
+    solver.add( implies( create_activation(), spec_equivalence( mig ) ) );
+  }
+
+  inline z3::expr out_var( unsigned j, unsigned level )
+  {
+    return ctx.bool_const( str( format( "out_%d_%d" ) % j % level ).c_str() );
+  }
+
+  /* value constraints of one gate for all minterms, they do not depend on whether the gate is the output */
+  void add_value_constraints( unsigned level )
+  {
+    auto N = 1u << num_vars;
 
-    /* value constraints */
     for ( auto j = 0u; j < N; ++j )
     {
-      for ( auto level = 0u; level < gates.size(); ++level )
+      const auto out = out_var( j, level );
+      const z3::expr in[] = {ctx.bool_const( str( format( "in1_%d_%d" ) % j % level ).c_str() ),
+                             ctx.bool_const( str( format( "in2_%d_%d" ) % j % level ).c_str() ),
+                             ctx.bool_const( str( format( "in3_%d_%d" ) % j % level ).c_str() )};
+
+      /* assertion for out[j][level] = M(in1[j][level],in2[j][level],in3[j][level] */
+      if ( with_xor )
+      {
+        solver.add( out == ( implies( !gates[level].type(), ( in[0u] && in[1u] ) || ( in[0u] && in[2u] ) || ( in[1u] && in[2u] ) )
+                             && implies( gates[level].type(), logic_xor( in[0u], in[1u] ) ) ) );
+      }
+      else
+      {
+        solver.add( out == ( ( in[0u] && in[1u] ) || ( in[0u] && in[2u] ) || ( in[1u] && in[2u] ) ) );
+      }
+
+      /* assertions for in[x][j][level] = neg[level] ^ ite( sel[level], ... ) */
+      boost::dynamic_bitset<> val( num_vars, j );
+      for ( auto x = 0u; x < 3u; ++x )
       {
-        out[j] += ctx.bool_const( str( format( "out_%d_%d" ) % j % level ).c_str() );
-        in[0u][j] += ctx.bool_const( str( format( "in1_%d_%d" ) % j % level ).c_str() );
-        in[1u][j] += ctx.bool_const( str( format( "in2_%d_%d" ) % j % level ).c_str() );
-        in[2u][j] += ctx.bool_const( str( format( "in3_%d_%d" ) % j % level ).c_str() );
+        solver.add( implies( equals( gates[level][x].sel, 0 ),
+                             in[x] == logic_xor( gates[level][x].neg, ctx.bool_val( false ) ) ) );
 
-        /* assertion for out[j][level] = M(in1[j][level],in2[j][level],in3[j][level] */
-        if ( with_xor )
+        for ( auto l = 0u; l < num_vars; ++l )
         {
-          solver.add( out[j][level] == ( implies( !gates[level].type(), ( in[0u][j][level] && in[1u][j][level] ) || ( in[0u][j][level] && in[2u][j][level] ) || ( in[1u][j][level] && in[2u][j][level] ) )
-                                         && implies( gates[level].type(), logic_xor( in[0u][j][level], in[1u][j][level] ) ) ) );
+          solver.add( implies( equals( gates[level][x].sel, l + 1 ),
+                               in[x] == logic_xor( gates[level][x].neg, ctx.bool_val( val[l] ) ) ) );
         }
-        else
+        for ( auto l = 0u; l < level; ++l )
         {
-          solver.add( out[j][level] == ( ( in[0u][j][level] && in[1u][j][level] ) || ( in[0u][j][level] && in[2u][j][level] ) || ( in[1u][j][level] && in[2u][j][level] ) ) );
+          solver.add( implies( equals( gates[level][x].sel, l + 1 + num_vars ),
+                               in[x] == logic_xor( gates[level][x].neg, out_var( j, l ) ) ) );
         }
+      }
+    }
+  }
 
-        /* assertions for in[x][j][level] = neg[level] ^ ite( sel[level], ... ) */
-        boost::dynamic_bitset<> val( num_vars, j );
-        for ( auto x = 0u; x < 3u; ++x )
-        {
-          solver.add( implies( equals( gates[level][x].sel, 0 ),
-                               in[x][j][level] == logic_xor( gates[level][x].neg, ctx.bool_val( false ) ) ) );
+  void constrain( const tt& spec )
+  {
+    for ( auto level = 0u; level < gates.size(); ++level )
+    {
+      add_value_constraints( level );
+    }
 
-          for ( auto l = 0u; l < num_vars; ++l )
-          {
-            solver.add( implies( equals( gates[level][x].sel, l + 1 ),
-                                 in[x][j][level] == logic_xor( gates[level][x].neg, ctx.bool_val( val[l] ) ) ) );
-          }
-          for ( auto l = 0u; l < level; ++l )
-          {
-            solver.add( implies( equals( gates[level][x].sel, l + 1 + num_vars ),
-                                 in[x][j][level] == logic_xor( gates[level][x].neg, out[j][l] ) ) );
-          }
-        }
-      }
+    for ( auto j = 0u; j < spec.size(); ++j )
+    {
+      solver.add( out_var( j, gates.size() - 1u ) == ctx.bool_val( spec[j] ) );
+    }
+  }
+
+  /* only adds value constraints for new gates; the spec is asserted on the
+   * last gate under a fresh activation literal, which is assumed in check() */
+  void constrain_incremental( const tt& spec )
+  {
+    for ( ; num_constrained < gates.size(); ++num_constrained )
+    {
+      add_value_constraints( num_constrained );
+    }
+
+    const auto act = create_activation();
+    for ( auto j = 0u; j < spec.size(); ++j )
+    {
+      solver.add( implies( act, out_var( j, gates.size() - 1u ) == ctx.bool_val( spec[j] ) ) );
+    }
+  }
+
+  z3::expr create_activation()
+  {
+    /* output constraints for fewer gates are unsatisfiable, disabling them
+     * permanently lets the solver simplify its clause database */
+    if ( !activations.empty() )
+    {
+      solver.add( !activations.back() );
+    }
+
+    activations += ctx.bool_const( str( format( "act%d" ) % gates.size() ).c_str() );
+    return activations.back();
+  }
 
-      solver.add( out[j].back() == ctx.bool_val( spec[j] ) );
+  z3::check_result check()
+  {
+    if ( activations.empty() )
+    {
+      return solver.check();
     }
+
+    z3::expr_vector assumptions( ctx );
+    assumptions.push_back( activations.back() );
+    return solver.check( assumptions );
   }
 
   mig_graph extract_mig( const std::string& model_name, const std::string& output_name, bool invert, bool very_verbose )
@@ -940,6 +1002,10 @@ struct exact_mig_instance
 
   unsigned bw;
 
+  /* incremental encoding */
+  unsigned              num_constrained = 0u;
+  std::vector<z3::expr> activations;
+
   /* spec properties */
   boost::dynamic_bitset<>                    support;
   std::vector<std::pair<unsigned, unsigned>> symmetries;
@@ -1198,9 +1264,8 @@ public:
       }
 
       /* solve */
-      inst->solver.push();
-      constrain( inst );
-      const auto result = inst->solver.check();
+      constrain_incremental( inst );
+      const auto result = inst->check();
       if ( result == z3::sat )
       {
         store_memory( inst );
@@ -1211,7 +1276,6 @@ public:
         last_size = inst->gates.size();
         return std::vector<T>();
       }
-      inst->solver.pop();
     }
   }
 
@@ -1300,7 +1364,7 @@ private:
       {
         migs.push_back( extract_solution<T>( inst ) );
         inst->block_solution();
-      } while ( inst->solver.check() == z3::sat );
+      } while ( inst->check() == z3::sat );
 
       return migs;
     }
@@ -1312,20 +1376,35 @@ private:
 
   struct constrain_visitor : public boost::static_visitor<void>
   {
-    constrain_visitor( const std::shared_ptr<exact_mig_instance>& inst ) : inst( inst ) {}
+    constrain_visitor( const std::shared_ptr<exact_mig_instance>& inst, bool incremental = false ) : inst( inst ), incremental( incremental ) {}
 
     void operator()( const tt& spec ) const
     {
-      inst->constrain( spec );
+      if ( incremental )
+      {
+        inst->constrain_incremental( spec );
+      }
+      else
+      {
+        inst->constrain( spec );
+      }
     }
 
     void operator()( const mig_graph& spec ) const
     {
-      inst->constrain( spec );
+      if ( incremental )
+      {
+        inst->constrain_incremental( spec );
+      }
+      else
+      {
+        inst->constrain( spec );
+      }
     }
 
   private:
     const std::shared_ptr<exact_mig_instance>& inst;
+    bool incremental;
   };
 
   void constrain( const std::shared_ptr<exact_mig_instance>& inst ) const
@@ -1333,6 +1412,11 @@ private:
     spec.apply_visitor( constrain_visitor( inst ) );
   }
 
+  void constrain_incremental( const std::shared_ptr<exact_mig_instance>& inst ) const
+  {
+    spec.apply_visitor( constrain_visitor( inst, true ) );
+  }
+
   void make_symmetry_breaking_bitset()
   {
     symmetry_breaking.resize( 7u );
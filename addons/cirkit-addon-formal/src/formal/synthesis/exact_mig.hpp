@@ -56,7 +56,7 @@ namespace cirkit
    | model_name          | Name of the MIG model                         | std::string( "exact" ) |
    | output_name         | Name of the output                            | std::string( "f" )     |
    | output_inverter     | Allow output inversion in encoding            | false                  |
-   | incremental         | Explicit or incremental SAT solving           | false                  |
+   | incremental         | Incremental SAT solving under assumptions     | false                  |
    | min_depth           | Smallest MIG with smallest depth              | false                  |
    | all_solutions       | Enumerate all solutions                       | false                  |
    | enc_with_bitvectors | Encode numbers as bit-vectors and not as ints | false                  |
@@ -0,0 +1,114 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE exact_mig
+
+#include <random>
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <core/properties.hpp>
+#include <classical/mig/mig.hpp>
+#include <classical/mig/mig_simulate.hpp>
+#include <classical/utils/truth_table_utils.hpp>
+#include <formal/synthesis/exact_mig.hpp>
+
+using namespace cirkit;
+
+tt var( unsigned i, unsigned n )
+{
+  auto t = tt_nth_var( i );
+  tt_extend( t, n );
+  return t;
+}
+
+tt maj( const tt& a, const tt& b, const tt& c )
+{
+  return ( a & b ) | ( a & c ) | ( b & c );
+}
+
+/* random 4-input function that is a composition of three majority gates */
+tt random_function( unsigned seed )
+{
+  std::default_random_engine gen( seed );
+  std::uniform_int_distribution<unsigned> dist_var( 0u, 3u );
+  std::uniform_int_distribution<unsigned> polarity( 0u, 1u );
+
+  const auto literal = [&]() {
+    const auto t = var( dist_var( gen ), 4u );
+    return polarity( gen ) ? ~t : t;
+  };
+
+  const auto g1 = maj( literal(), literal(), literal() );
+  const auto g2 = maj( literal(), literal(), polarity( gen ) ? ~g1 : g1 );
+  return maj( g1, g2, literal() );
+}
+
+/* number of gates of the exact MIG and checks its function */
+unsigned exact_size( const tt& spec, bool incremental )
+{
+  const auto settings = std::make_shared<properties>();
+  settings->set( "incremental", incremental );
+
+  const auto mig = exact_mig_with_sat( spec, settings );
+  BOOST_REQUIRE( (bool)mig );
+
+  const auto& info = mig_info( *mig );
+  BOOST_REQUIRE_EQUAL( info.outputs.size(), 1u );
+
+  auto t = simulate_mig_function( *mig, info.outputs.front().first, mig_tt_simulator() );
+  tt_extend( t, tt_num_vars( spec ) );
+  BOOST_CHECK( t == spec );
+
+  return boost::num_vertices( *mig ) - info.inputs.size() - 1u;
+}
+
+BOOST_AUTO_TEST_CASE(activation_literals)
+{
+  const auto x0 = var( 0u, 3u ), x1 = var( 1u, 3u ), x2 = var( 2u, 3u );
+
+  const std::vector<std::pair<tt, unsigned>> specs = {{maj( x0, x1, x2 ), 1u}, {x0 ^ x1 ^ x2, 3u}};
+  for ( const auto& p : specs )
+  {
+    BOOST_CHECK_EQUAL( exact_size( p.first, true ), p.second );
+    BOOST_CHECK_EQUAL( exact_size( p.first, false ), p.second );
+  }
+
+  /* incremental and non-incremental encodings find the same gate count */
+  for ( auto seed = 0u; seed < 3u; ++seed )
+  {
+    const auto spec = random_function( seed );
+    BOOST_CHECK_EQUAL( exact_size( spec, true ), exact_size( spec, false ) );
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
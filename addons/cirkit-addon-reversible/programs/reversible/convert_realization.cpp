@@ -0,0 +1,167 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @author agent
+ */
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+#include <boost/format.hpp>
+
+#include <core/utils/timer.hpp>
+#include <reversible/circuit.hpp>
+#include <reversible/functions/copy_metadata.hpp>
+#include <reversible/io/stream_realization.hpp>
+#include <reversible/io/write_qc.hpp>
+#include <reversible/io/write_realization.hpp>
+#include <reversible/mapping/nct_mapping.hpp>
+#include <reversible/utils/costs.hpp>
+#include <reversible/utils/reversible_program_options.hpp>
+
+using namespace cirkit;
+
+int main( int argc, char ** argv )
+{
+  using boost::program_options::value;
+
+  std::string qcname;
+
+  reversible_program_options opts;
+  opts.add_read_realization_option();
+  opts.add_write_realization_option();
+  opts.add_options()
+    ( "qcname",       value( &qcname ), "If given, then the circuit is written to a qc file" )
+    ( "nct",                            "Maps the circuit to NCT gates" )
+    ( "statistics,s",                   "Prints gate count, depth, and quantum costs" )
+    ;
+
+  opts.parse( argc, argv );
+
+  if ( !opts.good() )
+  {
+    std::cout << opts << std::endl;
+    return 1;
+  }
+
+  const auto& filename = opts.read_realization_filename();
+  std::string error;
+
+  /* the extra ancilla of the NCT mapping depends on all gates, find out in a first pass */
+  auto fully_controlled = false;
+  if ( opts.is_set( "nct" ) )
+  {
+    unsigned lines = 0u;
+    if ( !stream_realization( filename,
+                              [&lines]( const circuit& header ) { lines = header.lines(); },
+                              [&lines, &fully_controlled]( const gate& g, const std::map<std::string, std::string>& ) {
+                                fully_controlled = fully_controlled || ( g.controls().size() + g.targets().size() == lines ); },
+                              read_realization_settings(), &error ) )
+    {
+      std::cerr << "[e] " << error << std::endl;
+      return 1;
+    }
+  }
+
+  std::ofstream realos, qcos;
+  std::unique_ptr<costs_accumulator> gates, quantum_costs;
+  std::unique_ptr<nct_mapping_stream> mapper;
+  const std::map<std::string, std::string> no_annotations;
+
+  auto emit = [&]( const gate& g, const std::map<std::string, std::string>& annotations ) {
+    if ( realos.is_open() ) { write_realization_gate( g, annotations, realos ); }
+    if ( qcos.is_open() )   { write_qc_gate( g, qcos ); }
+    if ( gates )            { gates->add( g ); quantum_costs->add( g ); }
+  };
+
+  auto on_header = [&]( const circuit& header ) {
+    circuit meta;
+    copy_metadata( header, meta );
+
+    if ( opts.is_set( "nct" ) )
+    {
+      mapper.reset( new nct_mapping_stream( meta, fully_controlled, [&]( const gate& g ) { emit( g, no_annotations ); } ) );
+    }
+
+    if ( opts.is_write_realization_filename_set() )
+    {
+      realos.open( opts.write_realization_filename().c_str(), std::ofstream::out );
+      write_realization_header( meta, realos );
+    }
+    if ( !qcname.empty() )
+    {
+      qcos.open( qcname.c_str(), std::ofstream::out );
+      write_qc_header( meta.lines(), qcos );
+    }
+    if ( opts.is_set( "statistics" ) )
+    {
+      gates.reset( new costs_accumulator( meta.lines() ) );
+      quantum_costs.reset( new costs_accumulator( meta.lines(), ncv_quantum_costs() ) );
+    }
+  };
+
+  auto on_gate = [&]( const gate& g, const std::map<std::string, std::string>& annotations ) {
+    if ( mapper )
+    {
+      ( *mapper )( g );
+    }
+    else
+    {
+      emit( g, annotations );
+    }
+  };
+
+  double runtime;
+  {
+    reference_timer t( &runtime );
+    if ( !stream_realization( filename, on_header, on_gate, read_realization_settings(), &error ) )
+    {
+      std::cerr << "[e] " << error << std::endl;
+      return 1;
+    }
+  }
+
+  if ( realos.is_open() ) { write_realization_footer( realos ); }
+  if ( qcos.is_open() )   { write_qc_footer( qcos ); }
+
+  if ( gates )
+  {
+    std::cout << boost::format( "[i] gates:         %d" ) % gates->num_gates() << std::endl
+              << boost::format( "[i] depth:         %d" ) % gates->depth() << std::endl
+              << boost::format( "[i] quantum costs: %d" ) % quantum_costs->costs() << std::endl
+              << boost::format( "[i] runtime:       %.2f secs" ) % runtime << std::endl;
+  }
+
+  return 0;
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
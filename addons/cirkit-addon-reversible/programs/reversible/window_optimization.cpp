@@ -60,6 +60,7 @@ int main( int argc, char ** argv )
   auto settings = std::make_shared<properties>();
   auto statistics = std::make_shared<properties>();
   settings->set( "cost_function", opts.costs() );
+  settings->set( "memoize_costs", true ); /* all cost functions of the program only depend on the gate shape */
   window_optimization( opt, circ, settings, statistics );
 
   if ( opts.is_write_realization_filename_set() )
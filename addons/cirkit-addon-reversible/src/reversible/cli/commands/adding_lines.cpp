@@ -67,7 +67,7 @@ command::rules_t adding_lines_command::validity_rules() const
 
 bool adding_lines_command::execute()
 {
-  auto& circuits = env->store<circuit>();
+  const auto& circuits = env->store<circuit>();
 
   circuit opt;
   auto settings = make_settings();
@@ -82,9 +82,10 @@ bool adding_lines_command::execute()
   settings->set( "cost_function", cost_function( cfs[costs] ) );
   adding_lines( opt, circuits.current(), settings, statistics );
 
-  extend_if_new( circuits );
+  auto& store = env->store<circuit>();
+  extend_if_new( store );
 
-  circuits.current() = opt;
+  store.current() = opt;
 
   print_runtime();
 
@@ -112,9 +112,9 @@ command::rules_t dbs_command::validity_rules() const
 
 bool dbs_command::execute()
 {
-  auto& circuits = env->store<circuit>();
-  auto& rcbdds   = env->store<rcbdd>();
-  auto& specs    = env->store<binary_truth_table>();
+  auto& circuits     = env->store<circuit>();
+  const auto& rcbdds = env->store<rcbdd>();
+  const auto& specs  = env->store<binary_truth_table>();
 
   auto settings = make_settings();
   auto statistics = std::make_shared<properties>();
@@ -78,8 +78,8 @@ command::rules_t exs_command::validity_rules() const
 
 bool exs_command::execute()
 {
-  auto& circuits = env->store<circuit>();
-  auto& specs    = env->store<binary_truth_table>();
+  auto& circuits    = env->store<circuit>();
+  const auto& specs = env->store<binary_truth_table>();
 
   extend_if_new( circuits );
 
@@ -70,7 +70,9 @@ command::rules_t hdbs_command::valididity_rules() const
 
 bool hdbs_command::execute()
 {
-  auto& bdd = env->store<bdd_function_t>().current();
+  /* reordering only changes the shared manager, so a copy of the handles suffices */
+  const auto& bdds = env->store<bdd_function_t>();
+  auto bdd = bdds.current();
 
   circuit circ;
 
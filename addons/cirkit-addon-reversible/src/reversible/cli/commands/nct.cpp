@@ -27,6 +27,7 @@
 #include "nct.hpp"
 
 #include <alice/rules.hpp>
+#include <core/utils/program_options.hpp>
 #include <reversible/cli/stores.hpp>
 #include <reversible/mapping/nct_mapping.hpp>
 
@@ -48,6 +49,9 @@ namespace cirkit
 nct_command::nct_command( const environment::ptr& env )
   : cirkit_command( env, "NCT mapping" )
 {
+  opts.add_options()
+    ( "threads", value_with_default( &threads ), "number of threads (0: all cores)" )
+    ;
   add_new_option();
   be_verbose();
 }
@@ -59,22 +63,27 @@ command::rules_t nct_command::validity_rules() const
 
 bool nct_command::execute()
 {
-  auto& circuits = env->store<circuit>();
+  const auto& circuits = env->store<circuit>();
 
   auto settings = make_settings();
+  settings->set( "num_threads", threads );
   auto mapped = nct_mapping( circuits.current(), settings, statistics );
   print_runtime();
 
-  extend_if_new( circuits );
+  auto& store = env->store<circuit>();
+  extend_if_new( store );
 
-  circuits.current() = mapped;
+  store.current() = mapped;
 
   return true;
 }
 
 command::log_opt_t nct_command::log() const
 {
-  return log_opt_t({{"runtime", statistics->get<double>( "runtime" )}});
+  return log_opt_t({
+      {"runtime", statistics->get<double>( "runtime" )},
+      {"cache_entries", statistics->get<unsigned>( "cache_entries" )}
+    });
 }
 
 }
@@ -59,13 +59,14 @@ command::rules_t pos_command::validity_rules() const
 
 bool pos_command::execute()
 {
-  auto& circuits = env->store<circuit>();
+  const auto& circuits = env->store<circuit>();
 
   circuit circ_new;
   negative_controls_to_positive( circuits.current(), circ_new );
 
-  extend_if_new( circuits );
-  circuits.current() = circ_new;
+  auto& store = env->store<circuit>();
+  extend_if_new( store );
+  store.current() = circ_new;
 
   return true;
 }
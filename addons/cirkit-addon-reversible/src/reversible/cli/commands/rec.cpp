@@ -28,8 +28,11 @@
 
 #include <iostream>
 
+#include <boost/dynamic_bitset.hpp>
+
 #include <core/utils/program_options.hpp>
 #include <reversible/cli/stores.hpp>
+#include <reversible/verification/simulation_equivalence_check.hpp>
 #include <reversible/verification/xorsat_equivalence_check.hpp>
 
 namespace cirkit
@@ -54,6 +57,9 @@ rec_command::rec_command( const environment::ptr& env )
     ( "id1",            value_with_default( &id1 ), "ID of first circuit" )
     ( "id2",            value_with_default( &id2 ), "ID of second circuit" )
     ( "name_mapping,n",                             "map circuits by name instead by index" )
+    ( "method,m",       value_with_default( &method ), "method\n0: exhaustive simulation (XOR-SAT above max_lines)\n1: XOR-SAT" )
+    ( "max_lines",      value_with_default( &max_lines ), "maximum number of lines for exhaustive simulation" )
+    ( "threads",        value_with_default( &threads ), "number of threads for simulation (0: all cores)" )
     ;
   be_verbose();
 }
@@ -64,7 +70,17 @@ bool rec_command::execute()
 
   auto settings = make_settings();
   settings->set( "name_mapping", is_set( "name_mapping" ) );
-  result = xorsat_equivalence_check( circuits[id1], circuits[id2], settings, statistics );
+  settings->set( "max_lines", max_lines );
+  settings->set( "num_threads", threads );
+
+  if ( method == 0u )
+  {
+    result = simulation_equivalence_check( circuits[id1], circuits[id2], settings, statistics );
+  }
+  else
+  {
+    result = xorsat_equivalence_check( circuits[id1], circuits[id2], settings, statistics );
+  }
 
   print_runtime();
 
@@ -75,6 +91,11 @@ bool rec_command::execute()
   else
   {
     std::cout << "[i] circuits are \033[1;31mnot equivalent\033[0m" << std::endl;
+
+    if ( statistics->has_key( "counterexample" ) )
+    {
+      std::cout << "[i] counterexample: " << statistics->get<boost::dynamic_bitset<>>( "counterexample" ) << std::endl;
+    }
   }
 
   return true;
@@ -55,6 +55,9 @@ public:
 private:
   unsigned id1 = 0u;
   unsigned id2 = 1u;
+  unsigned method = 0u;
+  unsigned max_lines = 28u;
+  unsigned threads = 0u;
   bool result;
 };
 
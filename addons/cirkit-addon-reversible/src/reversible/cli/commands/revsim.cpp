@@ -31,8 +31,8 @@
 
 #include <alice/rules.hpp>
 #include <reversible/cli/stores.hpp>
+#include <reversible/simulation/bitsliced_simulation.hpp>
 #include <reversible/simulation/partial_simulation.hpp>
-#include <reversible/simulation/simple_simulation.hpp>
 
 using namespace boost::program_options;
 
@@ -66,9 +66,10 @@ command::rules_t revsim_command::validity_rules() const
         }
         return true;
       }, "pattern must consists of 0s and 1s" },
-    {[this]() { return pattern == "0*" ||
+    {[this]() { const auto& circuits = env->store<circuit>();
+                return pattern == "0*" ||
                        pattern == "1*" ||
-                       ( is_set( "partial" ) || env->store<circuit>().current().lines() == pattern.size() ); }, "pattern bits must equal number of lines" }
+                       ( is_set( "partial" ) || circuits.current().lines() == pattern.size() ); }, "pattern bits must equal number of lines" }
   };
 }
 
@@ -91,7 +92,7 @@ bool revsim_command::execute()
   }
   else
   {
-    simple_simulation( output, circuits.current(), input );
+    bitsliced_simulation( output, circuits.current(), input );
   }
 
   std::cout << "[i] result: " << output << std::endl;
@@ -26,6 +26,10 @@
 
 #include "revsimp.hpp"
 
+#include <iostream>
+
+#include <boost/format.hpp>
+
 #include <alice/rules.hpp>
 #include <core/utils/program_options.hpp>
 #include <reversible/circuit.hpp>
@@ -51,7 +55,7 @@ revsimp_command::revsimp_command( const environment::ptr& env )
   : cirkit_command( env, "Reversible circuit simplification" )
 {
   opts.add_options()
-    ( "methods",   value_with_default( &methods ), "optimization methods:\nm: try to merge gates with same target\nn: cancel NOT gates\na: merge adjacent gates\ne: resynthesize same-target gates with exorcism\ns: propagate SWAP gates (may change output order)" )
+    ( "methods",   value_with_default( &methods ), "optimization methods:\nm: try to merge gates with same target\nn: cancel NOT gates\na: merge adjacent gates\ne: resynthesize same-target gates with exorcism\ns: propagate SWAP gates (may change output order)\np: cancel and merge commuting gates with same target using templates (linear time)" )
     ( "noreverse",                                 "do not optimize in reverse direction" )
     ;
   be_verbose();
@@ -65,7 +69,7 @@ command::rules_t revsimp_command::validity_rules() const
 
 bool revsimp_command::execute()
 {
-  auto& circuits = env->store<circuit>();
+  const auto& circuits = env->store<circuit>();
 
   auto settings = make_settings();
   settings->set( "methods",     methods );
@@ -73,8 +77,17 @@ bool revsimp_command::execute()
   circuit circ;
   simplify( circ, circuits.current(), settings, statistics );
 
-  extend_if_new( circuits );
-  circuits.current() = circ;
+  if ( statistics->has_key( "peephole_cancellations" ) )
+  {
+    std::cout << boost::format( "[i] peephole templates: %d cancellations, %d polarity merges, %d control merges" )
+                 % statistics->get<unsigned>( "peephole_cancellations" )
+                 % statistics->get<unsigned>( "peephole_polarity_merges" )
+                 % statistics->get<unsigned>( "peephole_control_merges" ) << std::endl;
+  }
+
+  auto& store = env->store<circuit>();
+  extend_if_new( store );
+  store.current() = circ;
 
   print_runtime();
 
@@ -97,9 +97,9 @@ command::rules_t tbs_command::validity_rules() const
 
 bool tbs_command::execute()
 {
-  auto& circuits = env->store<circuit>();
-  auto& rcbdds   = env->store<rcbdd>();
-  auto& specs    = env->store<binary_truth_table>();
+  const auto& circuits = env->store<circuit>();
+  const auto& rcbdds   = env->store<rcbdd>();
+  const auto& specs    = env->store<binary_truth_table>();
 
   auto settings = make_settings();
 
@@ -137,9 +137,10 @@ bool tbs_command::execute()
     transformation_based_synthesis( circ, specs.current(), settings, statistics );
   }
 
-  extend_if_new( circuits );
+  auto& store = env->store<circuit>();
+  extend_if_new( store );
 
-  circuits.current() = circ;
+  store.current() = circ;
 
   print_runtime();
   if ( is_set( "sat" ) )
@@ -54,7 +54,8 @@ command::rules_t unique_names_command::validity_rules() const
 
 bool unique_names_command::execute()
 {
-  auto& circ = env->store<circuit>().current();
+  const auto& circuits = env->store<circuit>();
+  const auto& circ = circuits.current();
 
   std::vector<std::string> inputs, outputs;
 
@@ -80,8 +81,13 @@ bool unique_names_command::execute()
     }
   }
 
-  circ.set_inputs( inputs );
-  circ.set_outputs( outputs );
+  /* only write if the names change, a shared entry is then copied */
+  if ( circ.inputs() != inputs || circ.outputs() != outputs )
+  {
+    auto& named = env->store<circuit>().current_mutable();
+    named.set_inputs( inputs );
+    named.set_outputs( outputs );
+  }
 
   return true;
 }
@@ -0,0 +1,171 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "compact_circuit.hpp"
+
+#include <cassert>
+
+#include <reversible/target_tags.hpp>
+
+namespace cirkit
+{
+
+  compact_circuit::compact_circuit( unsigned lines )
+    : _lines( lines )
+  {
+  }
+
+  compact_circuit::compact_circuit( const circuit& circ )
+    : _lines( circ.lines() )
+  {
+    _gates.reserve( circ.num_gates() );
+
+    for ( const auto& g : circ )
+    {
+      append_gate( g );
+    }
+  }
+
+  void compact_circuit::reserve( unsigned num_gates )
+  {
+    _gates.reserve( num_gates );
+  }
+
+  void compact_circuit::append_toffoli( std::uint64_t controls, std::uint64_t polarities, unsigned target )
+  {
+    assert( target < compact_gate::max_lines );
+    _gates.push_back( compact_gate{controls, polarities & controls, target, target, compact_gate::gate_type::toffoli} );
+  }
+
+  void compact_circuit::append_fredkin( std::uint64_t controls, std::uint64_t polarities, unsigned target1, unsigned target2 )
+  {
+    assert( target1 < compact_gate::max_lines && target2 < compact_gate::max_lines );
+    _gates.push_back( compact_gate{controls, polarities & controls, target1, target2, compact_gate::gate_type::fredkin} );
+  }
+
+  void compact_circuit::append_peres( std::uint64_t controls, std::uint64_t polarities, unsigned target1, unsigned target2 )
+  {
+    assert( target1 < compact_gate::max_lines && target2 < compact_gate::max_lines );
+    _gates.push_back( compact_gate{controls, polarities & controls, target1, target2, compact_gate::gate_type::peres} );
+  }
+
+  void compact_circuit::append_gate( const gate& g )
+  {
+    auto fits = true;
+
+    std::uint64_t controls = 0u, polarities = 0u;
+    for ( const auto& v : g.controls() )
+    {
+      if ( v.line() >= compact_gate::max_lines ) { fits = false; break; }
+
+      controls |= 1ull << v.line();
+      if ( v.polarity() )
+      {
+        polarities |= 1ull << v.line();
+      }
+    }
+
+    for ( const auto& t : g.targets() )
+    {
+      if ( t >= compact_gate::max_lines ) { fits = false; }
+    }
+
+    if ( fits && is_toffoli( g ) && g.targets().size() == 1u )
+    {
+      append_toffoli( controls, polarities, g.targets().front() );
+    }
+    else if ( fits && is_fredkin( g ) && g.targets().size() == 2u )
+    {
+      append_fredkin( controls, polarities, g.targets()[0u], g.targets()[1u] );
+    }
+    else if ( fits && is_peres( g ) && g.targets().size() == 2u )
+    {
+      append_peres( controls, polarities, g.targets()[0u], g.targets()[1u] );
+    }
+    else
+    {
+      _gates.push_back( compact_gate{0u, 0u, static_cast<std::uint32_t>( _overflow.size() ), 0u, compact_gate::gate_type::overflow} );
+      _overflow.push_back( g );
+    }
+  }
+
+  gate compact_circuit::to_gate( const compact_gate& g ) const
+  {
+    if ( g.is_overflow() )
+    {
+      return overflow_gate( g );
+    }
+
+    gate result;
+
+    for ( auto c = g.controls; c; c &= c - 1u )
+    {
+      const unsigned line = __builtin_ctzll( c );
+      result.add_control( make_var( line, ( g.polarities >> line ) & 1u ) );
+    }
+
+    result.add_target( g.target1 );
+
+    switch ( g.type )
+    {
+    case compact_gate::gate_type::toffoli:
+      result.set_type( toffoli_tag() );
+      break;
+    case compact_gate::gate_type::fredkin:
+      result.add_target( g.target2 );
+      result.set_type( fredkin_tag() );
+      break;
+    case compact_gate::gate_type::peres:
+      result.add_target( g.target2 );
+      result.set_type( peres_tag() );
+      break;
+    default:
+      assert( false );
+    }
+
+    return result;
+  }
+
+  void compact_circuit::to_circuit( circuit& circ ) const
+  {
+    if ( circ.lines() < _lines )
+    {
+      circ.set_lines( _lines );
+    }
+
+    for ( const auto& g : _gates )
+    {
+      circ.append_gate() = to_gate( g );
+    }
+  }
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,192 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file compact_circuit.hpp
+ *
+ * @brief Flat gate storage for large reversible circuits
+ *
+ * @author agent
+ * @since  2.3
+ */
+
+#ifndef COMPACT_CIRCUIT_HPP
+#define COMPACT_CIRCUIT_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <reversible/circuit.hpp>
+#include <reversible/gate.hpp>
+
+namespace cirkit
+{
+
+  /**
+   * @brief Fixed-size gate record
+   *
+   * Lines are stored as bitmasks, which restricts this representation to
+   * circuits with at most 64 lines.  Gates that do not fit (more lines, more
+   * than two targets, or modules) are kept as ordinary gate objects in an
+   * overflow vector and the record only stores their index.
+   *
+   * @since  2.3
+   */
+  struct compact_gate
+  {
+    enum class gate_type : std::uint8_t { toffoli, fredkin, peres, overflow };
+
+    static const unsigned max_lines = 64u;
+
+    /** @brief bit i is set, if line i is a control */
+    std::uint64_t controls;
+
+    /** @brief bit i is set, if line i is a positive control */
+    std::uint64_t polarities;
+
+    /** @brief targets in the order of gate::targets() (only first for Toffoli), or overflow index */
+    std::uint32_t target1;
+    std::uint32_t target2;
+
+    gate_type     type;
+
+    inline std::uint64_t target_mask() const
+    {
+      return type == gate_type::toffoli ? ( 1ull << target1 ) : ( ( 1ull << target1 ) | ( 1ull << target2 ) );
+    }
+
+    inline bool is_overflow() const { return type == gate_type::overflow; }
+    inline unsigned overflow_index() const { return target1; }
+  };
+
+  /**
+   * @brief Circuit with contiguous gate storage
+   *
+   * Offers the read-only part of the circuit interface (lines(),
+   * num_gates(), begin(), end(), and element access), so that algorithms
+   * written against iterators can be used with both classes.  The circuit's
+   * metadata (inputs, outputs, constants, ...) is not stored, use
+   * copy_metadata when converting back.
+   *
+   * @section example_compact_circuit Example: Count the controls of all Toffoli gates
+   * @code
+   * compact_circuit ccirc( circ );
+   * unsigned count = 0u;
+   * for ( const auto& g : ccirc )
+   * {
+   *   if ( g.type == compact_gate::gate_type::toffoli ) count += __builtin_popcountll( g.controls );
+   * }
+   * @endcode
+   *
+   * @since  2.3
+   */
+  class compact_circuit
+  {
+  public:
+    using const_iterator = std::vector<compact_gate>::const_iterator;
+
+    /**
+     * @brief Creates an empty circuit with \p lines lines
+     *
+     * @since  2.3
+     */
+    explicit compact_circuit( unsigned lines = 0u );
+
+    /**
+     * @brief Converts a circuit
+     *
+     * @since  2.3
+     */
+    explicit compact_circuit( const circuit& circ );
+
+    inline unsigned lines() const     { return _lines; }
+    inline unsigned num_gates() const { return _gates.size(); }
+
+    inline const_iterator begin() const { return _gates.begin(); }
+    inline const_iterator end() const   { return _gates.end(); }
+
+    inline const compact_gate& operator[]( unsigned index ) const { return _gates[index]; }
+
+    /**
+     * @brief Returns the original gate of an overflow record
+     *
+     * @since  2.3
+     */
+    inline const gate& overflow_gate( const compact_gate& g ) const { return _overflow[g.overflow_index()]; }
+
+    /**
+     * @brief Returns true, if no gate needed the overflow path
+     *
+     * @since  2.3
+     */
+    inline bool is_compact() const { return _overflow.empty(); }
+
+    void reserve( unsigned num_gates );
+
+    void append_toffoli( std::uint64_t controls, std::uint64_t polarities, unsigned target );
+    void append_fredkin( std::uint64_t controls, std::uint64_t polarities, unsigned target1, unsigned target2 );
+    void append_peres( std::uint64_t controls, std::uint64_t polarities, unsigned target1, unsigned target2 );
+
+    /**
+     * @brief Appends a gate, chooses the overflow path if required
+     *
+     * @since  2.3
+     */
+    void append_gate( const gate& g );
+
+    /**
+     * @brief Converts a gate record back into a gate object
+     *
+     * Controls of the returned gate are ordered by line.
+     *
+     * @since  2.3
+     */
+    gate to_gate( const compact_gate& g ) const;
+
+    /**
+     * @brief Appends all gates to \p circ
+     *
+     * Lines of \p circ are adjusted, if it has fewer lines.
+     *
+     * @since  2.3
+     */
+    void to_circuit( circuit& circ ) const;
+
+  private:
+    unsigned                  _lines;
+    std::vector<compact_gate> _gates;
+    std::vector<gate>         _overflow;
+  };
+
+}
+
+#endif /* COMPACT_CIRCUIT_HPP */
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -183,6 +183,21 @@ namespace cirkit
     gate* g;
   };
 
+  /**
+   * @brief Helper functions for initializing an existing gate
+   *
+   * These are used by the append_ and prepend_ functions and can
+   * be used for gates that are not part of a circuit.
+   *
+   * @return Gate reference \p g
+   *
+   * @since  2.3
+   */
+  gate& create_toffoli( gate& g, const gate::control_container& controls, unsigned target );
+  gate& create_toffoli( gate& g, const std::vector<unsigned>& controls, unsigned target );
+  gate& create_fredkin( gate& g, const gate::control_container& controls, unsigned target1, unsigned target2 );
+  gate& create_peres( gate& g, variable control, unsigned target1, unsigned target2 );
+
   /**
    * @brief Helper function for appending a \b Toffoli gate
    *
@@ -31,6 +31,9 @@
 #include <core/properties.hpp>
 #include <core/utils/bitset_utils.hpp>
 
+#include <reversible/compact_circuit.hpp>
+#include <reversible/simulation/bitsliced_simulation.hpp>
+
 namespace cirkit
 {
 
@@ -77,6 +80,45 @@ namespace cirkit
     return true;
   }
 
+  bool circuit_to_truth_table( const circuit& circ, binary_truth_table& spec )
+  {
+    const auto n = circ.lines();
+    assert( n < 64u );
+
+    const compact_circuit ccirc( circ );
+
+    const auto num_patterns = 1ull << n;
+    const auto num_words    = static_cast<unsigned>( std::min<std::uint64_t>( std::max<std::uint64_t>( num_patterns >> 6u, 1u ), 1024u ) );
+
+    binary_truth_table::cube_type in_cube( n ), out_cube( n );
+
+    for ( std::uint64_t first = 0u; first < num_patterns; first += num_words << 6u )
+    {
+      bitsliced_patterns patterns( n, num_words );
+      patterns.set_counting( first );
+      bitsliced_simulation( patterns, ccirc );
+
+      const auto count = std::min<std::uint64_t>( num_patterns - first, patterns.num_patterns() );
+      for ( auto j = 0u; j < count; ++j )
+      {
+        for ( auto l = 0u; l < n; ++l )
+        {
+          in_cube[l]  = ( ( first + j ) >> l ) & 1u;
+          out_cube[l] = ( patterns.line( l )[j >> 6u] >> ( j & 63u ) ) & 1u;
+        }
+        spec.add_entry( in_cube, out_cube );
+      }
+    }
+
+    // metadata
+    spec.set_inputs( circ.inputs() );
+    spec.set_outputs( circ.outputs() );
+    spec.set_constants( circ.constants() );
+    spec.set_garbage( circ.garbage() );
+
+    return true;
+  }
+
 }
 
 // Local Variables:
@@ -62,6 +62,21 @@ namespace cirkit
    */
   bool circuit_to_truth_table( const circuit& circ, binary_truth_table& spec, const functor<bool(boost::dynamic_bitset<>&, const circuit&, const boost::dynamic_bitset<>&)>& simulation );
 
+  /**
+   * @brief Generates a truth table from a circuit using bit-sliced simulation
+   *
+   * Same as the version above with simple_simulation_func(), but simulates
+   * 64 patterns per word operation.
+   *
+   * @param circ Circuit to be simulated
+   * @param spec Empty truth table to be constructed
+   *
+   * @return true on success, false otherwise
+   *
+   * @since  2.3
+   */
+  bool circuit_to_truth_table( const circuit& circ, binary_truth_table& spec );
+
 }
 
 #endif /* CIRCUIT_TO_TRUTH_TABLE_HPP */
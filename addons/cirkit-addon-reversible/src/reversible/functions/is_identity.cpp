@@ -29,13 +29,55 @@
 #include <boost/range/combine.hpp>
 #include <boost/range/numeric.hpp>
 
+#include <reversible/compact_circuit.hpp>
 #include <reversible/rcbdd.hpp>
+#include <reversible/simulation/bitsliced_simulation.hpp>
 
 namespace cirkit
 {
 
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+/* up to this number of lines, exhaustive simulation is faster than BDDs */
+static const unsigned is_identity_simulation_threshold = 24u;
+
+bool is_identity_by_simulation( const circuit& circ )
+{
+  const auto n = circ.lines();
+  const compact_circuit ccirc( circ );
+
+  const auto num_patterns = 1ull << n;
+  const auto num_words    = static_cast<unsigned>( std::min<std::uint64_t>( std::max<std::uint64_t>( num_patterns >> 6u, 1u ), 1024u ) );
+
+  for ( std::uint64_t first = 0u; first < num_patterns; first += num_words << 6u )
+  {
+    bitsliced_patterns patterns( n, num_words ), inputs( n, num_words );
+    inputs.set_counting( first );
+    patterns.set_counting( first );
+    bitsliced_simulation( patterns, ccirc );
+
+    if ( !( patterns == inputs ) )
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
 bool is_identity( const circuit& circ )
 {
+  if ( circ.lines() <= is_identity_simulation_threshold )
+  {
+    return is_identity_by_simulation( circ );
+  }
+
   rcbdd mgr;
   mgr.initialize_manager();
   mgr.create_variables( circ.lines() );
@@ -138,71 +138,70 @@ namespace cirkit
   }
 
   void circuit_processor::on_gate( const boost::any& target_type, const std::vector<variable>& line_indices ) const
+  {
+    gate& added_gate = d->circs.top()->append_gate();
+    added_gate = make_gate( target_type, line_indices, *d->circs.top() );
+
+    /* Annotations */
+    const properties& p = *( current_annotations().get() );
+    properties::storage_type::const_iterator it;
+    for ( it = p.begin(); it != p.end(); ++it )
+    {
+      d->circs.top()->annotate( added_gate, it->first, boost::any_cast<std::string>( it->second ) );
+    }
+  }
+
+  void circuit_processor::on_end() const
+  {
+    d->circs.pop();
+  }
+
+  gate make_gate( const boost::any& target_type, const std::vector<variable>& line_indices, const circuit& header )
   {
     assert( line_indices.back().polarity() ); /* target line must be positive */
+    gate g;
     gate::control_container controls;
-    gate* added_gate = 0;
 
     if ( is_type<toffoli_tag>( target_type ) )
     {
       assert( line_indices.size() > 0 );
       std::copy( line_indices.begin(), line_indices.end() - 1, std::back_inserter( controls ) );
-      added_gate = &append_toffoli( *d->circs.top(), controls, line_indices.back().line() );
+      create_toffoli( g, controls, line_indices.back().line() );
     }
     else if ( is_type<fredkin_tag>( target_type ) )
     {
       assert( line_indices.size() > 1 );
       std::copy( line_indices.begin(), line_indices.end() - 2, std::back_inserter( controls ) );
-      added_gate = &append_fredkin( *d->circs.top(), controls, ( line_indices.end() - 2 )->line(), ( line_indices.end() - 1 )->line() );
+      create_fredkin( g, controls, ( line_indices.end() - 2 )->line(), ( line_indices.end() - 1 )->line() );
     }
     else if ( is_type<peres_tag>( target_type ) )
     {
       assert( line_indices.size() == 3 );
-      added_gate = &append_peres( *d->circs.top(), line_indices.at( 0 ), line_indices.at( 1 ).line(), line_indices.at( 2 ).line() );
+      create_peres( g, line_indices.at( 0 ), line_indices.at( 1 ).line(), line_indices.at( 2 ).line() );
     }
     else if ( is_type<module_tag>( target_type ) )
     {
       module_tag module = boost::any_cast<module_tag>( target_type );
-      std::shared_ptr<circuit> module_circuit = d->circs.top()->modules().find( module.name )->second;
+      std::shared_ptr<circuit> module_circuit = header.modules().find( module.name )->second;
       assert( line_indices.size() >= module_circuit->lines() );
       module.reference = module_circuit;
 
-      /* new gate */
-      gate& module_gate = d->circs.top()->append_gate();
-
       /* control lines */
       unsigned num_controls = line_indices.size() - module_circuit->lines();
-      std::for_each( line_indices.begin(), line_indices.begin() + num_controls, [&module_gate]( variable l ) { module_gate.add_control( l ); } );
+      std::for_each( line_indices.begin(), line_indices.begin() + num_controls, [&g]( variable l ) { g.add_control( l ); } );
 
       /* sort order */
-      std::for_each( line_indices.begin() + num_controls, line_indices.end(), [&module_gate]( variable l ) { assert( l.polarity() ); module_gate.add_target( l.line() ); } );
-      module_gate.set_type( module );
-
-      added_gate = &module_gate;
+      std::for_each( line_indices.begin() + num_controls, line_indices.end(), [&g]( variable l ) { assert( l.polarity() ); g.add_target( l.line() ); } );
+      g.set_type( module );
     }
     else
     {
-      added_gate = &d->circs.top()->append_gate();
-      std::for_each( line_indices.begin(), line_indices.end() - 1, [added_gate]( variable l ) { added_gate->add_control( l ); } );
-      added_gate->add_target( line_indices.back().line() );
-      added_gate->set_type( target_type );
-    }
-
-    /* Annotations */
-    if ( added_gate )
-    {
-      const properties& p = *( current_annotations().get() );
-      properties::storage_type::const_iterator it;
-      for ( it = p.begin(); it != p.end(); ++it )
-      {
-        d->circs.top()->annotate( *added_gate, it->first, boost::any_cast<std::string>( it->second ) );
-      }
+      std::for_each( line_indices.begin(), line_indices.end() - 1, [&g]( variable l ) { g.add_control( l ); } );
+      g.add_target( line_indices.back().line() );
+      g.set_type( target_type );
     }
-  }
 
-  void circuit_processor::on_end() const
-  {
-    d->circs.pop();
+    return g;
   }
 
   bool read_realization( circuit& circ, std::istream& in, const read_realization_settings& settings, std::string* error )
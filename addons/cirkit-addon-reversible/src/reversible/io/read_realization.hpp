@@ -105,6 +105,17 @@ namespace cirkit
     priv* const d;
   };
 
+  /**
+   * @brief Creates a gate from its parsed target type and lines
+   *
+   * The last lines in \p line_indices are the targets, the others
+   * are controls.  Module gates are resolved in the modules of
+   * \p header.  Used by circuit_processor and stream_processor.
+   *
+   * @since  2.3
+   */
+  gate make_gate( const boost::any& target_type, const std::vector<variable>& line_indices, const circuit& header );
+
   /**
    * @since  2.0
    */
@@ -0,0 +1,155 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "stream_realization.hpp"
+
+#include <fstream>
+
+#include <boost/filesystem/path.hpp>
+
+#include <reversible/io/revlib_parser.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+bool stream_realization( std::istream& in, const realization_header_func& on_header, const realization_gate_func& on_gate,
+                         const read_realization_settings& settings, const std::string& base_directory, std::string* error )
+{
+  circuit header;
+  stream_processor processor( header, on_header, on_gate );
+
+  revlib_parser_settings rp_settings;
+  rp_settings.base_directory = base_directory;
+  rp_settings.read_gates = settings.read_gates;
+  rp_settings.string_to_target_tag = settings.string_to_target_tag;
+
+  return revlib_parser( in, processor, rp_settings, error );
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+stream_processor::stream_processor( circuit& header, const realization_header_func& on_header, const realization_gate_func& on_gate )
+  : circuit_processor( header ),
+    header( header ),
+    header_callback( on_header ),
+    gate_callback( on_gate )
+{
+}
+
+void stream_processor::on_module( const std::string& name, const boost::optional<std::string>& filename ) const
+{
+  /* inline modules are constructed until their .end */
+  if ( !filename )
+  {
+    ++module_depth;
+  }
+
+  circuit_processor::on_module( name, filename );
+}
+
+void stream_processor::on_begin() const
+{
+  if ( module_depth == 0u && header_callback )
+  {
+    header_callback( header );
+  }
+}
+
+void stream_processor::on_gate( const boost::any& target_type, const std::vector<variable>& line_indices ) const
+{
+  if ( module_depth > 0u )
+  {
+    circuit_processor::on_gate( target_type, line_indices );
+    return;
+  }
+
+  const auto g = make_gate( target_type, line_indices, header );
+
+  if ( !gate_callback )
+  {
+    return;
+  }
+
+  /* annotations */
+  std::map<std::string, std::string> annotations;
+  for ( const auto& p : *current_annotations() )
+  {
+    annotations[p.first] = boost::any_cast<std::string>( p.second );
+  }
+
+  gate_callback( g, annotations );
+}
+
+void stream_processor::on_end() const
+{
+  if ( module_depth > 0u )
+  {
+    --module_depth;
+  }
+
+  circuit_processor::on_end();
+}
+
+bool stream_realization( std::istream& in, const realization_header_func& on_header, const realization_gate_func& on_gate,
+                         const read_realization_settings& settings, std::string* error )
+{
+  return stream_realization( in, on_header, on_gate, settings, std::string(), error );
+}
+
+bool stream_realization( const std::string& filename, const realization_header_func& on_header, const realization_gate_func& on_gate,
+                         const read_realization_settings& settings, std::string* error )
+{
+  std::ifstream is( filename.c_str(), std::ifstream::in );
+
+  if ( !is.good() )
+  {
+    if ( error )
+    {
+      *error = "Cannot open " + filename;
+    }
+    return false;
+  }
+
+  return stream_realization( is, on_header, on_gate, settings, boost::filesystem::path( filename ).parent_path().string(), error );
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
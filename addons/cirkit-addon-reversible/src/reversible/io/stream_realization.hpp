@@ -0,0 +1,125 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file stream_realization.hpp
+ *
+ * @brief Streaming parser for RevLib realization (*.real) files
+ *
+ * Instead of constructing the whole circuit, the gates are passed
+ * one by one to a callback.  Together with write_realization_gate,
+ * write_qc_gate, costs_accumulator, and nct_mapping_stream this
+ * allows to convert and evaluate circuits in constant memory.
+ *
+ * @author agent
+ * @since  2.3
+ */
+
+#ifndef STREAM_REALIZATION_HPP
+#define STREAM_REALIZATION_HPP
+
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <string>
+
+#include <reversible/circuit.hpp>
+#include <reversible/io/read_realization.hpp>
+
+namespace cirkit
+{
+
+/**
+ * @brief Called once when the top-level .begin is parsed
+ *
+ * The circuit contains all meta data (lines, inputs, outputs,
+ * constants, garbage, buses, and modules) but no gates.
+ */
+using realization_header_func = std::function<void( const circuit& header )>;
+
+/**
+ * @brief Called for each top-level gate together with its annotations
+ */
+using realization_gate_func = std::function<void( const gate& g, const std::map<std::string, std::string>& annotations )>;
+
+/**
+ * @brief Implementation of revlib_processor to stream a circuit
+ *
+ * Meta data and modules are collected in \p header as in
+ * circuit_processor, but the gates of the top-level circuit are
+ * passed to \p on_gate and are not stored.  The gate object is only
+ * valid during the call.
+ */
+class stream_processor : public circuit_processor
+{
+public:
+  stream_processor( circuit& header, const realization_header_func& on_header, const realization_gate_func& on_gate );
+
+protected:
+  virtual void on_module( const std::string& name, const boost::optional<std::string>& filename ) const;
+  virtual void on_begin() const;
+  virtual void on_gate( const boost::any& target_type, const std::vector<variable>& line_indices ) const;
+  virtual void on_end() const;
+
+private:
+  circuit&                header;
+  realization_header_func header_callback;
+  realization_gate_func   gate_callback;
+
+  /* number of inline modules that are currently parsed */
+  mutable unsigned        module_depth = 0u;
+};
+
+/**
+ * @brief Streams a circuit realization from a stream
+ *
+ * @param in        input stream containing the realization
+ * @param on_header called with the meta data before the first gate
+ * @param on_gate   called for each gate
+ * @param settings  reader settings, read_gates = false stops after the header
+ * @param error     if not null, an error message is stored in case parsing fails
+ * @return true on success, false otherwise
+ */
+bool stream_realization( std::istream& in, const realization_header_func& on_header, const realization_gate_func& on_gate,
+                         const read_realization_settings& settings = read_realization_settings(), std::string* error = 0 );
+
+/**
+ * @brief Streams a circuit realization from a file
+ *
+ * Module files are resolved relative to the directory of \p filename.
+ */
+bool stream_realization( const std::string& filename, const realization_header_func& on_header, const realization_gate_func& on_gate,
+                         const read_realization_settings& settings = read_realization_settings(), std::string* error = 0 );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
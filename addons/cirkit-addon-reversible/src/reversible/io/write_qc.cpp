@@ -46,28 +46,14 @@ namespace cirkit
 
 void write_qc( const circuit& circ, std::ostream& os )
 {
-  const auto vars = create_name_list( "v%d", circ.lines() );
-
-  os << ".v " << boost::join( vars, " " ) << std::endl
-     << "BEGIN" << std::endl;
+  write_qc_header( circ.lines(), os );
 
   for ( const auto& gate : circ )
   {
-    assert( is_toffoli( gate ) );
-
-    os << "t" << ( gate.controls().size() + 1 );
-    for ( const auto& c : gate.controls() )
-    {
-      os << " " << vars[c.line()];
-      if ( !c.polarity() )
-      {
-        os << "'";
-      }
-    }
-    os << " " << vars[gate.targets().front()] << std::endl;
+    write_qc_gate( gate, os );
   }
 
-  os << "END" << std::endl;
+  write_qc_footer( os );
 }
 
 /******************************************************************************
@@ -81,6 +67,33 @@ void write_qc( const circuit& circ, const std::string& filename )
   os.close();
 }
 
+void write_qc_header( unsigned lines, std::ostream& os )
+{
+  os << ".v " << boost::join( create_name_list( "v%d", lines ), " " ) << std::endl
+     << "BEGIN" << std::endl;
+}
+
+void write_qc_gate( const gate& g, std::ostream& os )
+{
+  assert( is_toffoli( g ) );
+
+  os << "t" << ( g.controls().size() + 1 );
+  for ( const auto& c : g.controls() )
+  {
+    os << " v" << c.line();
+    if ( !c.polarity() )
+    {
+      os << "'";
+    }
+  }
+  os << " v" << g.targets().front() << std::endl;
+}
+
+void write_qc_footer( std::ostream& os )
+{
+  os << "END" << std::endl;
+}
+
 }
 
 // Local Variables:
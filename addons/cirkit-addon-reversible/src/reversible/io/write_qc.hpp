@@ -36,6 +36,7 @@
 #ifndef WRITE_QC_HPP
 #define WRITE_QC_HPP
 
+#include <iosfwd>
 #include <string>
 
 #include <reversible/circuit.hpp>
@@ -45,6 +46,11 @@ namespace cirkit
 
 void write_qc( const circuit& circ, const std::string& filename );
 
+/* gate-wise writing, e.g., for streamed circuits */
+void write_qc_header( unsigned lines, std::ostream& os );
+void write_qc_gate( const gate& g, std::ostream& os );
+void write_qc_footer( std::ostream& os );
+
 }
 
 #endif
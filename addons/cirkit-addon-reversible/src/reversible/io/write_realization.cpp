@@ -103,7 +103,7 @@ namespace cirkit
     }
   }
 
-  void write_realization( const circuit& circ, std::ostream& os, const write_realization_settings& settings )
+  void write_realization_header( const circuit& circ, std::ostream& os, const write_realization_settings& settings )
   {
     unsigned oldsize = 0;
 
@@ -215,36 +215,48 @@ namespace cirkit
     }
 
     os << ".begin" << std::endl;
+  }
+
+  void write_realization_gate( const gate& g, const std::map<std::string, std::string>& annotations, std::ostream& os, const write_realization_settings& settings )
+  {
+    std::vector<std::string> lines;
 
-    std::string cmd;
+    // Peres is special
+    boost::transform( g.controls(), std::back_inserter( lines ), line_to_variable() );
+    boost::transform( g.targets(), std::back_inserter( lines ), line_to_variable() );
 
-    for ( const auto& g : circ )
+    os << settings.type_label( g ) << " " << boost::algorithm::join( lines, " " );
+
+    if ( !annotations.empty() )
     {
-      cmd = settings.type_label( g );
+      std::string sannotations;
+      for ( const auto& p : annotations )
+      {
+        sannotations += boost::str( boost::format( " %s=\"%s\"" ) % p.first % p.second );
+      }
+      os << " #@" << sannotations;
+    }
 
-      std::vector<std::string> lines;
+    os << std::endl;
+  }
 
-      // Peres is special
-      boost::transform( g.controls(), std::back_inserter( lines ), line_to_variable() );
-      boost::transform( g.targets(), std::back_inserter( lines ), line_to_variable() );
+  void write_realization_footer( std::ostream& os )
+  {
+    os << ".end" << std::endl;
+  }
 
-      os << cmd << " " << boost::algorithm::join( lines, " " );
+  void write_realization( const circuit& circ, std::ostream& os, const write_realization_settings& settings )
+  {
+    write_realization_header( circ, os, settings );
 
+    const std::map<std::string, std::string> no_annotations;
+    for ( const auto& g : circ )
+    {
       boost::optional<const std::map<std::string, std::string>&> annotations = circ.annotations( g );
-      if ( annotations )
-      {
-        std::string sannotations;
-        for ( const auto& p : *annotations )
-        {
-          sannotations += boost::str( boost::format( " %s=\"%s\"" ) % p.first % p.second );
-        }
-        os << " #@" << sannotations;
-      }
-
-      os << std::endl;
+      write_realization_gate( g, annotations ? *annotations : no_annotations, os, settings );
     }
 
-    os << ".end" << std::endl;
+    write_realization_footer( os );
   }
 
   bool write_realization( const circuit& circ, const std::string& filename, const write_realization_settings& settings, std::string* error )
@@ -37,6 +37,7 @@
 #define WRITE_REALIZATION_HPP
 
 #include <iosfwd>
+#include <map>
 #include <string>
 
 #include <reversible/circuit.hpp>
@@ -171,6 +172,44 @@ namespace cirkit
    */
   bool write_realization( const circuit& circ, const std::string& filename, const write_realization_settings& settings = write_realization_settings(), std::string* error = 0 );
 
+  /**
+   * @brief Writes the header of a RevLib realization
+   *
+   * Writes everything up to and including the \b .begin command,
+   * i.e. the meta data and the modules of \p circ, but not its
+   * gates.  Together with write_realization_gate and
+   * write_realization_footer this allows to write a realization
+   * gate by gate without keeping the whole circuit in memory.
+   *
+   * @param circ     Circuit whose meta data is written, gates are ignored
+   * @param os       Output stream
+   * @param settings Settings (see write_realization_settings)
+   *
+   * @since  2.3
+   */
+  void write_realization_header( const circuit& circ, std::ostream& os, const write_realization_settings& settings = write_realization_settings() );
+
+  /**
+   * @brief Writes a single gate of a RevLib realization
+   *
+   * @param g           Gate to write
+   * @param annotations Annotations of the gate, may be empty
+   * @param os          Output stream
+   * @param settings    Settings (see write_realization_settings)
+   *
+   * @since  2.3
+   */
+  void write_realization_gate( const gate& g, const std::map<std::string, std::string>& annotations, std::ostream& os, const write_realization_settings& settings = write_realization_settings() );
+
+  /**
+   * @brief Writes the \b .end command of a RevLib realization
+   *
+   * @param os Output stream
+   *
+   * @since  2.3
+   */
+  void write_realization_footer( std::ostream& os );
+
 }
 
 #endif /* WRITE_REALIZATION_HPP */
@@ -26,11 +26,18 @@
 
 #include "nct_mapping.hpp"
 
+#include <future>
+#include <limits>
+#include <thread>
+
+#include <boost/functional/hash.hpp>
+
+#include <core/utils/thread_pool.hpp>
 #include <core/utils/timer.hpp>
 #include <reversible/target_tags.hpp>
 #include <reversible/functions/add_gates.hpp>
 #include <reversible/functions/add_line_to_circuit.hpp>
-#include <reversible/functions/copy_circuit.hpp>
+#include <reversible/functions/copy_metadata.hpp>
 #include <reversible/functions/find_lines.hpp>
 #include <reversible/utils/circuit_utils.hpp>
 
@@ -45,6 +52,36 @@ namespace cirkit
  * Private functions                                                          *
  ******************************************************************************/
 
+/* below this number of gates the destination is filled sequentially */
+constexpr unsigned parallel_threshold = 1u << 14u;
+
+/* maps all gates of circ, which must have enough lines */
+void map_gates_inplace( circuit& circ )
+{
+  const auto n = circ.lines();
+  auto pos = 0u;
+
+  while ( pos < circ.num_gates() )
+  {
+    const auto& g = circ[pos];
+    const auto c = g.controls().size();
+
+    if ( c <= 2u )
+    {
+      ++pos;
+    }
+    else if ( n + 1u >= ( c << 1u ) )
+    {
+      map_barenco72_inplace( circ, pos );
+      pos += ( c - 2u ) << 2u;
+    }
+    else
+    {
+      map_barenco73_inplace( circ, pos );
+    }
+  }
+}
+
 /******************************************************************************
  * Public functions                                                           *
  ******************************************************************************/
@@ -142,53 +179,225 @@ void map_barenco73_inplace( circuit& circ, unsigned pos )
   circ.remove_gate_at( pos );
 }
 
+nct_decomposition_cache::nct_decomposition_cache( unsigned lines )
+  : lines( lines )
+{
+}
+
+std::size_t nct_decomposition_cache::key_hash::operator()( const std::vector<unsigned>& key ) const
+{
+  return boost::hash_range( key.begin(), key.end() );
+}
+
+unsigned nct_decomposition_cache::lookup( const gate& g )
+{
+  assert( is_toffoli( g ) && g.controls().size() > 2u );
+
+  key.clear();
+  key.push_back( g.targets().front() );
+  for ( const auto& c : g.controls() )
+  {
+    key.push_back( c.line() );
+  }
+
+  const auto it = index.find( key );
+  if ( it != index.end() )
+  {
+    return it->second;
+  }
+
+  /* decompose the gate with negative controls: the decompositions copy
+     control literals of the gate, but also use its control lines as
+     positive helper lines in sub-gates, which must be distinguished */
+  circuit circ( lines );
+  gate::control_container controls;
+  for ( auto i = 1u; i < key.size(); ++i )
+  {
+    controls.push_back( make_var( key[i], false ) );
+  }
+  create_toffoli( circ.append_gate(), controls, key.front() );
+  map_gates_inplace( circ );
+
+  std::vector<int> control_index( lines, -1 );
+  for ( auto i = 1u; i < key.size(); ++i )
+  {
+    control_index[key[i]] = i - 1;
+  }
+
+  decomposition d;
+  d.offsets.push_back( 0u );
+  for ( const auto& mapped : circ )
+  {
+    for ( const auto& c : mapped.controls() )
+    {
+      d.literals.push_back( {c.line(), c.polarity() ? -1 : control_index[c.line()], c.polarity()} );
+    }
+    d.literals.push_back( {mapped.targets().front(), -1, true} );
+    d.offsets.push_back( d.literals.size() );
+  }
+
+  decompositions.push_back( d );
+  index.insert( {key, decompositions.size() - 1u} );
+  return decompositions.size() - 1u;
+}
+
+unsigned nct_decomposition_cache::num_gates( unsigned index ) const
+{
+  return decompositions[index].offsets.size() - 1u;
+}
+
+unsigned nct_decomposition_cache::num_entries() const
+{
+  return decompositions.size();
+}
+
+void nct_decomposition_cache::instantiate( unsigned index, const gate& g, unsigned k, gate& out ) const
+{
+  const auto& d = decompositions[index];
+  const auto last = d.offsets[k + 1u] - 1u;
+
+  for ( auto i = d.offsets[k]; i < last; ++i )
+  {
+    const auto& l = d.literals[i];
+    if ( l.control >= 0 )
+    {
+      out.add_control( g.controls()[l.control] );
+    }
+    else
+    {
+      out.add_control( make_var( l.line, l.polarity ) );
+    }
+  }
+  out.add_target( d.literals[last].line );
+  out.set_type( toffoli_tag() );
+}
+
 void nct_mapping_inplace( circuit& circ, const properties::ptr& settings, const properties::ptr& statistics )
+{
+  circ = nct_mapping( circ, settings, statistics );
+}
+
+circuit nct_mapping( const circuit& src, const properties::ptr& settings, const properties::ptr& statistics )
 {
   /* settings */
   const auto extra_ancilla_input_name  = get( settings, "extra_ancilla_input_name", std::string( "h" ) );
   const auto extra_ancilla_output_name = get( settings, "extra_ancilla_output_name", std::string( "h" ) );
   const auto constant_value            = get( settings, "constant_value", constant( false ) );
+  const auto num_threads               = get( settings, "num_threads", 1u );
 
   /* timing */
   properties_timer t( statistics );
 
+  circuit dst;
+  copy_metadata( src, dst );
+
   /* ancilla needed */
-  if ( circ.lines() > 3u && has_fully_controlled_gate( circ ) )
+  if ( src.lines() > 3u && has_fully_controlled_gate( src ) )
   {
-    add_line_to_circuit( circ, extra_ancilla_input_name, extra_ancilla_output_name, constant_value, true );
+    add_line_to_circuit( dst, extra_ancilla_input_name, extra_ancilla_output_name, constant_value, true );
   }
 
-  const auto n = circ.lines();
-  auto pos = 0u;
+  /* decompositions and positions in the destination */
+  const auto num_gates = src.num_gates();
+  const auto none = std::numeric_limits<unsigned>::max();
 
-  while ( pos < circ.num_gates() )
+  nct_decomposition_cache cache( dst.lines() );
+  std::vector<unsigned> decomposition( num_gates, none );
+  std::vector<unsigned> offsets( num_gates + 1u, 0u );
+
+  for ( auto i = 0u; i < num_gates; ++i )
   {
-    const auto& g = circ[pos];
-    const auto c = g.controls().size();
+    const auto& g = src[i];
+    if ( g.controls().size() <= 2u )
+    {
+      offsets[i + 1u] = offsets[i] + 1u;
+    }
+    else
+    {
+      decomposition[i] = cache.lookup( g );
+      offsets[i + 1u] = offsets[i] + cache.num_gates( decomposition[i] );
+    }
+  }
 
-    if ( c <= 2u )
+  for ( auto k = 0u; k < offsets.back(); ++k )
+  {
+    dst.append_gate();
+  }
+
+  const auto fill = [&]( unsigned begin, unsigned end ) {
+    for ( auto i = begin; i < end; ++i )
     {
-      ++pos;
+      if ( decomposition[i] == none )
+      {
+        dst[offsets[i]] = src[i];
+        continue;
+      }
+
+      for ( auto k = 0u; k < cache.num_gates( decomposition[i] ); ++k )
+      {
+        cache.instantiate( decomposition[i], src[i], k, dst[offsets[i] + k] );
+      }
     }
-    else if ( n + 1u >= ( c << 1u ) )
+  };
+
+  const auto threads = num_threads == 0u ? std::thread::hardware_concurrency() : num_threads;
+  if ( threads <= 1u || num_gates < parallel_threshold )
+  {
+    fill( 0u, num_gates );
+  }
+  else
+  {
+    thread_pool pool( threads );
+    const auto chunk = ( num_gates + threads - 1u ) / threads;
+
+    std::vector<std::future<void>> futures;
+    for ( auto begin = 0u; begin < num_gates; begin += chunk )
     {
-      map_barenco72_inplace( circ, pos );
-      pos += ( c - 2u ) << 2u;
+      futures.push_back( pool.enqueue( fill, begin, std::min( begin + chunk, num_gates ) ) );
     }
-    else
+    for ( auto& future : futures )
     {
-      map_barenco73_inplace( circ, pos );
+      future.get();
     }
   }
+
+  set( statistics, "cache_entries", cache.num_entries() );
+
+  return dst;
 }
 
-circuit nct_mapping( const circuit& src, const properties::ptr& settings, const properties::ptr& statistics )
+nct_mapping_stream::nct_mapping_stream( circuit& header, bool has_fully_controlled_gate, const gate_func& sink, const properties::ptr& settings )
+  : sink( sink )
 {
-  circuit dst;
+  /* settings */
+  const auto extra_ancilla_input_name  = get( settings, "extra_ancilla_input_name", std::string( "h" ) );
+  const auto extra_ancilla_output_name = get( settings, "extra_ancilla_output_name", std::string( "h" ) );
+  const auto constant_value            = get( settings, "constant_value", constant( false ) );
 
-  copy_circuit( src, dst );
-  nct_mapping_inplace( dst, settings, statistics );
-  return dst;
+  /* ancilla needed */
+  if ( header.lines() > 3u && has_fully_controlled_gate )
+  {
+    add_line_to_circuit( header, extra_ancilla_input_name, extra_ancilla_output_name, constant_value, true );
+  }
+
+  cache.reset( new nct_decomposition_cache( header.lines() ) );
+}
+
+void nct_mapping_stream::operator()( const gate& g )
+{
+  if ( g.controls().size() <= 2u )
+  {
+    sink( g );
+    return;
+  }
+
+  const auto index = cache->lookup( g );
+  for ( auto k = 0u; k < cache->num_gates( index ); ++k )
+  {
+    gate mapped;
+    cache->instantiate( index, g, k, mapped );
+    sink( mapped );
+  }
 }
 
 }
@@ -36,6 +36,11 @@
 #ifndef NCT_MAPPING_HPP
 #define NCT_MAPPING_HPP
 
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 #include <core/properties.hpp>
 #include <reversible/circuit.hpp>
 #include <reversible/gate.hpp>
@@ -49,9 +54,110 @@ void map_barenco73( const circuit& src, const gate& g, circuit& dest, unsigned p
 void map_barenco72_inplace( circuit& circ, unsigned pos );
 void map_barenco73_inplace( circuit& circ, unsigned pos );
 
+/**
+ * @brief Cache of NCT decompositions
+ *
+ * The decomposition of a multiple-controlled Toffoli gate by
+ * map_barenco72 and map_barenco73 only depends on the number of lines,
+ * the control lines, and the target line, i.e., the control count and
+ * the pattern of free lines.  The cache computes each decomposition
+ * once and instantiates it for each gate with the polarities of its
+ * controls.
+ *
+ * lookup is not thread-safe, but num_gates and instantiate can be
+ * called concurrently once all decompositions are looked up.
+ */
+class nct_decomposition_cache
+{
+public:
+  explicit nct_decomposition_cache( unsigned lines );
+
+  /* index of the decomposition of g, which must have more than two controls */
+  unsigned lookup( const gate& g );
+
+  unsigned num_gates( unsigned index ) const;
+  unsigned num_entries() const;
+
+  /* writes the k-th gate of the decomposition of g into out (which is empty) */
+  void instantiate( unsigned index, const gate& g, unsigned k, gate& out ) const;
+
+private:
+  struct literal
+  {
+    unsigned line;
+    int      control; /* copy of this control of the original gate, or -1 */
+    bool     polarity;
+  };
+
+  struct decomposition
+  {
+    std::vector<unsigned> offsets; /* literals of gate k are in [offsets[k], offsets[k + 1]), target last */
+    std::vector<literal>  literals;
+  };
+
+  struct key_hash
+  {
+    std::size_t operator()( const std::vector<unsigned>& key ) const;
+  };
+
+  unsigned                                                     lines;
+  std::vector<decomposition>                                   decompositions;
+  std::unordered_map<std::vector<unsigned>, unsigned, key_hash> index;
+  std::vector<unsigned>                                        key;
+};
+
+/**
+ * @brief Maps a circuit to NCT gates
+ *
+ * Gates with more than two controls are decomposed with map_barenco72
+ * if enough free lines are available and map_barenco73 otherwise; an
+ * extra ancilla is added if a gate controls all but one line.  The
+ * decompositions are taken from an nct_decomposition_cache and written
+ * into a destination that is allocated up front, optionally in
+ * parallel chunks.
+ *
+ * Settings:
+ * - extra_ancilla_input_name (std::string, "h")
+ * - extra_ancilla_output_name (std::string, "h")
+ * - constant_value (constant, false)
+ * - num_threads (unsigned, 1): 0 uses all cores
+ *
+ * Statistics:
+ * - runtime
+ * - cache_entries: number of distinct decompositions
+ */
 void nct_mapping_inplace( circuit& circ, const properties::ptr& settings = properties::ptr(), const properties::ptr& statistics = properties::ptr() );
 circuit nct_mapping( const circuit& src, const properties::ptr& settings = properties::ptr(), const properties::ptr& statistics = properties::ptr() );
 
+/**
+ * @brief Gate-wise NCT mapping
+ *
+ * Maps gates one at a time with the same decompositions as
+ * nct_mapping_inplace and passes the resulting gates to a sink, which
+ * allows to map streamed circuits (see stream_realization) without
+ * keeping them in memory.  Since the extra ancilla of
+ * nct_mapping_inplace depends on all gates of the circuit, the caller
+ * has to tell whether the circuit contains a fully controlled gate
+ * (e.g., from a first pass over the input); the constructor then adds
+ * the ancilla to \p header, which needs to contain the meta data of
+ * the circuit and no gates.
+ *
+ * Settings are the same as for nct_mapping_inplace.
+ */
+class nct_mapping_stream
+{
+public:
+  using gate_func = std::function<void( const gate& )>;
+
+  nct_mapping_stream( circuit& header, bool has_fully_controlled_gate, const gate_func& sink, const properties::ptr& settings = properties::ptr() );
+
+  void operator()( const gate& g );
+
+private:
+  gate_func                               sink;
+  std::unique_ptr<nct_decomposition_cache> cache;
+};
+
 }
 
 #endif
@@ -0,0 +1,344 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "native_rcbdd.hpp"
+
+#include <cassert>
+
+#include <boost/range/algorithm.hpp>
+
+#include <reversible/target_tags.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+inline unsigned x_var( unsigned i ) { return 3u * i;      }
+inline unsigned z_var( unsigned i ) { return 3u * i + 1u; }
+inline unsigned y_var( unsigned i ) { return 3u * i + 2u; }
+
+inline bdd xnor( const bdd& a, const bdd& b )
+{
+  return !( a ^ b );
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+native_rcbdd::native_rcbdd( unsigned n, unsigned log_max_objs )
+  : _manager( bdd_manager::create( 3u * n, log_max_objs ) ),
+    _n( n )
+{
+  _chi = _manager->bdd_bot();
+  _xs_cube = _ys_cube = _zs_cube = _manager->bdd_top();
+
+  for ( auto i = 0u; i < n; ++i )
+  {
+    _xs.push_back( _manager->bdd_var( x_var( i ) ) );
+    _ys.push_back( _manager->bdd_var( y_var( i ) ) );
+    _zs.push_back( _manager->bdd_var( z_var( i ) ) );
+  }
+
+  /* build cubes bottom-up */
+  _identity = _manager->bdd_top();
+  for ( auto i = n; i-- > 0u; )
+  {
+    _identity = _identity && xnor( _xs[i], _ys[i] );
+    _xs_cube = _xs[i] && _xs_cube;
+    _ys_cube = _ys[i] && _ys_cube;
+    _zs_cube = _zs[i] && _zs_cube;
+  }
+
+  std::vector<unsigned> vars( 3u * n );
+  for ( auto v = 0u; v < 3u * n; ++v ) { vars[v] = v; }
+  _xs_to_zs = _ys_to_zs = _zs_to_ys = vars;
+
+  for ( auto i = 0u; i < n; ++i )
+  {
+    _xs_to_zs[x_var( i )] = z_var( i );
+    _ys_to_zs[y_var( i )] = z_var( i );
+    _zs_to_ys[z_var( i )] = y_var( i );
+  }
+}
+
+bdd native_rcbdd::x( unsigned i ) const
+{
+  return _xs.at( i );
+}
+
+bdd native_rcbdd::y( unsigned i ) const
+{
+  return _ys.at( i );
+}
+
+bdd native_rcbdd::z( unsigned i ) const
+{
+  return _zs.at( i );
+}
+
+const std::vector<bdd>& native_rcbdd::xs() const
+{
+  return _xs;
+}
+
+const std::vector<bdd>& native_rcbdd::ys() const
+{
+  return _ys;
+}
+
+const std::vector<bdd>& native_rcbdd::zs() const
+{
+  return _zs;
+}
+
+unsigned native_rcbdd::num_vars() const
+{
+  return _n;
+}
+
+bdd_manager& native_rcbdd::manager() const
+{
+  return *_manager;
+}
+
+bdd native_rcbdd::chi() const
+{
+  return _chi;
+}
+
+void native_rcbdd::set_chi( const bdd& f )
+{
+  assert( f.manager == _manager.get() );
+  _chi = f;
+}
+
+void native_rcbdd::set_constant_value( bool v )
+{
+  _constant_value = v;
+}
+
+bool native_rcbdd::constant_value() const
+{
+  return _constant_value;
+}
+
+void native_rcbdd::set_num_inputs( unsigned n )
+{
+  _num_inputs = n;
+}
+
+void native_rcbdd::set_num_outputs( unsigned n )
+{
+  _num_outputs = n;
+}
+
+unsigned native_rcbdd::num_inputs() const
+{
+  return _num_inputs;
+}
+
+unsigned native_rcbdd::num_outputs() const
+{
+  return _num_outputs;
+}
+
+void native_rcbdd::set_input_labels( const std::vector<std::string>& labels )
+{
+  _input_labels = labels;
+}
+
+void native_rcbdd::set_output_labels( const std::vector<std::string>& labels )
+{
+  _output_labels = labels;
+}
+
+const std::vector<std::string>& native_rcbdd::input_labels() const
+{
+  return _input_labels;
+}
+
+const std::vector<std::string>& native_rcbdd::output_labels() const
+{
+  return _output_labels;
+}
+
+bdd native_rcbdd::compose( const bdd& left, const bdd& right ) const
+{
+  return move_ys_to_tmp( left ).and_exists( move_xs_to_tmp( right ), _zs_cube );
+}
+
+bdd native_rcbdd::cofactor( const bdd& f, unsigned var, bool input_polarity, bool output_polarity ) const
+{
+  const auto fx = input_polarity ? f.cof1( x_var( var ) ) : f.cof0( x_var( var ) );
+  return output_polarity ? fx.cof1( y_var( var ) ) : fx.cof0( y_var( var ) );
+}
+
+bdd native_rcbdd::move_xs_to_tmp( const bdd& f ) const
+{
+  return f.rename( _xs_to_zs );
+}
+
+bdd native_rcbdd::move_ys_to_tmp( const bdd& f ) const
+{
+  return f.rename( _ys_to_zs );
+}
+
+bdd native_rcbdd::move_tmp_to_ys( const bdd& f ) const
+{
+  return f.rename( _zs_to_ys );
+}
+
+bdd native_rcbdd::move_ys_to_xs( const bdd& f ) const
+{
+  /* not order preserving if f depends on zs, which happens in invert */
+  return f.and_exists( _identity, _ys_cube );
+}
+
+bdd native_rcbdd::remove_xs( const bdd& f ) const
+{
+  return f.exists( _xs_cube );
+}
+
+bdd native_rcbdd::remove_ys( const bdd& f ) const
+{
+  return f.exists( _ys_cube );
+}
+
+bdd native_rcbdd::remove_tmp( const bdd& f ) const
+{
+  return f.exists( _zs_cube );
+}
+
+bdd native_rcbdd::invert( const bdd& f ) const
+{
+  return move_tmp_to_ys( move_ys_to_xs( move_xs_to_tmp( f ) ) );
+}
+
+bool native_rcbdd::is_self_inverse( const bdd& f ) const
+{
+  return f.equals( invert( f ) );
+}
+
+bdd native_rcbdd::create_from_gate( unsigned target, const bdd& controlf ) const
+{
+  auto func = _manager->bdd_top();
+
+  /* bottom-up to keep intermediate results small */
+  for ( auto i = _n; i-- > 0u; )
+  {
+    func = func && xnor( _ys[i], i == target ? _xs[i] ^ controlf : _xs[i] );
+  }
+
+  return func;
+}
+
+bdd native_rcbdd::create_from_gate( const gate& g ) const
+{
+  assert( is_toffoli( g ) );
+
+  auto controlf = _manager->bdd_top();
+  for ( const auto& c : g.controls() )
+  {
+    controlf = controlf && ( c.polarity() ? _xs[c.line()] : !_xs[c.line()] );
+  }
+
+  return create_from_gate( g.targets().front(), controlf );
+}
+
+bdd native_rcbdd::create_from_circuit( const circuit& circ ) const
+{
+  auto func = _identity;
+  for ( const auto& g : circ )
+  {
+    func = compose( func, create_from_gate( g ) );
+  }
+
+  return func;
+}
+
+std::vector<char> native_rcbdd::pick_one_cube( const bdd& f ) const
+{
+  if ( f.is_bot() ) { return std::vector<char>(); }
+
+  std::vector<char> cube( 3u * _n, 2 );
+
+  auto node = f;
+  while ( !node.is_top() )
+  {
+    const auto v = node.var();
+    const auto pos = 3u * ( v / 3u ) + ( v % 3u == 0u ? 0u : ( v % 3u == 2u ? 1u : 2u ) );
+
+    if ( !node.low().is_bot() )
+    {
+      cube[pos] = 0;
+      node = node.low();
+    }
+    else
+    {
+      cube[pos] = 1;
+      node = node.high();
+    }
+  }
+
+  return cube;
+}
+
+void copy_meta_data( circuit& circ, const native_rcbdd& cf )
+{
+  circ.set_lines( cf.num_vars() );
+
+  std::vector<std::string> inputs( cf.num_vars(), cf.constant_value() ? "1" : "0" );
+  boost::copy( cf.input_labels(), inputs.end() - cf.num_inputs() );
+  circ.set_inputs( inputs );
+
+  std::vector<std::string> outputs( cf.num_vars(), "-" );
+  boost::copy( cf.output_labels(), outputs.begin() );
+  circ.set_outputs( outputs );
+
+  std::vector<constant> constants( cf.num_vars(), constant() );
+  std::fill( constants.begin(), constants.end() - cf.num_inputs(), cf.constant_value() );
+  circ.set_constants( constants );
+
+  std::vector<bool> garbage( cf.num_vars(), true );
+  std::fill( garbage.begin(), garbage.begin() + cf.num_outputs(), false );
+  circ.set_garbage( garbage );
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,149 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file native_rcbdd.hpp
+ *
+ * @brief RCBDD on the native BDD package
+ *
+ * Same interface as rcbdd, but each instance owns a self-contained
+ * bdd_manager instead of sharing CUDD's global manager state.
+ * Different instances can therefore be used concurrently from
+ * different threads, while a single instance must only be used by
+ * one thread at a time.
+ *
+ * The variables are ordered x_0 < z_0 < y_0 < x_1 < z_1 < y_1 < ...,
+ * such that moving xs or ys to the temporary zs, and zs to ys, is an
+ * order preserving renaming, which does not require any apply
+ * operation.
+ *
+ * @author agent
+ * @since  2.3
+ */
+
+#ifndef NATIVE_RCBDD_HPP
+#define NATIVE_RCBDD_HPP
+
+#include <string>
+#include <vector>
+
+#include <classical/dd/bdd.hpp>
+#include <reversible/circuit.hpp>
+
+namespace cirkit
+{
+
+class native_rcbdd
+{
+public:
+  /**
+   * @param n            Number of lines
+   * @param log_max_objs Logarithm of the node capacity of the manager
+   */
+  explicit native_rcbdd( unsigned n, unsigned log_max_objs = 20u );
+
+  bdd x( unsigned i ) const;
+  bdd y( unsigned i ) const;
+  bdd z( unsigned i ) const;
+
+  const std::vector<bdd>& xs() const;
+  const std::vector<bdd>& ys() const;
+  const std::vector<bdd>& zs() const;
+
+  unsigned num_vars() const;
+  bdd_manager& manager() const;
+  bdd chi() const;
+  void set_chi( const bdd& f );
+  void set_constant_value( bool v );
+  bool constant_value() const;
+  void set_num_inputs( unsigned n );
+  void set_num_outputs( unsigned n );
+  unsigned num_inputs() const;
+  unsigned num_outputs() const;
+  void set_input_labels( const std::vector<std::string>& labels );
+  void set_output_labels( const std::vector<std::string>& labels );
+  const std::vector<std::string>& input_labels() const;
+  const std::vector<std::string>& output_labels() const;
+
+  /* the move functions require that f does not depend on the variables it is moved to */
+  bdd compose( const bdd& left, const bdd& right ) const;
+  bdd cofactor( const bdd& f, unsigned var, bool input_polarity, bool output_polarity ) const;
+  bdd move_xs_to_tmp( const bdd& f ) const;
+  bdd move_ys_to_tmp( const bdd& f ) const;
+  bdd move_tmp_to_ys( const bdd& f ) const;
+  bdd move_ys_to_xs( const bdd& f ) const;
+  bdd remove_xs( const bdd& f ) const;
+  bdd remove_ys( const bdd& f ) const;
+  bdd remove_tmp( const bdd& f ) const;
+  bdd invert( const bdd& f ) const;
+  bool is_self_inverse( const bdd& f ) const;
+
+  bdd create_from_gate( unsigned target, const bdd& controlf ) const;
+  bdd create_from_gate( const gate& g ) const;
+  bdd create_from_circuit( const circuit& circ ) const;
+
+  /**
+   * @brief Some satisfying cube of f
+   *
+   * The layout is the same as for CUDD's PickOneCube on an rcbdd,
+   * i.e., entries 3i, 3i + 1, and 3i + 2 are for x_i, y_i, and z_i,
+   * with 0 for negative, 1 for positive, and 2 for don't care.
+   * The cube is empty if f is unsatisfiable.
+   */
+  std::vector<char> pick_one_cube( const bdd& f ) const;
+
+private:
+  bdd_manager_ptr _manager;
+  bdd _chi;
+
+  bool _constant_value = false;
+  unsigned _num_inputs = 0u;
+  unsigned _num_outputs = 0u;
+  std::vector<std::string> _input_labels;
+  std::vector<std::string> _output_labels;
+  unsigned _n = 0u;
+  std::vector<bdd> _xs;
+  std::vector<bdd> _ys;
+  std::vector<bdd> _zs;
+
+  /* cubes for quantification and the identity relation */
+  bdd _xs_cube, _ys_cube, _zs_cube, _identity;
+
+  /* variable renamings */
+  std::vector<unsigned> _xs_to_zs, _ys_to_zs, _zs_to_ys;
+};
+
+void copy_meta_data( circuit& circ, const native_rcbdd& cf );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
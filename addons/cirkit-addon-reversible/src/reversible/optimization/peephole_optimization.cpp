@@ -0,0 +1,413 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "peephole_optimization.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/format.hpp>
+
+#include <core/utils/timer.hpp>
+#include <reversible/target_tags.hpp>
+#include <reversible/functions/add_gates.hpp>
+#include <reversible/functions/copy_circuit.hpp>
+#include <reversible/functions/copy_metadata.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/* control literals are line << 1 | !polarity, sorted by line */
+using literals_t = std::vector<unsigned>;
+
+/* fingerprint of a Toffoli gate, skipping literal skip and complementing literal flip */
+std::uint64_t gate_hash( unsigned target, const literals_t& literals, unsigned skip = ~0u, unsigned flip = ~0u )
+{
+  std::uint64_t h = target + 1u;
+  for ( auto i = 0u; i < literals.size(); ++i )
+  {
+    if ( i == skip ) { continue; }
+    h = ( h ^ ( literals[i] ^ ( i == flip ? 1u : 0u ) ) ) * 0x9e3779b97f4a7c15ull;
+    h ^= h >> 29u;
+  }
+  return h;
+}
+
+struct peephole_gate
+{
+  const gate* opaque = nullptr; /* non-Toffoli gates are copied as they are */
+  unsigned    target = 0u;
+  literals_t  literals;
+  bool        alive = true;
+  unsigned    version = 0u; /* incremented whenever the literals change */
+};
+
+class peephole_manager
+{
+public:
+  peephole_manager( const circuit& base, peephole_statistics& pstats )
+    : pstats( pstats ),
+      last_control( base.lines(), -1 ),
+      last_target( base.lines(), -1 )
+  {
+    gates.reserve( base.num_gates() );
+    entries.reserve( 4u * base.num_gates() );
+    exact_index.reserve( base.num_gates() );
+    reduced_index.reserve( base.num_gates() );
+  }
+
+  void add_gate( const gate& g )
+  {
+    if ( !is_toffoli( g ) )
+    {
+      add_opaque( g );
+      return;
+    }
+
+    peephole_gate pg;
+    pg.target = g.targets().front();
+    for ( const auto& c : g.controls() )
+    {
+      pg.literals.push_back( ( c.line() << 1u ) | ( c.polarity() ? 0u : 1u ) );
+    }
+    std::sort( pg.literals.begin(), pg.literals.end() );
+
+    if ( !try_templates( pg ) )
+    {
+      append( std::move( pg ) );
+    }
+  }
+
+  void write( circuit& circ ) const
+  {
+    for ( const auto& pg : gates )
+    {
+      if ( !pg.alive ) { continue; }
+
+      if ( pg.opaque )
+      {
+        circ.append_gate() = *pg.opaque;
+        continue;
+      }
+
+      gate::control_container controls;
+      for ( auto l : pg.literals )
+      {
+        controls.push_back( make_var( l >> 1u, !( l & 1u ) ) );
+      }
+      append_toffoli( circ, controls, pg.target );
+    }
+  }
+
+private:
+  bool try_templates( const peephole_gate& pg )
+  {
+    /* all gates after the barrier commute with pg */
+    auto barrier = last_control[pg.target];
+    for ( auto l : pg.literals )
+    {
+      barrier = std::max( barrier, last_target[l >> 1u] );
+    }
+
+    const auto& literals = pg.literals;
+    int h;
+
+    /* cancellation */
+    if ( ( h = find_exact( gate_hash( pg.target, literals ), pg, ~0u, ~0u, barrier ) ) != -1 )
+    {
+      gates[h].alive = false;
+      ++pstats.cancellations;
+      return true;
+    }
+
+    for ( auto i = 0u; i < literals.size(); ++i )
+    {
+      /* polarity merge */
+      if ( ( h = find_exact( gate_hash( pg.target, literals, ~0u, i ), pg, ~0u, i, barrier ) ) != -1 )
+      {
+        auto new_literals = literals;
+        new_literals.erase( new_literals.begin() + i );
+        update( h, new_literals );
+        ++pstats.polarity_merges;
+        return true;
+      }
+
+      /* control merge, earlier gate has one control less */
+      if ( ( h = find_exact( gate_hash( pg.target, literals, i ), pg, i, ~0u, barrier ) ) != -1 )
+      {
+        auto new_literals = literals;
+        new_literals[i] ^= 1u;
+        last_control[new_literals[i] >> 1u] = std::max( last_control[new_literals[i] >> 1u], h );
+        update( h, new_literals );
+        ++pstats.control_merges;
+        return true;
+      }
+    }
+
+    /* control merge, earlier gate has one control more */
+    if ( ( h = find_reduced( gate_hash( pg.target, literals ), pg, barrier ) ) != -1 )
+    {
+      auto new_literals = gates[h].literals;
+      for ( auto& l : new_literals )
+      {
+        if ( !std::binary_search( literals.begin(), literals.end(), l ) )
+        {
+          l ^= 1u;
+          break;
+        }
+      }
+      update( h, new_literals );
+      ++pstats.control_merges;
+      return true;
+    }
+
+    return false;
+  }
+
+  /* latest alive gate after barrier that equals pg without literal skip and with literal flip complemented */
+  int find_exact( std::uint64_t key, const peephole_gate& pg, unsigned skip, unsigned flip, int barrier )
+  {
+    return find( exact_index, key, pg.target, barrier, [&]( int p ) {
+        const auto& literals = gates[p].literals;
+        if ( literals.size() + ( skip == ~0u ? 0u : 1u ) != pg.literals.size() ) { return false; }
+        for ( auto i = 0u, j = 0u; i < pg.literals.size(); ++i )
+        {
+          if ( i == skip ) { continue; }
+          if ( literals[j++] != ( pg.literals[i] ^ ( i == flip ? 1u : 0u ) ) ) { return false; }
+        }
+        return true;
+      } );
+  }
+
+  /* latest alive gate after barrier that equals pg with one additional control */
+  int find_reduced( std::uint64_t key, const peephole_gate& pg, int barrier )
+  {
+    return find( reduced_index, key, pg.target, barrier, [&]( int p ) {
+        const auto& literals = gates[p].literals;
+        return literals.size() == pg.literals.size() + 1u && std::includes( literals.begin(), literals.end(), pg.literals.begin(), pg.literals.end() );
+      } );
+  }
+
+  /* chains are sorted by decreasing position, entries of removed or changed gates are unlinked lazily,
+   * entries of live gates that do not match are kept for later queries */
+  template<typename Fn>
+  int find( std::unordered_map<std::uint64_t, int>& index, std::uint64_t key, unsigned target, int barrier, Fn&& matches )
+  {
+    const auto it = index.find( key );
+    if ( it == index.end() ) { return -1; }
+
+    auto* link = &it->second;
+    while ( *link != -1 )
+    {
+      const auto& e = entries[*link];
+      const auto p = e.position;
+      if ( p <= barrier ) { return -1; }
+      if ( !gates[p].alive || gates[p].version != e.version )
+      {
+        *link = e.next;
+        continue;
+      }
+      if ( gates[p].target == target && matches( p ) ) { return p; }
+      link = &entries[*link].next;
+    }
+    return -1;
+  }
+
+  void insert( std::unordered_map<std::uint64_t, int>& index, std::uint64_t key, int p )
+  {
+    auto* link = &index.emplace( key, -1 ).first->second;
+    while ( *link != -1 && entries[*link].position > p )
+    {
+      link = &entries[*link].next;
+    }
+    if ( *link != -1 && entries[*link].position == p )
+    {
+      entries[*link].version = gates[p].version;
+      return;
+    }
+
+    entries.push_back( {p, gates[p].version, *link} );
+    *link = entries.size() - 1;
+  }
+
+  void index_gate( int p )
+  {
+    const auto& pg = gates[p];
+    insert( exact_index, gate_hash( pg.target, pg.literals ), p );
+
+    for ( auto i = 0u; i < pg.literals.size(); ++i )
+    {
+      insert( reduced_index, gate_hash( pg.target, pg.literals, i ), p );
+    }
+  }
+
+  void update( int p, const literals_t& literals )
+  {
+    gates[p].literals = literals;
+    ++gates[p].version;
+    index_gate( p );
+  }
+
+  void append( peephole_gate&& pg )
+  {
+    const int p = gates.size();
+
+    last_target[pg.target] = p;
+    for ( auto l : pg.literals )
+    {
+      last_control[l >> 1u] = p;
+    }
+
+    gates.push_back( std::move( pg ) );
+    index_gate( p );
+  }
+
+  void add_opaque( const gate& g )
+  {
+    const int p = gates.size();
+
+    for ( const auto& c : g.controls() )
+    {
+      last_control[c.line()] = last_target[c.line()] = p;
+    }
+    for ( auto t : g.targets() )
+    {
+      last_control[t] = last_target[t] = p;
+    }
+
+    peephole_gate pg;
+    pg.opaque = &g;
+    gates.push_back( pg );
+  }
+
+private:
+  peephole_statistics& pstats;
+
+  std::vector<peephole_gate> gates;
+  std::vector<int>           last_control;
+  std::vector<int>           last_target;
+
+  struct entry
+  {
+    int      position;
+    unsigned version;
+    int      next;
+  };
+  std::vector<entry> entries;
+
+  std::unordered_map<std::uint64_t, int> exact_index;
+  std::unordered_map<std::uint64_t, int> reduced_index;
+};
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+unsigned peephole_optimization_pass( circuit& circ, const circuit& base, peephole_statistics& pstats )
+{
+  peephole_manager mgr( base, pstats );
+
+  for ( const auto& g : base )
+  {
+    mgr.add_gate( g );
+  }
+
+  circ.set_lines( base.lines() );
+  copy_metadata( base, circ );
+  mgr.write( circ );
+
+  return base.num_gates() - circ.num_gates();
+}
+
+bool peephole_optimization( circuit& circ, const circuit& base,
+                            const properties::ptr& settings,
+                            const properties::ptr& statistics )
+{
+  /* settings */
+  const auto max_passes = get( settings, "max_passes", 0u );
+  const auto verbose    = get( settings, "verbose",    false );
+
+  /* timer */
+  properties_timer t( statistics );
+
+  peephole_statistics pstats;
+
+  circuit tmp;
+  copy_circuit( base, tmp );
+
+  auto pass = 0u;
+  while ( max_passes == 0u || pass < max_passes )
+  {
+    ++pass;
+
+    circuit next;
+    const auto removed = peephole_optimization_pass( next, tmp, pstats );
+    tmp = next;
+
+    if ( verbose )
+    {
+      std::cout << boost::format( "[i] pass %d: removed %d gates, size: %d" ) % pass % removed % tmp.num_gates() << std::endl;
+    }
+
+    if ( removed == 0u ) { break; }
+  }
+
+  copy_circuit( tmp, circ );
+
+  set( statistics, "num_passes",      pass );
+  set( statistics, "cancellations",   pstats.cancellations );
+  set( statistics, "polarity_merges", pstats.polarity_merges );
+  set( statistics, "control_merges",  pstats.control_merges );
+
+  return true;
+}
+
+optimization_func peephole_optimization_func( properties::ptr settings, properties::ptr statistics )
+{
+  optimization_func f = [&settings, &statistics]( circuit& circ, const circuit& base ) {
+    return peephole_optimization( circ, base, settings, statistics );
+  };
+  f.init( settings, statistics );
+  return f;
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,84 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file peephole_optimization.hpp
+ *
+ * @brief Template based peephole optimization
+ *
+ * Toffoli gates are indexed by their target and control literals.  For
+ * each new gate, the index is queried for an earlier gate with the same
+ * target that it can be moved next to, and the pair is replaced according
+ * to one of the following templates:
+ *
+ *   cancellation:    T(C, t) T(C, t)             = id
+ *   polarity merge:  T(C x, t) T(C !x, t)        = T(C, t)
+ *   control merge:   T(C, t) T(C x, t)           = T(C !x, t)
+ *
+ * Whether a gate can be moved is tracked on the fly by remembering for
+ * each line the last gate that uses it as control or target.  This makes
+ * each pass linear in the number of gates (up to the number of controls).
+ *
+ * @author agent
+ * @since  2.3
+ */
+
+#ifndef PEEPHOLE_OPTIMIZATION_HPP
+#define PEEPHOLE_OPTIMIZATION_HPP
+
+#include <core/properties.hpp>
+#include <reversible/circuit.hpp>
+#include <reversible/optimization/optimization.hpp>
+
+namespace cirkit
+{
+
+struct peephole_statistics
+{
+  unsigned cancellations   = 0u;
+  unsigned polarity_merges = 0u;
+  unsigned control_merges  = 0u;
+};
+
+/* one pass over all gates, returns number of removed gates */
+unsigned peephole_optimization_pass( circuit& circ, const circuit& base, peephole_statistics& pstats );
+
+bool peephole_optimization( circuit& circ, const circuit& base,
+                            const properties::ptr& settings = properties::ptr(),
+                            const properties::ptr& statistics = properties::ptr() );
+
+optimization_func peephole_optimization_func( properties::ptr settings = std::make_shared<properties>(),
+                                              properties::ptr statistics = std::make_shared<properties>() );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
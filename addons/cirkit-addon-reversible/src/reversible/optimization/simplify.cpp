@@ -42,6 +42,7 @@
 #include <reversible/functions/copy_metadata.hpp>
 #include <reversible/functions/reverse_circuit.hpp>
 #include <reversible/io/print_circuit.hpp>
+#include <reversible/optimization/peephole_optimization.hpp>
 #include <reversible/utils/permutation.hpp>
 
 namespace cirkit
@@ -57,7 +58,7 @@ namespace cirkit
 
 boost::dynamic_bitset<> get_optimization_vector( const std::string& methods )
 {
-  boost::dynamic_bitset<> v( 5u );
+  boost::dynamic_bitset<> v( 6u );
 
   for ( auto c : methods )
   {
@@ -68,6 +69,7 @@ boost::dynamic_bitset<> get_optimization_vector( const std::string& methods )
     case 'a': v.set( 2u ); break;
     case 'e': v.set( 3u ); break;
     case 's': v.set( 4u ); break;
+    case 'p': v.set( 5u ); break;
     }
   }
 
@@ -455,6 +457,13 @@ circuit exorcism_merge_heuristic( const circuit& base )
   return circ;
 }
 
+circuit peephole_templates( const circuit& base, peephole_statistics& pstats )
+{
+  circuit circ;
+  peephole_optimization_pass( circ, base, pstats );
+  return circ;
+}
+
 /******************************************************************************
  * Public functions                                                           *
  ******************************************************************************/
@@ -483,6 +492,7 @@ bool simplify( circuit& circ, const circuit& base, properties::ptr settings, pro
   const auto methods_vec = get_optimization_vector( methods );
   auto improvement = true;
   auto round = 1u;
+  peephole_statistics pstats;
   std::vector<unsigned> perm( base.lines() ), gperm( base.lines() );
   boost::iota( gperm, 0u );
   while ( improvement )
@@ -491,6 +501,7 @@ bool simplify( circuit& circ, const circuit& base, properties::ptr settings, pro
 
     vsize_out( boost::str( boost::format( "\033[1;31moptimization round %d\033[0m" ) % round ) );
 
+    if ( methods_vec[5u] ) { tmp = peephole_templates( tmp, pstats ); vsize_out( "peephole" ); }
     if ( methods_vec[0u] ) { tmp = simple_merge_heuristic( tmp );   vsize_out( "simple merge" ); }
     if ( methods_vec[1u] ) { tmp = simplify_not_gates( tmp );       vsize_out( "not gates" ); }
     if ( methods_vec[2u] ) { tmp = simplify_adjacent( tmp );        vsize_out( "adjacent" ); }
@@ -503,6 +514,7 @@ bool simplify( circuit& circ, const circuit& base, properties::ptr settings, pro
     if ( reverse_opt )
     {
       reverse_circuit( tmp );
+      if ( methods_vec[5u] ) { tmp = peephole_templates( tmp, pstats ); vsize_out( "peephole (r)" ); }
       if ( methods_vec[0u] ) { tmp = simple_merge_heuristic( tmp );   vsize_out( "simple merge (r)" ); }
       if ( methods_vec[1u] ) { tmp = simplify_not_gates( tmp );       vsize_out( "not gates (r)" ); }
       if ( methods_vec[2u] ) { tmp = simplify_adjacent( tmp );        vsize_out( "adjacent (r)" ); }
@@ -528,6 +540,13 @@ bool simplify( circuit& circ, const circuit& base, properties::ptr settings, pro
   }
   circ.set_outputs( outputs );
 
+  if ( methods_vec[5u] )
+  {
+    set( statistics, "peephole_cancellations",   pstats.cancellations );
+    set( statistics, "peephole_polarity_merges", pstats.polarity_merges );
+    set( statistics, "peephole_control_merges",  pstats.control_merges );
+  }
+
   return true;
 }
 
@@ -26,11 +26,19 @@
 
 #include "window_optimization.hpp"
 
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <set>
+#include <thread>
+
+#include <core/utils/thread_pool.hpp>
 #include <core/utils/timer.hpp>
 
 #include <reversible/functions/add_circuit.hpp>
 #include <reversible/functions/circuit_to_truth_table.hpp>
 #include <reversible/functions/copy_circuit.hpp>
+#include <reversible/functions/copy_metadata.hpp>
 #include <reversible/functions/expand_circuit.hpp>
 #include <reversible/functions/find_lines.hpp>
 #include <reversible/io/print_circuit.hpp>
@@ -172,9 +180,20 @@ namespace cirkit
     select_window_func select_window = get<select_window_func>( settings, "select_window", shift_window_selection() );
     optimization_func  optimization  = get<optimization_func>( settings, "optimization", resynthesis_optimization() );
     cost_function cf = get<cost_function>( settings, "cost_function", costs_by_circuit_func( gate_costs() ) );
+    const auto memoize_costs = get( settings, "memoize_costs", false );
 
     properties_timer t( statistics );
 
+    /* gate-based costs are memoized over all windows if requested; the cache
+     * is keyed by gate shape (type, number of targets, controls, negative
+     * controls, and lines), so the cost function must not depend on more */
+    std::unique_ptr<cost_engine> engine;
+    const auto* f = boost::get<costs_by_gate_func>( &cf );
+    if ( memoize_costs && f )
+    {
+      engine.reset( new cost_engine( *f ) );
+    }
+
     copy_circuit( base, circ );
 
     while ( true )
@@ -195,7 +214,7 @@ namespace cirkit
       bool ok = optimization( new_window, s );
 
       /* check if it is cheaper */
-      bool cheaper = ok && costs( new_window, cf ) < costs( s, cf );
+      bool cheaper = ok && ( engine ? ( *engine )( new_window ) < ( *engine )( s ) : costs( new_window, cf ) < costs( s, cf ) );
 
       if ( cheaper )
       {
@@ -216,6 +235,117 @@ namespace cirkit
     return true;
   }
 
+  bool parallel_window_optimization( circuit& circ, const circuit& base, properties::ptr settings, properties::ptr statistics )
+  {
+    /* the default resynthesis does not share settings or statistics between threads */
+    const auto default_optimization = []( circuit& new_window, const circuit& old_window ) {
+      binary_truth_table spec;
+      circuit_to_truth_table( old_window, spec );
+      return transformation_based_synthesis( new_window, spec );
+    };
+
+    const auto window_length = std::max( get( settings, "window_length", 10u ), 1u );
+    const auto max_rounds    = get( settings, "max_rounds", 0u );
+    const auto num_threads   = get( settings, "num_threads", 0u );
+    optimization_func optimization = get<optimization_func>( settings, "optimization", optimization_func( default_optimization ) );
+    cost_function cf = get<cost_function>( settings, "cost_function", costs_by_circuit_func( gate_costs() ) );
+    const auto memoize_costs = get( settings, "memoize_costs", false );
+
+    properties_timer t( statistics );
+
+    /* gate-based costs are memoized over all windows and threads if
+     * requested, see window_optimization for what the cache assumes */
+    std::unique_ptr<cost_engine> engine;
+    const auto* f = boost::get<costs_by_gate_func>( &cf );
+    if ( memoize_costs && f )
+    {
+      engine.reset( new cost_engine( *f ) );
+    }
+
+    copy_circuit( base, circ );
+
+    /* optimizes the gates in [from, to) on the lines they act on */
+    const auto optimize_window = [&circ, &optimization, &cf, &engine]( unsigned from, unsigned to ) {
+      std::set<unsigned> lines;
+      find_non_empty_lines( circ.begin() + from, circ.begin() + to, std::insert_iterator<std::set<unsigned>>( lines, lines.begin() ) );
+      std::vector<unsigned> filter( lines.begin(), lines.end() );
+
+      circuit window, new_window, window_expanded;
+      copy_circuit( subcircuit( circ, from, to ), window, filter );
+
+      const auto cheaper = optimization( new_window, window ) &&
+        ( engine ? ( *engine )( new_window ) < ( *engine )( window ) : costs( new_window, cf ) < costs( window, cf ) );
+      if ( cheaper )
+      {
+        expand_circuit( new_window, window_expanded, circ.lines(), filter );
+      }
+      return std::make_pair( cheaper, window_expanded );
+    };
+
+    thread_pool pool( num_threads == 0u ? std::max( std::thread::hardware_concurrency(), 1u ) : num_threads );
+
+    auto round = 0u;
+    auto replaced = 0u;
+    auto rounds_without_improvement = 0u;
+
+    /* alternate the window boundaries between rounds, stop when none of both alignments improves */
+    while ( rounds_without_improvement < 2u && ( max_rounds == 0u || round < max_rounds ) )
+    {
+      const auto shift = ( round++ % 2u ) * ( window_length / 2u );
+
+      std::vector<std::pair<unsigned, unsigned>> windows;
+      for ( auto from = 0u; from < circ.num_gates(); )
+      {
+        const auto to = std::min( from == 0u && shift ? shift : from + window_length, circ.num_gates() );
+        windows.push_back( {from, to} );
+        from = to;
+      }
+
+      std::vector<std::future<std::pair<bool, circuit>>> futures;
+      for ( const auto& w : windows )
+      {
+        futures.push_back( pool.enqueue( optimize_window, w.first, w.second ) );
+      }
+
+      /* stitch the windows in their original order */
+      circuit next;
+      copy_metadata( circ, next );
+
+      auto improved = false;
+      for ( auto i = 0u; i < windows.size(); ++i )
+      {
+        const auto result = futures[i].get();
+        if ( result.first )
+        {
+          append_circuit( next, result.second );
+          improved = true;
+          ++replaced;
+        }
+        else
+        {
+          append_circuit( next, subcircuit( circ, windows[i].first, windows[i].second ) );
+        }
+      }
+
+      rounds_without_improvement = improved ? 0u : rounds_without_improvement + 1u;
+      circ = next;
+    }
+
+    set( statistics, "num_rounds", round );
+    set( statistics, "num_replaced", replaced );
+
+    return true;
+  }
+
+  optimization_func parallel_window_optimization_func( properties::ptr settings, properties::ptr statistics )
+  {
+    optimization_func f = [&settings, &statistics]( circuit& circ, const circuit& base ) {
+      return parallel_window_optimization( circ, base, settings, statistics );
+    };
+    f.init( settings, statistics );
+    return f;
+  }
+
   optimization_func window_optimization_func( properties::ptr settings, properties::ptr statistics )
   {
     optimization_func f = [&settings, &statistics]( circuit& circ, const circuit& base ) {
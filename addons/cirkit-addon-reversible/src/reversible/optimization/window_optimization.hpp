@@ -294,6 +294,14 @@ namespace cirkit
    *   <tr>
    *     <td colspan="2" class="indexvalue">Cost function to determine whether the optimized circuit is cheaper.</td>
    *   </tr>
+   *   <tr>
+   *     <td rowspan="2" class="indexvalue">memoize_costs</td>
+   *     <td class="indexvalue">bool</td>
+   *     <td class="indexvalue">false</td>
+   *   </tr>
+   *   <tr>
+   *     <td colspan="2" class="indexvalue">Caches the costs of a gate-based \em cost_function by gate type, number of targets, controls, and negative controls, and number of lines with a \ref revkit::cost_engine "cost_engine".  Only enable if the cost function depends on nothing else.</td>
+   *   </tr>
    * </table>
    * @param statistics <table border="0" width="100%">
    *   <tr>
@@ -313,6 +321,106 @@ namespace cirkit
    */
   bool window_optimization( circuit& circ, const circuit& base, properties::ptr settings = properties::ptr(), properties::ptr statistics = properties::ptr() );
 
+  /**
+   * @brief Parallel Window Optimization
+   *
+   * In each round, the circuit is partitioned into disjoint windows of
+   * \em window_length consecutive gates.  Each window is restricted to the
+   * lines it acts on and optimized on a thread pool using the \em optimization
+   * property.  Cheaper windows replace the original ones, which are stitched
+   * back in their original order such that the result does not depend on
+   * the scheduling.  The window boundaries are shifted by half a window in
+   * every other round, and rounds are repeated until neither alignment
+   * improves the circuit.
+   *
+   * The \em optimization functor is called concurrently and must therefore
+   * not share mutable state between calls.
+   *
+   * @param circ Optimized circuit to be generated
+   * @param base Original circuit
+   * @param settings <table border="0" width="100%">
+   *   <tr>
+   *     <td class="indexkey">Setting</td>
+   *     <td class="indexkey">Type</td>
+   *     <td class="indexkey">Default Value</td>
+   *   </tr>
+   *   <tr>
+   *     <td rowspan="2" class="indexvalue">window_length</td>
+   *     <td class="indexvalue">unsigned</td>
+   *     <td class="indexvalue">10</td>
+   *   </tr>
+   *   <tr>
+   *     <td colspan="2" class="indexvalue">Number of gates in each window.</td>
+   *   </tr>
+   *   <tr>
+   *     <td rowspan="2" class="indexvalue">optimization</td>
+   *     <td class="indexvalue">\ref revkit::optimization_func "optimization_func"</td>
+   *     <td class="indexvalue">Transformation based resynthesis</td>
+   *   </tr>
+   *   <tr>
+   *     <td colspan="2" class="indexvalue">Functor used to optimize the windows.  The default resynthesizes the truth table of each window with \ref revkit::transformation_based_synthesis "transformation_based_synthesis" like \ref revkit::resynthesis_optimization "resynthesis_optimization()", but without sharing settings or statistics between threads.</td>
+   *   </tr>
+   *   <tr>
+   *     <td rowspan="2" class="indexvalue">cost_function</td>
+   *     <td class="indexvalue">\ref revkit::cost_function "cost_function"</td>
+   *     <td class="indexvalue">\ref revkit::gate_costs "costs_by_circuit_func( gate_costs() )"</td>
+   *   </tr>
+   *   <tr>
+   *     <td colspan="2" class="indexvalue">Cost function to determine whether the optimized window is cheaper.</td>
+   *   </tr>
+   *   <tr>
+   *     <td rowspan="2" class="indexvalue">memoize_costs</td>
+   *     <td class="indexvalue">bool</td>
+   *     <td class="indexvalue">false</td>
+   *   </tr>
+   *   <tr>
+   *     <td colspan="2" class="indexvalue">Caches the costs of a gate-based \em cost_function by gate type, number of targets, controls, and negative controls, and number of lines with a \ref revkit::cost_engine "cost_engine".  Only enable if the cost function depends on nothing else.</td>
+   *   </tr>
+   *   <tr>
+   *     <td rowspan="2" class="indexvalue">num_threads</td>
+   *     <td class="indexvalue">unsigned</td>
+   *     <td class="indexvalue">0</td>
+   *   </tr>
+   *   <tr>
+   *     <td colspan="2" class="indexvalue">Number of threads (0: number of cores).</td>
+   *   </tr>
+   *   <tr>
+   *     <td rowspan="2" class="indexvalue">max_rounds</td>
+   *     <td class="indexvalue">unsigned</td>
+   *     <td class="indexvalue">0</td>
+   *   </tr>
+   *   <tr>
+   *     <td colspan="2" class="indexvalue">Maximum number of rounds (0: until no improvement).</td>
+   *   </tr>
+   * </table>
+   * @param statistics <table border="0" width="100%">
+   *   <tr>
+   *     <td class="indexkey">Information</td>
+   *     <td class="indexkey">Type</td>
+   *     <td class="indexkey">Description</td>
+   *   </tr>
+   *   <tr>
+   *     <td class="indexvalue">runtime</td>
+   *     <td class="indexvalue">double</td>
+   *     <td class="indexvalue">Run-time consumed by the algorithm in CPU seconds.</td>
+   *   </tr>
+   *   <tr>
+   *     <td class="indexvalue">num_rounds</td>
+   *     <td class="indexvalue">unsigned</td>
+   *     <td class="indexvalue">Number of rounds.</td>
+   *   </tr>
+   *   <tr>
+   *     <td class="indexvalue">num_replaced</td>
+   *     <td class="indexvalue">unsigned</td>
+   *     <td class="indexvalue">Number of replaced windows.</td>
+   *   </tr>
+   * </table>
+   * @return true on success
+   *
+   * @since  2.3
+   */
+  bool parallel_window_optimization( circuit& circ, const circuit& base, properties::ptr settings = properties::ptr(), properties::ptr statistics = properties::ptr() );
+
   /**
    * @brief Functor for the \ref revkit::window_optimization "window_optimization" algorithm
    *
@@ -326,6 +434,18 @@ namespace cirkit
   optimization_func window_optimization_func( properties::ptr settings = std::make_shared<properties>(),
                                               properties::ptr statistics = std::make_shared<properties>() );
 
+  /**
+   * @brief Functor for the \ref revkit::parallel_window_optimization "parallel_window_optimization" algorithm
+   *
+   * @param settings Settings (see \ref revkit::parallel_window_optimization "parallel_window_optimization")
+   * @param statistics Statistics (see \ref revkit::parallel_window_optimization "parallel_window_optimization")
+   * @return A functor which complies with the \ref revkit::optimization_func "optimization_func" interface
+   *
+   * @since  2.3
+   */
+  optimization_func parallel_window_optimization_func( properties::ptr settings = std::make_shared<properties>(),
+                                                       properties::ptr statistics = std::make_shared<properties>() );
+
 }
 
 #endif /* WINDOW_OPTIMIZATION_HPP */
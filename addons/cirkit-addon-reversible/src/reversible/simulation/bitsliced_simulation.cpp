@@ -0,0 +1,193 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "bitsliced_simulation.hpp"
+
+#include <cassert>
+
+#include <core/utils/timer.hpp>
+
+#include <reversible/simulation/simple_simulation.hpp>
+
+namespace cirkit
+{
+
+  /* pattern index bits 0 to 5 within a word */
+  static const std::uint64_t counting_masks[] = {
+    0xaaaaaaaaaaaaaaaaull, 0xccccccccccccccccull, 0xf0f0f0f0f0f0f0f0ull,
+    0xff00ff00ff00ff00ull, 0xffff0000ffff0000ull, 0xffffffff00000000ull
+  };
+
+  bitsliced_patterns::bitsliced_patterns( unsigned lines, unsigned num_words )
+    : _lines( lines ),
+      _num_words( num_words ),
+      _words( lines * num_words, 0u )
+  {
+  }
+
+  void bitsliced_patterns::set_counting( std::uint64_t first )
+  {
+    assert( ( first & 63u ) == 0u );
+
+    const auto first_word = first >> 6u;
+
+    for ( auto l = 0u; l < _lines; ++l )
+    {
+      auto* w = line( l );
+      for ( auto k = 0u; k < _num_words; ++k )
+      {
+        if ( l < 6u )
+        {
+          w[k] = counting_masks[l];
+        }
+        else if ( l - 6u < 64u )
+        {
+          w[k] = ( ( first_word + k ) >> ( l - 6u ) ) & 1u ? ~0ull : 0ull;
+        }
+        else
+        {
+          w[k] = 0ull;
+        }
+      }
+    }
+  }
+
+  boost::dynamic_bitset<> bitsliced_patterns::pattern( unsigned index ) const
+  {
+    boost::dynamic_bitset<> p( _lines );
+    for ( auto l = 0u; l < _lines; ++l )
+    {
+      p.set( l, ( line( l )[index >> 6u] >> ( index & 63u ) ) & 1u );
+    }
+    return p;
+  }
+
+  void bitsliced_patterns::set_pattern( unsigned index, const boost::dynamic_bitset<>& pattern )
+  {
+    const auto bit = 1ull << ( index & 63u );
+    for ( auto l = 0u; l < _lines; ++l )
+    {
+      auto& w = line( l )[index >> 6u];
+      w = pattern.test( l ) ? ( w | bit ) : ( w & ~bit );
+    }
+  }
+
+  bool bitsliced_patterns::operator==( const bitsliced_patterns& other ) const
+  {
+    return _lines == other._lines && _num_words == other._num_words && _words == other._words;
+  }
+
+  inline std::uint64_t control_word( const bitsliced_patterns& patterns, const compact_gate& g, unsigned k )
+  {
+    auto word = ~0ull;
+    for ( auto c = g.controls; c; c &= c - 1u )
+    {
+      const unsigned l = __builtin_ctzll( c );
+      word &= ( ( g.polarities >> l ) & 1u ) ? patterns.line( l )[k] : ~patterns.line( l )[k];
+    }
+    return word;
+  }
+
+  void bitsliced_simulation( bitsliced_patterns& patterns, const compact_circuit& circ,
+                             properties::ptr settings,
+                             properties::ptr statistics )
+  {
+    properties_timer t( statistics );
+
+    const auto num_words = patterns.num_words();
+
+    for ( const auto& g : circ )
+    {
+      switch ( g.type )
+      {
+      case compact_gate::gate_type::toffoli:
+        {
+          auto* t = patterns.line( g.target1 );
+          for ( auto k = 0u; k < num_words; ++k )
+          {
+            t[k] ^= control_word( patterns, g, k );
+          }
+        } break;
+
+      case compact_gate::gate_type::fredkin:
+        {
+          auto* t1 = patterns.line( g.target1 );
+          auto* t2 = patterns.line( g.target2 );
+          for ( auto k = 0u; k < num_words; ++k )
+          {
+            const auto diff = ( t1[k] ^ t2[k] ) & control_word( patterns, g, k );
+            t1[k] ^= diff;
+            t2[k] ^= diff;
+          }
+        } break;
+
+      case compact_gate::gate_type::peres:
+        {
+          auto* t1 = patterns.line( g.target1 );
+          auto* t2 = patterns.line( g.target2 );
+          for ( auto k = 0u; k < num_words; ++k )
+          {
+            const auto c = control_word( patterns, g, k );
+            t2[k] ^= c & t1[k];
+            t1[k] ^= c;
+          }
+        } break;
+
+      case compact_gate::gate_type::overflow:
+        {
+          const auto& og = circ.overflow_gate( g );
+          core_gate_simulation gate_simulation;
+          for ( auto j = 0u; j < patterns.num_patterns(); ++j )
+          {
+            auto p = patterns.pattern( j );
+            patterns.set_pattern( j, gate_simulation( og, p ) );
+          }
+        } break;
+      }
+    }
+  }
+
+  bool bitsliced_simulation( boost::dynamic_bitset<>& output, const circuit& circ, const boost::dynamic_bitset<>& input,
+                             properties::ptr settings,
+                             properties::ptr statistics )
+  {
+    properties_timer t( statistics );
+
+    bitsliced_patterns patterns( circ.lines(), 1u );
+    patterns.set_pattern( 0u, input );
+    bitsliced_simulation( patterns, compact_circuit( circ ) );
+    output = patterns.pattern( 0u );
+
+    return true;
+  }
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,140 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file bitsliced_simulation.hpp
+ *
+ * @brief Bit-parallel simulation of many patterns at once
+ *
+ * @author agent
+ * @since  2.3
+ */
+
+#ifndef BITSLICED_SIMULATION_HPP
+#define BITSLICED_SIMULATION_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include <core/properties.hpp>
+
+#include <reversible/compact_circuit.hpp>
+
+namespace cirkit
+{
+
+  /**
+   * @brief Simulation patterns in bit-sliced form
+   *
+   * Each line holds a row of 64-bit words, bit j of word k of line l is the
+   * value of line l in pattern 64k + j.  A gate is applied to all patterns
+   * with a few word operations per word.
+   *
+   * @since  2.3
+   */
+  class bitsliced_patterns
+  {
+  public:
+    bitsliced_patterns( unsigned lines, unsigned num_words );
+
+    inline unsigned lines() const        { return _lines; }
+    inline unsigned num_words() const    { return _num_words; }
+    inline unsigned num_patterns() const { return _num_words << 6u; }
+
+    inline std::uint64_t* line( unsigned l )             { return &_words[l * _num_words]; }
+    inline const std::uint64_t* line( unsigned l ) const { return &_words[l * _num_words]; }
+
+    /**
+     * @brief Assigns the patterns first, first + 1, ... in counting order
+     *
+     * Bit l of a pattern is the value of line l.  \p first must be a
+     * multiple of 64.
+     *
+     * @since  2.3
+     */
+    void set_counting( std::uint64_t first );
+
+    boost::dynamic_bitset<> pattern( unsigned index ) const;
+    void set_pattern( unsigned index, const boost::dynamic_bitset<>& pattern );
+
+    bool operator==( const bitsliced_patterns& other ) const;
+
+  private:
+    unsigned                   _lines;
+    unsigned                   _num_words;
+    std::vector<std::uint64_t> _words;
+  };
+
+  /**
+   * @brief Simulates all patterns through the circuit
+   *
+   * Overflow gates of the compact circuit (e.g. modules) are simulated
+   * pattern by pattern using core_gate_simulation.
+   *
+   * @param patterns Patterns, are overriden by the output patterns
+   * @param circ Circuit
+   * @param settings No settings
+   * @param statistics <table border="0" width="100%">
+   *   <tr>
+   *     <td class="indexkey">Information</td>
+   *     <td class="indexkey">Type</td>
+   *     <td class="indexkey">Description</td>
+   *   </tr>
+   *   <tr>
+   *     <td class="indexvalue">runtime</td>
+   *     <td class="indexvalue">double</td>
+   *     <td class="indexvalue">Run-time consumed by the algorithm in CPU seconds.</td>
+   *   </tr>
+   * </table>
+   *
+   * @since  2.3
+   */
+  void bitsliced_simulation( bitsliced_patterns& patterns, const compact_circuit& circ,
+                             properties::ptr settings = properties::ptr(),
+                             properties::ptr statistics = properties::ptr() );
+
+  /**
+   * @brief Simulates a single pattern
+   *
+   * Same interface as simple_simulation.
+   *
+   * @since  2.3
+   */
+  bool bitsliced_simulation( boost::dynamic_bitset<>& output, const circuit& circ, const boost::dynamic_bitset<>& input,
+                             properties::ptr settings = properties::ptr(),
+                             properties::ptr statistics = properties::ptr() );
+
+}
+
+#endif /* BITSLICED_SIMULATION_HPP */
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
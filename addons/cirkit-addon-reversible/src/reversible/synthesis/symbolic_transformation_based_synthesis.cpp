@@ -89,6 +89,71 @@ BDD at_least_one_different( const rcbdd& cf )
   return f;
 }
 
+bdd at_least_one_different( const native_rcbdd& cf )
+{
+  auto f = cf.manager().bdd_bot();
+
+  for ( auto i = cf.num_vars(); i-- > 0u; )
+  {
+    f = f || ( cf.x( i ) ^ cf.y( i ) );
+  }
+
+  return f;
+}
+
+/* exactly k of the xs are true */
+bdd make_eq( const native_rcbdd& cf, unsigned k )
+{
+  const auto n = cf.num_vars();
+  if ( k > n ) { return cf.manager().bdd_bot(); }
+
+  std::vector<bdd> eq( k + 1u, cf.manager().bdd_bot() );
+  eq[0u] = cf.manager().bdd_top();
+
+  for ( auto j = n; j-- > 0u; )
+  {
+    for ( auto c = k; c > 0u; --c )
+    {
+      eq[c] = ( cf.x( j ) && eq[c - 1u] ) || ( !cf.x( j ) && eq[c] );
+    }
+    eq[0u] = !cf.x( j ) && eq[0u];
+  }
+
+  return eq[k];
+}
+
+/* exactly k of the xs are true */
+BDD make_eq( const rcbdd& cf, unsigned k )
+{
+  return make_eq( cf.manager(), cf.xs(), k );
+}
+
+/* the BDD packages differ in the names of a few operations */
+inline BDD conjunction( const BDD& a, const BDD& b ) { return a & b; }
+inline bdd conjunction( const bdd& a, const bdd& b ) { return a && b; }
+
+inline bool is_zero( const rcbdd& cf, const BDD& f ) { return f == cf.manager().bddZero(); }
+inline bool is_zero( const native_rcbdd& cf, const bdd& f ) { return f.is_bot(); }
+
+std::vector<char> pick_one_cube( const rcbdd& cf, const BDD& f )
+{
+  std::vector<char> cube( 3u * cf.num_vars() );
+  f.PickOneCube( cube.data() );
+  return cube;
+}
+
+inline std::vector<char> pick_one_cube( const native_rcbdd& cf, const bdd& f ) { return cf.pick_one_cube( f ); }
+
+inline unsigned node_count( const rcbdd& cf, const BDD& f ) { return f.nodeCount(); }
+inline unsigned node_count( const native_rcbdd& cf, const bdd& f ) { return cf.manager().size(); }
+
+/* CUDD's manager is shared, hence its size is not reported */
+inline void set_manager_statistics( const properties::ptr& statistics, const rcbdd& cf ) {}
+inline void set_manager_statistics( const properties::ptr& statistics, const native_rcbdd& cf )
+{
+  set( statistics, "node_count", cf.manager().size() );
+}
+
 void assign_sets( const char * cube, unsigned j, std::vector<unsigned>& i10, std::vector<unsigned>& i01, std::vector<unsigned>& x1, std::vector<unsigned>& y1 )
 {
   const auto cx = cube[3u * j];
@@ -264,13 +329,10 @@ void synthesize_with_sat( Solver& solver, circuit& circ, unsigned n, std::vector
   set( statistics, "solving_time",     solving_time );
 }
 
-/******************************************************************************
- * Public functions                                                           *
- ******************************************************************************/
-
-bool symbolic_transformation_based_synthesis( circuit& circ, const rcbdd& cf,
-                                              const properties::ptr& settings,
-                                              const properties::ptr& statistics )
+template<typename RCBDD>
+bool symbolic_transformation_based_synthesis_bdd( circuit& circ, const RCBDD& cf,
+                                                  const properties::ptr& settings,
+                                                  const properties::ptr& statistics )
 {
   /* settings */
   const auto verbose = get( settings, "verbose", false );
@@ -289,12 +351,10 @@ bool symbolic_transformation_based_synthesis( circuit& circ, const rcbdd& cf,
 
   const auto diff = at_least_one_different( cf );
 
-  char *cube = new char[3u * cf.num_vars()];
-
   SL( const double sec = 1000000000.0L; )
   SL( std::ofstream log( "/tmp/stbs_bdd.log", std::ofstream::out ); )
   SL( auto prevtime = t.elapsed().wall; )
-  SL( log << boost::format( "0 0.00 %d" ) % f.nodeCount() << std::endl; )
+  SL( log << boost::format( "0 0.00 %d" ) % node_count( cf, f ) << std::endl; )
 
   for ( auto i = 0u; i <= n; ++i )
   {
@@ -303,21 +363,21 @@ bool symbolic_transformation_based_synthesis( circuit& circ, const rcbdd& cf,
       std::cout << "[i] i = " << i << std::endl;
     }
 
-    const auto card = make_eq( cf.manager(), cf.xs(), i );
+    const auto card = make_eq( cf, i );
 
-    auto paths = f & diff & card;
+    auto paths = conjunction( conjunction( f, diff ), card );
 
     auto count = 0u;
 
-    while ( paths != cf.manager().bddZero() )
+    while ( !is_zero( cf, paths ) )
     {
-      paths.PickOneCube( cube );
+      const auto cube = pick_one_cube( cf, paths );
 
       std::vector<unsigned> i10, i01, x1, y1;
 
       for ( auto j = 0u; j < n; ++j )
       {
-        assign_sets( cube, j, i10, i01, x1, y1 );
+        assign_sets( cube.data(), j, i10, i01, x1, y1 );
       }
 
       for ( const auto& k : i10 )
@@ -331,12 +391,12 @@ bool symbolic_transformation_based_synthesis( circuit& circ, const rcbdd& cf,
         f = cf.compose( f, cf.create_from_gate( g ) );
       }
 
-      paths = f & diff & card;
+      paths = conjunction( conjunction( f, diff ), card );
 
       ++count;
 
       SL( const auto wall = t.elapsed().wall; )
-      SL( log << boost::format( "%d %.2f %d" ) % ( assignment_count + count ) % ( ( wall - prevtime ) / sec ) % f.nodeCount() << std::endl; )
+      SL( log << boost::format( "%d %.2f %d" ) % ( assignment_count + count ) % ( ( wall - prevtime ) / sec ) % node_count( cf, f ) << std::endl; )
       SL( prevtime = wall; )
     }
 
@@ -348,13 +408,30 @@ bool symbolic_transformation_based_synthesis( circuit& circ, const rcbdd& cf,
     assignment_count += count;
   }
 
-  delete[] cube;
-
   set( statistics, "assignment_count", assignment_count );
+  set_manager_statistics( statistics, cf );
 
   return true;
 }
 
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+bool symbolic_transformation_based_synthesis( circuit& circ, const rcbdd& cf,
+                                              const properties::ptr& settings,
+                                              const properties::ptr& statistics )
+{
+  return symbolic_transformation_based_synthesis_bdd( circ, cf, settings, statistics );
+}
+
+bool symbolic_transformation_based_synthesis( circuit& circ, const native_rcbdd& cf,
+                                              const properties::ptr& settings,
+                                              const properties::ptr& statistics )
+{
+  return symbolic_transformation_based_synthesis_bdd( circ, cf, settings, statistics );
+}
+
 template<typename S>
 int difference_clauses( S& solver, const std::vector<int>& xs, const std::vector<int>& ys, int sid )
 {
@@ -39,6 +39,7 @@
 #include <core/properties.hpp>
 #include <classical/aig.hpp>
 #include <reversible/circuit.hpp>
+#include <reversible/native_rcbdd.hpp>
 #include <reversible/rcbdd.hpp>
 
 namespace cirkit
@@ -48,6 +49,16 @@ bool symbolic_transformation_based_synthesis( circuit& circ, const rcbdd& cf,
                                               const properties::ptr& settings = properties::ptr(),
                                               const properties::ptr& statistics = properties::ptr() );
 
+/**
+ * @brief Symbolic transformation based synthesis on the native BDD package
+ *
+ * Same algorithm as for rcbdd.  Since each native_rcbdd has its own
+ * manager, several syntheses can run concurrently in different threads.
+ */
+bool symbolic_transformation_based_synthesis( circuit& circ, const native_rcbdd& cf,
+                                              const properties::ptr& settings = properties::ptr(),
+                                              const properties::ptr& statistics = properties::ptr() );
+
 bool symbolic_transformation_based_synthesis_sat( circuit& circ, const rcbdd& cf,
                                                   const properties::ptr& settings = properties::ptr(),
                                                   const properties::ptr& statistics = properties::ptr() );
@@ -26,11 +26,16 @@
 
 #include "transformation_based_synthesis.hpp"
 
-#include <boost/assign/std/vector.hpp>
-#include <boost/range/algorithm.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
 
-#include <core/utils/bitset_utils.hpp>
-#include <core/utils/range_utils.hpp>
+#include <boost/dynamic_bitset.hpp>
+
+#include <core/utils/thread_pool.hpp>
 #include <core/utils/timer.hpp>
 #include <reversible/circuit.hpp>
 #include <reversible/functions/add_gates.hpp>
@@ -38,11 +43,6 @@
 #include <reversible/functions/copy_metadata.hpp>
 #include <reversible/functions/fully_specified.hpp>
 #include <reversible/io/print_circuit.hpp>
-#include <reversible/utils/truth_table_helpers.hpp>
-
-#include "synthesis_utils_p.hpp"
-
-using namespace boost::assign;
 
 namespace cirkit
 {
@@ -51,111 +51,206 @@ namespace cirkit
  * Types                                                                      *
  ******************************************************************************/
 
+/* calls f for each set bit position in bits */
+template<typename Fn>
+void foreach_bit( std::uint32_t bits, Fn&& f )
+{
+  while ( bits )
+  {
+    const auto pos = __builtin_ctz( bits );
+    bits &= bits - 1u;
+    f( pos );
+  }
+}
+
 enum direction_t
 {
   direction_back, direction_front
 };
 
-/******************************************************************************
- * Private functions                                                          *
- ******************************************************************************/
-
-/* returns true if all bits have been checked and false if while loop was broken */
-bool foreach_bit( const boost::dynamic_bitset<>& bits, std::function<bool(boost::dynamic_bitset<>::size_type)> func )
+/* Bit b of an assignment corresponds to line n - 1 - b.  The truth table is
+ * kept sorted by inputs, hence it suffices to store the output column
+ * together with its inverse.  A gate swaps pairs of assignments that agree
+ * in all controls, and only these pairs are enumerated, either as outputs
+ * (gate is appended at the back) or as inputs (gate is added in front). */
+class packed_truth_table
 {
-  auto bpos = bits.find_first();
-  while ( bpos != boost::dynamic_bitset<>::npos )
+public:
+  packed_truth_table( const permutation_t& perm, unsigned num_threads )
+    : _out( perm.begin(), perm.end() ),
+      _inv( perm.size() ),
+      _num_threads( num_threads )
   {
-    if ( !func( bpos ) ) return false;
-    bpos = bits.find_next( bpos );
+    for ( auto i = 0u; i < perm.size(); ++i )
+    {
+      _inv[perm[i]] = i;
+    }
   }
-  return true;
-}
 
-gate::control_container get_control_lines_from_mask( const boost::dynamic_bitset<>& mask )
-{
-  gate::control_container controls;
-  boost::dynamic_bitset<>::size_type pos = mask.find_first();
-  while ( pos != boost::dynamic_bitset<>::npos )
+  inline std::uint32_t size() const                    { return _out.size(); }
+  inline std::uint32_t output( std::uint32_t i ) const { return _out[i]; }
+  inline std::uint32_t input( std::uint32_t o ) const  { return _inv[o]; }
+
+  void apply_toffoli( std::uint32_t controls, std::uint32_t target, direction_t dir )
   {
-    controls += make_var( mask.size() - 1u - pos );
-    pos = mask.find_next( pos );
+    apply( controls | target, 0u, target, dir );
   }
-  return controls;
-}
 
-bitset_pair_vector_t& sort_truth_table( bitset_pair_vector_t& tt )
-{
-  typedef bitset_pair_vector_t::value_type value_type;
-  return boost::sort( tt, []( const value_type& p1, const value_type& p2 ) { return p1.first < p2.first; } );
-}
+  void apply_fredkin( std::uint32_t controls, std::uint32_t t1, std::uint32_t t2, direction_t dir )
+  {
+    apply( controls | t1, t2, t1 | t2, dir );
+  }
 
-unsigned hamming_distance( const std::pair<boost::dynamic_bitset<>, boost::dynamic_bitset<>>& p )
-{
-  return ( p.first ^ p.second ).count();
-}
+private:
+  /* swaps the pairs (x, x ^ swap) for all x with fixed bits set and zero bits cleared */
+  void apply( std::uint32_t fixed, std::uint32_t zero, std::uint32_t swap, direction_t dir )
+  {
+    auto& from = dir == direction_back ? _inv : _out;
+    auto& to   = dir == direction_back ? _out : _inv;
 
-void basic_first_step( circuit& circ, bitset_pair_vector_t& tt )
-{
-  boost::dynamic_bitset<>::size_type bpos = tt[0].second.find_first();
+    const auto free = ( size() - 1u ) & ~( fixed | zero );
+    const auto num_pairs = 1ull << __builtin_popcount( free );
 
-  while ( bpos != boost::dynamic_bitset<>::npos )
-  {
-    prepend_not( circ, circ.lines() - 1u - bpos );
-    for ( auto& p : tt )
+    const auto range = [&]( std::uint64_t begin, std::uint64_t end ) {
+      auto f = deposit( begin, free );
+      for ( auto k = begin; k < end; ++k )
+      {
+        const auto x = fixed | f, y = x ^ swap;
+        std::swap( from[x], from[y] );
+        to[from[x]] = x;
+        to[from[y]] = y;
+        f = ( ( f | ~free ) + 1u ) & free;
+      }
+    };
+
+    if ( _num_threads <= 1u || num_pairs < parallel_threshold )
     {
-      p.second.flip( bpos );
+      range( 0u, num_pairs );
+      return;
     }
-    bpos = tt[0].second.find_next( bpos );
-  }
-}
 
-void insert_toffoli_gate( circuit& circ, unsigned& pos, boost::dynamic_bitset<> controls, unsigned target, bitset_pair_vector_t& tt, direction_t dir )
-{
-  insert_toffoli( circ, pos, get_control_lines_from_mask( controls ), circ.lines() - 1u - target );
+    if ( !_pool )
+    {
+      _pool.reset( new thread_pool( _num_threads ) );
+    }
 
-  for ( auto& p : tt )
-  {
-    auto& bits = ( dir == direction_back ) ? p.second : p.first;
-    if ( ( bits & controls ) == controls )
+    const auto chunk = ( num_pairs + _num_threads - 1u ) / _num_threads;
+    std::vector<std::future<void>> futures;
+    for ( auto begin = 0ull; begin < num_pairs; begin += chunk )
+    {
+      futures.push_back( _pool->enqueue( range, begin, std::min( begin + chunk, num_pairs ) ) );
+    }
+    for ( auto& future : futures )
     {
-      bits.flip( target );
+      future.get();
     }
   }
 
-  if ( dir == direction_front )
+  /* distributes the bits of value to the set bits of mask */
+  static std::uint32_t deposit( std::uint64_t value, std::uint32_t mask )
   {
-    ++pos;
-    tt = sort_truth_table( tt );
+    std::uint32_t result = 0u;
+    for ( ; mask && value; mask &= mask - 1u, value >>= 1u )
+    {
+      if ( value & 1u )
+      {
+        result |= mask & -mask;
+      }
+    }
+    return result;
   }
-}
 
-void insert_fredkin_gate( circuit& circ, unsigned& pos, boost::dynamic_bitset<> controls, unsigned t1, unsigned t2, bitset_pair_vector_t& tt, direction_t dir )
+private:
+  static constexpr std::uint64_t parallel_threshold = 1u << 14u;
+
+  std::vector<std::uint32_t>   _out;
+  std::vector<std::uint32_t>   _inv;
+  unsigned                     _num_threads;
+  std::unique_ptr<thread_pool> _pool;
+};
+
+/* Gates in front direction are appended to the front part, gates in back
+ * direction are prepended to the back part, the circuit is written once all
+ * gates are known. */
+class gate_sequence
 {
-  insert_fredkin( circ, pos, get_control_lines_from_mask( controls ), circ.lines() - 1u - t1, circ.lines() - 1u - t2 );
+public:
+  void add( std::uint32_t controls, unsigned t1, unsigned t2, direction_t dir )
+  {
+    ( dir == direction_front ? _front : _back ).push_back( {controls, t1, t2} );
+  }
 
-  for ( auto& p : tt )
+  void write( circuit& circ ) const
   {
-    auto& bits = ( dir == direction_back ) ? p.second : p.first;
-    if ( ( bits & controls ) == controls )
+    for ( const auto& g : _front )
     {
-      bool tmp = bits[t1]; bits[t1] = bits[t2]; bits[t2] = tmp;
+      write_gate( circ, g );
+    }
+    for ( auto it = _back.rbegin(); it != _back.rend(); ++it )
+    {
+      write_gate( circ, *it );
     }
   }
 
-  if ( dir == direction_front )
+private:
+  struct packed_gate
   {
-    ++pos;
-    tt = sort_truth_table( tt );
+    std::uint32_t controls;
+    unsigned      t1;
+    unsigned      t2; /* t2 == t1 for Toffoli gates */
+  };
+
+  static void write_gate( circuit& circ, const packed_gate& g )
+  {
+    const auto lines = circ.lines();
+
+    gate::control_container controls;
+    foreach_bit( g.controls, [&]( unsigned pos ) { controls.push_back( make_var( lines - 1u - pos ) ); } );
+
+    if ( g.t1 == g.t2 )
+    {
+      append_toffoli( circ, controls, lines - 1u - g.t1 );
+    }
+    else
+    {
+      append_fredkin( circ, controls, lines - 1u - g.t1, lines - 1u - g.t2 );
+    }
   }
+
+  std::vector<packed_gate> _front;
+  std::vector<packed_gate> _back;
+};
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+void basic_first_step( gate_sequence& gates, packed_truth_table& tt )
+{
+  foreach_bit( tt.output( 0u ), [&]( unsigned pos ) {
+      gates.add( 0u, pos, pos, direction_back );
+      tt.apply_toffoli( 0u, 1u << pos, direction_back );
+    } );
+}
+
+void insert_toffoli_gate( gate_sequence& gates, std::uint32_t controls, unsigned target, packed_truth_table& tt, direction_t dir )
+{
+  gates.add( controls, target, target, dir );
+  tt.apply_toffoli( controls, 1u << target, dir );
 }
 
-void adjust_line( circuit& circ, unsigned& pos, bitset_pair_vector_t& tt, unsigned line, direction_t dir, bool try_fredkin, bool fredkin_lookback )
+void insert_fredkin_gate( gate_sequence& gates, std::uint32_t controls, unsigned t1, unsigned t2, packed_truth_table& tt, direction_t dir )
 {
-  unsigned bw = circ.lines();
+  gates.add( controls, t1, t2, dir );
+  tt.apply_fredkin( controls, 1u << t1, 1u << t2, dir );
+}
 
-  auto input = tt[line].first;
-  auto output = tt[line].second;
+void adjust_line( gate_sequence& gates, packed_truth_table& tt, std::uint32_t line, direction_t dir, bool try_fredkin, bool fredkin_lookback )
+{
+  const auto all = tt.size() - 1u;
+
+  const auto input = line;
+  const auto output = tt.output( line );
   auto p = ( input ^ output ) & ( dir == direction_back ? input : output );
   auto q = ( input ^ output ) & ( dir == direction_back ? output : input );
   auto mask = dir == direction_back ? output : input;
@@ -169,96 +264,114 @@ void adjust_line( circuit& circ, unsigned& pos, bitset_pair_vector_t& tt, unsign
     {
       found = false;
 
-      auto b1 = p.find_first();
-      while ( b1 != boost::dynamic_bitset<>::npos )
+      for ( auto b1 = 0u; b1 < 32u && !found; ++b1 )
       {
-        auto b2 = q.find_first();
-        while ( b2 != boost::dynamic_bitset<>::npos )
+        if ( !( ( p >> b1 ) & 1u ) ) { continue; }
+
+        for ( auto b2 = 0u; b2 < 32u; ++b2 )
         {
-          auto mask_copy = mask;
-          mask_copy.reset( b1 );
-          mask_copy.reset( b2 );
+          if ( !( ( q >> b2 ) & 1u ) ) { continue; }
 
-          auto mask_compare = ( dir == direction_back ) ? input : output;
+          const auto mask_copy = mask & ~( 1u << b1 ) & ~( 1u << b2 );
+
+          const auto mask_compare = ( dir == direction_back ) ? input : output;
           bool mask_valid = mask_copy > mask_compare;
 
           if ( !mask_valid && fredkin_lookback ) /* try harder */
           {
             mask_valid = true;
-            boost::dynamic_bitset<> current( bw );
+            std::uint32_t current = 0u;
             do {
-              if ( ( mask_copy & current ) == mask_copy && ( current[b1] != current[b2] ) )
+              if ( ( mask_copy & current ) == mask_copy && ( ( ( current >> b1 ) ^ ( current >> b2 ) ) & 1u ) )
               {
                 mask_valid = false;
                 break;
               }
-              inc( current );
+              current = ( current + 1u ) & all;
             } while ( current != mask_compare );
           }
 
           if ( mask_valid )
           {
-            //std::cout << "[i] insert fred on " << b1 << " and " << b2 << " with mask = " << mask_copy << std::endl;
-            insert_fredkin_gate( circ, pos, mask_copy, b1, b2, tt, dir );
-            p.reset( b1 );
-            q.reset( b2 );
-            mask.set( b1 );
-            mask.reset( b2 );
+            insert_fredkin_gate( gates, mask_copy, b1, b2, tt, dir );
+            p &= ~( 1u << b1 );
+            q &= ~( 1u << b2 );
+            mask |= 1u << b1;
+            mask &= ~( 1u << b2 );
             found = true;
             break;
           }
-          b2 = q.find_next( b2 );
         }
-
-        if ( found ) break;
-        b1 = p.find_next( b1 );
       }
-    } while ( found);
+    } while ( found );
   }
 
   /* change 0 -> 1 */
-  auto bpos = p.find_first();
-  while ( bpos != boost::dynamic_bitset<>::npos )
-  {
-    insert_toffoli_gate( circ, pos, mask, bpos, tt, dir );
-    mask.set( bpos );
-    bpos = p.find_next( bpos );
-  }
+  foreach_bit( p, [&]( unsigned bpos ) {
+      insert_toffoli_gate( gates, mask, bpos, tt, dir );
+      mask |= 1u << bpos;
+    } );
 
   /* change 1 -> 0 */
-  bpos = q.find_first();
-  while ( bpos != boost::dynamic_bitset<>::npos )
-  {
-    mask.reset( bpos );
-    insert_toffoli_gate( circ, pos, mask, bpos, tt, dir );
-    bpos = q.find_next( bpos );
-  }
+  foreach_bit( q, [&]( unsigned bpos ) {
+      mask &= ~( 1u << bpos );
+      insert_toffoli_gate( gates, mask, bpos, tt, dir );
+    } );
 }
 
-void print_current_state( unsigned index, const circuit& circ, const bitset_pair_vector_t& tt )
+void print_current_state( unsigned index, const circuit& circ, const gate_sequence& gates, const packed_truth_table& tt )
 {
+  circuit current( circ.lines() );
+  gates.write( current );
+
   std::cout << "[i] state at index " << index << std::endl;
-  std::cout << "[i] current circuit: " << std::endl << circ << std::endl;
+  std::cout << "[i] current circuit: " << std::endl << current << std::endl;
   std::cout << "[i] current spec: " << std::endl;
-  for ( auto p : tt )
+  for ( auto i = 0u; i < tt.size(); ++i )
   {
-    std::cout << p.first << " |-> " << p.second << std::endl;
+    std::cout << boost::dynamic_bitset<>( circ.lines(), i ) << " |-> " << boost::dynamic_bitset<>( circ.lines(), tt.output( i ) ) << std::endl;
   }
   std::cout << std::endl;
 }
 
-/******************************************************************************
- * Public functions                                                           *
- ******************************************************************************/
+/* every value is smaller than the size and occurs once */
+bool is_permutation( const permutation_t& perm )
+{
+  boost::dynamic_bitset<> seen( perm.size() );
+  for ( auto v : perm )
+  {
+    if ( v >= perm.size() || seen.test( v ) ) { return false; }
+    seen.set( v );
+  }
+  return true;
+}
 
-bool transformation_based_synthesis( circuit& circ, const binary_truth_table& spec,
-                                     properties::ptr settings,
-                                     properties::ptr statistics )
+/* rows may be in any order, missing or duplicate inputs leave an entry out of range */
+permutation_t spec_to_permutation( const binary_truth_table& spec )
+{
+  const auto size = 1ull << spec.num_inputs();
+  permutation_t perm( size, size );
+
+  for ( const auto& row : spec )
+  {
+    const auto from = truth_table_cube_to_number( binary_truth_table::cube_type( row.first.first, row.first.second ) );
+    if ( from < size )
+    {
+      perm[from] = truth_table_cube_to_number( binary_truth_table::cube_type( row.second.first, row.second.second ) );
+    }
+  }
+
+  return perm;
+}
+
+bool transformation_based_synthesis_packed( circuit& circ, const permutation_t& perm,
+                                            const properties::ptr& settings )
 {
   /* Settings */
   const auto bidirectional    = get( settings, "bidirectional",    true  );
   const auto fredkin          = get( settings, "fredkin",          false );
   const auto fredkin_lookback = get( settings, "fredkin_lookback", false );
+  const auto num_threads      = get( settings, "num_threads",      0u    );
   const auto verbose          = get( settings, "verbose",          false );
 
   /* Warning */
@@ -267,54 +380,34 @@ bool transformation_based_synthesis( circuit& circ, const binary_truth_table& sp
     std::cout << "[w] fredkin_lookback option has no effect since fredkin option is disabled." << std::endl;
   }
 
-  properties_timer t( statistics );
-
-  /* circuit has to be empty */
-  clear_circuit( circ );
-
-  /* truth table has to be fully specified */
-  if ( !fully_specified( spec ) )
-  {
-    set_error_message( statistics, "truth table `spec` is not fully specified." );
-    return false;
-  }
-
-  /* truth table to bitsets */
-  bitset_pair_vector_t tt = truth_table_to_bitset_pair_vector( spec );
-  sort_truth_table( tt );
-
-  const auto bw = spec.num_outputs();
-  circ.set_lines( bw );
-
-  /* copy metadata */
-  copy_metadata( spec, circ );
+  packed_truth_table tt( perm, num_threads == 0u ? std::thread::hardware_concurrency() : num_threads );
+  gate_sequence gates;
 
   /* Step 1 */
   if ( !bidirectional )
   {
     if ( verbose )
     {
-      print_current_state( 0u, circ, tt );
+      print_current_state( 0u, circ, gates, tt );
     }
 
-    basic_first_step( circ, tt );
+    basic_first_step( gates, tt );
   }
 
   /* Step 2 */
   const auto start_index = bidirectional ? 0u : 1u;
-  auto pos = 0u;
 
   direction_t dir = direction_back;
   auto index = 0u;
 
-  for ( unsigned i = start_index; i < tt.size(); ++i )
+  for ( auto i = start_index; i < tt.size(); ++i )
   {
     if ( verbose )
     {
-      print_current_state( i, circ, tt );
+      print_current_state( i, circ, gates, tt );
     }
 
-    if ( tt[i].first == tt[i].second )
+    if ( tt.output( i ) == i )
     {
       continue;
     }
@@ -323,9 +416,8 @@ bool transformation_based_synthesis( circuit& circ, const binary_truth_table& sp
     index = i;
     if ( bidirectional )
     {
-      typedef bitset_pair_vector_t::value_type value_type;
-      const auto other_index = boost::find_if( tt, [&tt, &i]( const value_type& p ) { return p.second == tt[i].first; } ) - tt.begin();
-      if ( hamming_distance( tt[other_index] ) < hamming_distance( tt[i] ) )
+      const auto other_index = tt.input( i );
+      if ( __builtin_popcount( other_index ^ tt.output( other_index ) ) < __builtin_popcount( i ^ tt.output( i ) ) )
       {
         dir = direction_front;
         index = other_index;
@@ -336,12 +428,86 @@ bool transformation_based_synthesis( circuit& circ, const binary_truth_table& sp
     {
       std::cout << "[i] adjust line: " << index << std::endl;
     }
-    adjust_line( circ, pos, tt, index, dir, fredkin, fredkin_lookback );
+    adjust_line( gates, tt, index, dir, fredkin, fredkin_lookback );
   }
 
+  gates.write( circ );
+
   return true;
 }
 
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+bool transformation_based_synthesis( circuit& circ, const binary_truth_table& spec,
+                                     properties::ptr settings,
+                                     properties::ptr statistics )
+{
+  properties_timer t( statistics );
+
+  /* circuit has to be empty */
+  clear_circuit( circ );
+
+  /* truth table has to be fully specified */
+  if ( !fully_specified( spec ) )
+  {
+    set_error_message( statistics, "truth table `spec` is not fully specified." );
+    return false;
+  }
+
+  /* assignments are stored in 32 bits */
+  if ( spec.num_inputs() != spec.num_outputs() || spec.num_inputs() >= 32u )
+  {
+    set_error_message( statistics, "truth table `spec` must have n inputs and n outputs for n < 32." );
+    return false;
+  }
+
+  const auto perm = spec_to_permutation( spec );
+  if ( !is_permutation( perm ) )
+  {
+    set_error_message( statistics, "truth table `spec` is not reversible." );
+    return false;
+  }
+
+  circ.set_lines( spec.num_outputs() );
+
+  /* copy metadata */
+  copy_metadata( spec, circ );
+
+  return transformation_based_synthesis_packed( circ, perm, settings );
+}
+
+bool transformation_based_synthesis( circuit& circ, const permutation_t& perm,
+                                     properties::ptr settings,
+                                     properties::ptr statistics )
+{
+  properties_timer t( statistics );
+
+  /* circuit has to be empty */
+  clear_circuit( circ );
+
+  auto bw = 0u;
+  while ( ( 1ull << bw ) < perm.size() ) { ++bw; }
+
+  /* assignments are stored in 32 bits and the number of entries must fit as well */
+  if ( ( 1ull << bw ) != perm.size() || bw >= 32u )
+  {
+    set_error_message( statistics, "permutation `perm` must have 2^n entries for n < 32." );
+    return false;
+  }
+
+  if ( !is_permutation( perm ) )
+  {
+    set_error_message( statistics, "`perm` is not a permutation of 0, ..., 2^n - 1." );
+    return false;
+  }
+
+  circ.set_lines( bw );
+
+  return transformation_based_synthesis_packed( circ, perm, settings );
+}
+
 truth_table_synthesis_func transformation_based_synthesis_func( properties::ptr settings,
                                                                 properties::ptr statistics )
 {
@@ -39,6 +39,7 @@
 #include <core/properties.hpp>
 #include <reversible/circuit.hpp>
 #include <reversible/truth_table.hpp>
+#include <reversible/utils/permutation.hpp>
 
 #include <reversible/synthesis/synthesis.hpp>
 
@@ -66,6 +67,14 @@ namespace cirkit
    *   <tr>
    *     <td colspan="2" class="indexvalue">Use the bidirectional approach as described in [\ref MMD03].</td>
    *   </tr>
+   *   <tr>
+   *     <td rowspan="2" class="indexvalue">num_threads</td>
+   *     <td class="indexvalue">unsigned</td>
+   *     <td class="indexvalue">0</td>
+   *   </tr>
+   *   <tr>
+   *     <td colspan="2" class="indexvalue">Number of threads to apply gates that affect many rows (0: number of cores).</td>
+   *   </tr>
    * </table>
    * @param statistics <table border="0" width="100%">
    *   <tr>
@@ -88,6 +97,26 @@ namespace cirkit
                                        properties::ptr settings = properties::ptr(),
                                        properties::ptr statistics = properties::ptr() );
 
+  /**
+   * @brief Synthesizes a circuit from a permutation using the Transformation Based approach
+   *
+   * The permutation maps each input assignment to its output assignment,
+   * where the first line corresponds to the most significant bit.  This
+   * avoids building a truth table for functions with many variables.
+   *
+   * @param circ       Empty Circuit
+   * @param perm       Permutation with 2^n entries, where n < 32
+   * @param settings   Settings (see \ref revkit::transformation_based_synthesis "transformation_based_synthesis")
+   * @param statistics Statistics (see \ref revkit::transformation_based_synthesis "transformation_based_synthesis")
+   *
+   * @return true if successful, false otherwise
+   *
+   * @since  2.3
+   */
+  bool transformation_based_synthesis( circuit& circ, const permutation_t& perm,
+                                       properties::ptr settings = properties::ptr(),
+                                       properties::ptr statistics = properties::ptr() );
+
   /**
    * @brief Functor for the \ref revkit::transformation_based_synthesis "transformation_based_synthesis" algorithm
    *
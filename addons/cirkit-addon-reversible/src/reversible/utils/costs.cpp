@@ -26,9 +26,14 @@
 
 #include "costs.hpp"
 
+#include <future>
+#include <limits>
+#include <thread>
+
 #include <boost/range/algorithm.hpp>
 #include <boost/dynamic_bitset.hpp>
 
+#include <core/utils/thread_pool.hpp>
 #include <reversible/target_tags.hpp>
 #include <reversible/functions/flatten_circuit.hpp>
 
@@ -229,6 +234,208 @@ namespace cirkit
     return boost::apply_visitor( costs_visitor( circ ), f );
   }
 
+  costs_accumulator::costs_accumulator( unsigned lines, const costs_by_gate_func& f )
+    : lines( lines ),
+      f( f ),
+      mask( ~boost::dynamic_bitset<>( lines ) ),
+      gate_mask( lines )
+  {
+  }
+
+  void costs_accumulator::add( const gate& g )
+  {
+    ++_num_gates;
+
+    /* depth, same as depth_costs */
+    gate_mask.reset();
+    for ( const auto& c : g.controls() ) { gate_mask.set( c.line() ); }
+    for ( auto t : g.targets() ) { gate_mask.set( t ); }
+
+    if ( gate_mask.intersects( mask ) )
+    {
+      ++_depth;
+      mask = gate_mask;
+    }
+    else
+    {
+      mask |= gate_mask;
+    }
+
+    /* gate costs, same as costs_visitor */
+    if ( !f ) { return; }
+
+    if ( is_module( g ) )
+    {
+      _costs += cirkit::costs( *boost::any_cast<module_tag>( g.type() ).reference.get(), f );
+    }
+    else
+    {
+      _costs += f( g, ( lines == g.controls().size() + 1 ) ? lines + 1 : lines );
+    }
+  }
+
+  /* below this number of gates, costs are summed up sequentially */
+  constexpr unsigned cost_engine_parallel_threshold = 1u << 16u;
+
+  /* table layout: kind (toffoli, fredkin, peres) x targets (0..2) x controls (< 64) x negative controls (< 64) */
+  constexpr unsigned cost_engine_table_size = 3u * 3u * 64u * 64u;
+  constexpr cost_t cost_engine_unknown = std::numeric_limits<cost_t>::max();
+
+  cost_engine::table::table( unsigned lines )
+    : lines( lines ),
+      entries( new std::atomic<cost_t>[cost_engine_table_size] )
+  {
+    for ( auto i = 0u; i < cost_engine_table_size; ++i )
+    {
+      entries[i].store( cost_engine_unknown, std::memory_order_relaxed );
+    }
+  }
+
+  cost_engine::cost_engine( const costs_by_gate_func& f, unsigned num_threads )
+    : f( f ),
+      num_threads( num_threads == 0u ? std::thread::hardware_concurrency() : num_threads ),
+      entries( 0u )
+  {
+  }
+
+  const cost_engine::table& cost_engine::get_table( unsigned lines ) const
+  {
+    std::lock_guard<std::mutex> lock( mutex );
+    auto& t = tables[lines];
+    if ( !t )
+    {
+      t.reset( new table( lines ) );
+    }
+    return *t;
+  }
+
+  cost_t cost_engine::gate_costs( const gate& g, unsigned lines, const table& t ) const
+  {
+    std::uint64_t kind;
+    if ( is_toffoli( g ) )      { kind = 0u; }
+    else if ( is_fredkin( g ) ) { kind = 1u; }
+    else if ( is_peres( g ) )   { kind = 2u; }
+    else
+    {
+      /* unknown gate types are not memoized */
+      return f( g, lines );
+    }
+
+    const std::uint64_t controls = g.controls().size();
+    const std::uint64_t targets = g.targets().size();
+    std::uint64_t negative = 0u;
+    for ( const auto& c : g.controls() )
+    {
+      negative += c.polarity() ? 0u : 1u;
+    }
+
+    /* all costs only depend on this signature, such that concurrent writes store the same value */
+    if ( controls < 64u && targets <= 2u )
+    {
+      assert( t.lines == lines );
+      auto& entry = t.entries[( ( kind * 3u + targets ) * 64u + controls ) * 64u + negative];
+
+      auto value = entry.load( std::memory_order_relaxed );
+      if ( value == cost_engine_unknown )
+      {
+        value = f( g, lines );
+        auto expected = cost_engine_unknown;
+        if ( entry.compare_exchange_strong( expected, value, std::memory_order_relaxed ) )
+        {
+          ++entries;
+        }
+      }
+      return value;
+    }
+
+    const auto key = kind | ( targets << 2u ) | ( controls << 8u ) | ( negative << 28u ) | ( std::uint64_t( lines ) << 48u );
+
+    std::lock_guard<std::mutex> lock( mutex );
+    const auto it = memo.find( key );
+    if ( it != memo.end() )
+    {
+      return it->second;
+    }
+    const auto value = f( g, lines );
+    memo.insert( {key, value} );
+    ++entries;
+    return value;
+  }
+
+  cost_t cost_engine::sum( const circuit& circ, unsigned from, unsigned to ) const
+  {
+    const auto lines = circ.lines();
+
+    /* gates that act on all lines are evaluated with an extra line, see costs */
+    const auto& t = get_table( lines );
+    const auto& t_full = get_table( lines + 1u );
+
+    cost_t sum = 0ull;
+    for ( auto it = circ.begin() + from; it != circ.begin() + to; ++it )
+    {
+      // respect modules
+      if ( is_module( *it ) )
+      {
+        sum += ( *this )( *boost::any_cast<module_tag>( it->type() ).reference.get() );
+      }
+      else if ( lines == it->controls().size() + 1 )
+      {
+        sum += gate_costs( *it, lines + 1u, t_full );
+      }
+      else
+      {
+        sum += gate_costs( *it, lines, t );
+      }
+    }
+    return sum;
+  }
+
+  cost_t cost_engine::operator()( const gate& g, unsigned lines ) const
+  {
+    return gate_costs( g, lines, get_table( lines ) );
+  }
+
+  cost_t cost_engine::operator()( const circuit& circ ) const
+  {
+    return ( *this )( circ, 0u, circ.num_gates() );
+  }
+
+  cost_t cost_engine::operator()( const circuit& circ, unsigned from, unsigned to ) const
+  {
+    if ( num_threads <= 1u || to - from < cost_engine_parallel_threshold )
+    {
+      return sum( circ, from, to );
+    }
+
+    thread_pool pool( num_threads );
+    const auto chunk = ( to - from + num_threads - 1u ) / num_threads;
+
+    std::vector<std::future<cost_t>> futures;
+    for ( auto begin = from; begin < to; begin += chunk )
+    {
+      futures.push_back( pool.enqueue( [this, &circ]( unsigned begin, unsigned end ) { return sum( circ, begin, end ); },
+                                       begin, std::min( begin + chunk, to ) ) );
+    }
+
+    cost_t total = 0ull;
+    for ( auto& future : futures )
+    {
+      total += future.get();
+    }
+    return total;
+  }
+
+  long long cost_engine::delta( const circuit& circ, unsigned from, unsigned to, const circuit& replacement ) const
+  {
+    assert( replacement.lines() == circ.lines() );
+    return static_cast<long long>( ( *this )( replacement ) ) - static_cast<long long>( ( *this )( circ, from, to ) );
+  }
+
+  unsigned cost_engine::num_entries() const
+  {
+    return entries;
+  }
+
 }
 
 // Local Variables:
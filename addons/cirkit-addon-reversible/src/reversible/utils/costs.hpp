@@ -37,6 +37,14 @@
 #ifndef COSTS_HPP
 #define COSTS_HPP
 
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <boost/dynamic_bitset.hpp>
 #include <boost/variant.hpp>
 
 #include <reversible/circuit.hpp>
@@ -261,6 +269,122 @@ namespace cirkit
    */
   cost_t costs( const circuit& circ, const cost_function& f );
 
+  /**
+   * @brief Accumulates costs of a circuit gate by gate
+   *
+   * Computes the gate count, the depth (as depth_costs), and the
+   * costs of a gate-based cost function (as costs) while the gates
+   * are passed one after the other.  Hence the circuit does not need
+   * to be kept in memory, e.g., when reading it with
+   * stream_realization.  Module gates count as a single gate for the
+   * gate count and the depth.
+   *
+   * @since  2.3
+   */
+  class costs_accumulator
+  {
+  public:
+    /**
+     * @param lines Number of lines of the circuit
+     * @param f     Gate-based cost function, if empty only the
+     *              gate count and the depth are computed
+     */
+    explicit costs_accumulator( unsigned lines, const costs_by_gate_func& f = costs_by_gate_func() );
+
+    void add( const gate& g );
+
+    cost_t num_gates() const { return _num_gates; }
+    cost_t depth() const     { return _depth; }
+    cost_t costs() const     { return _costs; }
+
+  private:
+    unsigned                 lines;
+    costs_by_gate_func       f;
+    boost::dynamic_bitset<>  mask;
+    boost::dynamic_bitset<>  gate_mask;
+
+    cost_t                   _num_gates = 0ull;
+    cost_t                   _depth = 0ull;
+    cost_t                   _costs = 0ull;
+  };
+
+  /**
+   * @brief Memoizing and parallel evaluation of gate-based costs
+   *
+   * The gate-based cost functions in this file only depend on the gate
+   * type, the number of targets, controls, and negative controls, and
+   * the number of lines.  The engine memoizes the costs for each such
+   * signature, sums up large circuits in parallel chunks, and computes
+   * the cost difference of replacing a window of a circuit without
+   * evaluating the remaining gates.  Custom cost functions must only
+   * depend on the same signature.
+   *
+   * All evaluations are thread-safe, e.g., one engine can be shared by
+   * the threads of parallel_window_optimization.
+   *
+   * @since  2.3
+   */
+  class cost_engine
+  {
+  public:
+    /**
+     * @param f           Gate-based cost function
+     * @param num_threads Number of threads for large circuits, 0 uses all cores
+     */
+    explicit cost_engine( const costs_by_gate_func& f, unsigned num_threads = 1u );
+
+    /**
+     * @brief Costs of a single gate in a circuit with \p lines lines
+     */
+    cost_t operator()( const gate& g, unsigned lines ) const;
+
+    /**
+     * @brief Costs of a circuit, same as costs( circ, f )
+     */
+    cost_t operator()( const circuit& circ ) const;
+
+    /**
+     * @brief Costs of the gates in [\p from, \p to) of \p circ
+     */
+    cost_t operator()( const circuit& circ, unsigned from, unsigned to ) const;
+
+    /**
+     * @brief Cost difference when replacing the gates in [\p from, \p to)
+     *
+     * Returns the costs of \p replacement minus the costs of the
+     * replaced gates, where \p replacement has the same lines as
+     * \p circ.  Negative values indicate an improvement.
+     */
+    long long delta( const circuit& circ, unsigned from, unsigned to, const circuit& replacement ) const;
+
+    /**
+     * @brief Number of memoized gate signatures
+     */
+    unsigned num_entries() const;
+
+  private:
+    /* memoized costs for gates with less than 64 controls on a fixed number of lines */
+    struct table
+    {
+      explicit table( unsigned lines );
+
+      unsigned                                lines;
+      std::unique_ptr<std::atomic<cost_t>[]> entries;
+    };
+
+    const table& get_table( unsigned lines ) const;
+    cost_t gate_costs( const gate& g, unsigned lines, const table& t ) const;
+    cost_t sum( const circuit& circ, unsigned from, unsigned to ) const;
+
+    costs_by_gate_func f;
+    unsigned           num_threads;
+
+    mutable std::mutex                                 mutex;
+    mutable std::map<unsigned, std::unique_ptr<table>> tables;
+    mutable std::unordered_map<std::uint64_t, cost_t>  memo; /* large gates */
+    mutable std::atomic<unsigned>                      entries;
+  };
+
 }
 
 #endif /* COSTS_HPP */
@@ -0,0 +1,195 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "simulation_equivalence_check.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/format.hpp>
+
+#include <core/utils/thread_pool.hpp>
+#include <core/utils/timer.hpp>
+#include <reversible/compact_circuit.hpp>
+#include <reversible/simulation/bitsliced_simulation.hpp>
+#include <reversible/verification/xorsat_equivalence_check.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+/* line of circ1 that corresponds to line i of circ2 */
+std::vector<unsigned> derive_output_mapping( const circuit& circ1, const circuit& circ2, bool name_mapping )
+{
+  std::vector<unsigned> mapping( circ2.lines() );
+
+  for ( auto i = 0u; i < circ2.lines(); ++i )
+  {
+    if ( !name_mapping )
+    {
+      mapping[i] = i;
+      continue;
+    }
+
+    const auto it = std::find( circ1.outputs().begin(), circ1.outputs().end(), circ2.outputs()[i] );
+
+    if ( it == circ1.outputs().end() )
+    {
+      throw boost::str( boost::format( "cannot find output %s in first circuit" ) % circ2.outputs()[i] );
+    }
+
+    mapping[i] = std::distance( circ1.outputs().begin(), it );
+  }
+
+  return mapping;
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+bool simulation_equivalence_check( const circuit& circ1, const circuit& circ2,
+                                   const properties::ptr& settings,
+                                   const properties::ptr& statistics )
+{
+  /* settings */
+  const auto name_mapping = get( settings, "name_mapping", false );
+  const auto max_lines    = std::min( get( settings, "max_lines", 28u ), 40u );
+  const auto num_threads  = get( settings, "num_threads", 0u );
+  const auto block_words  = get( settings, "block_words", 256u );
+
+  if ( circ1.lines() != circ2.lines() )
+  {
+    std::cout << "[e] circuits do not have the same number of lines" << std::endl;
+    return false;
+  }
+
+  if ( circ1.lines() > max_lines )
+  {
+    return xorsat_equivalence_check( circ1, circ2, settings, statistics );
+  }
+
+  /* timing */
+  properties_timer t( statistics );
+
+  const auto n       = circ1.lines();
+  const auto mapping = derive_output_mapping( circ1, circ2, name_mapping );
+
+  const compact_circuit ccirc1( circ1 );
+  const compact_circuit ccirc2( circ2 );
+
+  const auto num_patterns = 1ull << n;
+  const auto num_words    = static_cast<unsigned>( std::min<std::uint64_t>( std::max<std::uint64_t>( num_patterns >> 6u, 1u ), std::max( block_words, 1u ) ) );
+  const auto block_size   = static_cast<std::uint64_t>( num_words ) << 6u;
+  const auto num_blocks   = ( num_patterns + block_size - 1u ) / block_size;
+
+  std::atomic<std::uint64_t> next_block( 0u );
+  std::atomic<bool>          mismatch( false );
+  std::mutex                 cex_mutex;
+  std::uint64_t              cex = 0u;
+
+  /* each worker takes the next unprocessed block until all are done or a mismatch was found */
+  const auto worker = [&]() {
+    bitsliced_patterns patterns1( n, num_words ), patterns2( n, num_words );
+
+    while ( !mismatch )
+    {
+      const auto block = next_block++;
+      if ( block >= num_blocks ) { break; }
+
+      const auto first = block * block_size;
+      patterns1.set_counting( first );
+      patterns2.set_counting( first );
+      bitsliced_simulation( patterns1, ccirc1 );
+      bitsliced_simulation( patterns2, ccirc2 );
+
+      /* patterns beyond 2^n only occur for n < 6 */
+      const auto valid = num_patterns - first < 64u ? ( 1ull << ( num_patterns - first ) ) - 1u : ~0ull;
+
+      for ( auto k = 0u; k < num_words; ++k )
+      {
+        auto diff = 0ull;
+        for ( auto i = 0u; i < n; ++i )
+        {
+          diff |= patterns1.line( mapping[i] )[k] ^ patterns2.line( i )[k];
+        }
+        diff &= valid;
+
+        if ( diff )
+        {
+          std::lock_guard<std::mutex> lock( cex_mutex );
+          if ( !mismatch )
+          {
+            cex = first + ( static_cast<std::uint64_t>( k ) << 6u ) + __builtin_ctzll( diff );
+            mismatch = true;
+          }
+          return;
+        }
+      }
+    }
+  };
+
+  const auto threads = num_threads == 0u ? std::max( std::thread::hardware_concurrency(), 1u ) : num_threads;
+  {
+    thread_pool pool( threads );
+    std::vector<std::future<void>> futures;
+    for ( auto i = 0u; i < std::min<std::uint64_t>( threads, num_blocks ); ++i )
+    {
+      futures.push_back( pool.enqueue( worker ) );
+    }
+    for ( auto& f : futures )
+    {
+      f.get();
+    }
+  }
+
+  if ( mismatch )
+  {
+    set( statistics, "counterexample", boost::dynamic_bitset<>( n, cex ) );
+  }
+
+  return !mismatch;
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,62 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file simulation_equivalence_check.hpp
+ *
+ * @brief Equivalence check using exhaustive bit-sliced simulation
+ *
+ * The input space is split into blocks that are simulated on a thread pool.
+ * The check stops at the first mismatch, which is stored as counterexample.
+ * Circuits with more lines than max_lines are checked with
+ * xorsat_equivalence_check instead.
+ *
+ * @author agent
+ * @since  2.3
+ */
+
+#ifndef SIMULATION_EQUIVALENCE_CHECK_HPP
+#define SIMULATION_EQUIVALENCE_CHECK_HPP
+
+#include <core/properties.hpp>
+#include <reversible/circuit.hpp>
+
+namespace cirkit
+{
+
+bool simulation_equivalence_check( const circuit& circ1, const circuit& circ2,
+                                   const properties::ptr& settings = properties::ptr(),
+                                   const properties::ptr& statistics = properties::ptr() );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
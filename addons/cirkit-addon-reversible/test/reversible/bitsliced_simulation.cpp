@@ -0,0 +1,85 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE bitsliced_simulation
+
+#include <random>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <reversible/circuit.hpp>
+#include <reversible/compact_circuit.hpp>
+#include <reversible/functions/add_gates.hpp>
+#include <reversible/simulation/bitsliced_simulation.hpp>
+#include <reversible/simulation/simple_simulation.hpp>
+
+#include "random_circuit.h"
+
+BOOST_AUTO_TEST_CASE(simple)
+{
+  using namespace cirkit;
+
+  const auto lines = 10u;
+
+  std::mt19937 gen( 42 );
+  auto circ = test::random_circuit( lines, 200u, gen, 0.25 );
+
+  /* interleave Fredkin gates with positive controls */
+  for ( auto i = 0u; i < 50u; ++i )
+  {
+    const auto t1 = gen() % lines;
+    const auto t2 = ( t1 + 1u + gen() % ( lines - 1u ) ) % lines;
+
+    gate::control_container controls;
+    for ( auto l = 0u; l < lines; ++l )
+    {
+      if ( l != t1 && l != t2 && gen() % 4u == 0u )
+      {
+        controls.push_back( make_var( l ) );
+      }
+    }
+    insert_fredkin( circ, 4u * i, controls, t1, t2 );
+  }
+
+  bitsliced_patterns patterns( lines, ( 1u << lines ) >> 6u );
+  patterns.set_counting( 0u );
+  bitsliced_simulation( patterns, compact_circuit( circ ) );
+
+  for ( auto j = 0u; j < ( 1u << lines ); ++j )
+  {
+    boost::dynamic_bitset<> input( lines, j ), output;
+    simple_simulation( output, circ, input );
+
+    BOOST_CHECK( patterns.pattern( j ) == output );
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
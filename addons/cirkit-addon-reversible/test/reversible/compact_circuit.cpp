@@ -0,0 +1,80 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE compact_circuit
+
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/output_test_stream.hpp>
+
+#include <reversible/circuit.hpp>
+#include <reversible/compact_circuit.hpp>
+#include <reversible/target_tags.hpp>
+#include <reversible/functions/add_gates.hpp>
+#include <reversible/io/print_circuit.hpp>
+
+BOOST_AUTO_TEST_CASE(simple)
+{
+  using boost::test_tools::output_test_stream;
+
+  using namespace cirkit;
+
+  circuit circ( 6u ), copy;
+
+  append_toffoli( circ )( 0u, 2u )( 5u );
+  append_cnot( circ, make_var( 0u, false ), 2u );
+  append_not( circ, 0u );
+  append_fredkin( circ )( 1u )( 3u, 4u );
+  circ.add_module( "m", circuit( 3u ) );
+  append_module( circ, "m", gate::control_container(), gate::target_container( {1u, 2u, 3u} ) );
+
+  compact_circuit ccirc( circ );
+
+  BOOST_CHECK( ccirc.lines() == 6u );
+  BOOST_CHECK( ccirc.num_gates() == 5u );
+  BOOST_CHECK( !ccirc.is_compact() );
+
+  BOOST_CHECK( ccirc[0u].type == compact_gate::gate_type::toffoli );
+  BOOST_CHECK( ccirc[0u].controls == 5u && ccirc[0u].polarities == 5u && ccirc[0u].target1 == 5u );
+  BOOST_CHECK( ccirc[1u].controls == 1u && ccirc[1u].polarities == 0u );
+  BOOST_CHECK( ccirc[3u].type == compact_gate::gate_type::fredkin );
+  BOOST_CHECK( ccirc[3u].target_mask() == 24u );
+  BOOST_CHECK( ccirc[4u].is_overflow() && is_module( ccirc.overflow_gate( ccirc[4u] ) ) );
+
+  ccirc.to_circuit( copy );
+
+  output_test_stream output, output_copy;
+  output << circ;
+  output_copy << copy;
+
+  BOOST_CHECK( output.str() == output_copy.str() );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,128 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE costs
+
+#include <random>
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <reversible/circuit.hpp>
+#include <reversible/functions/add_gates.hpp>
+#include <reversible/utils/costs.hpp>
+
+#include "random_circuit.h"
+
+using namespace cirkit;
+using namespace cirkit::test;
+
+const std::vector<costs_by_gate_func> functions = {transistor_costs(), sk2013_quantum_costs(), ncv_quantum_costs(),
+                                                   clifford_t_quantum_costs(), t_depth_costs(), t_costs(), h_costs()};
+
+/* gates [from, to) of circ replaced by replacement */
+circuit replace_window( const circuit& circ, unsigned from, unsigned to, const circuit& replacement )
+{
+  circuit replaced( circ.lines() );
+  for ( auto i = 0u; i < from; ++i ) { replaced.append_gate() = circ[i]; }
+  for ( const auto& g : replacement ) { replaced.append_gate() = g; }
+  for ( auto i = to; i < circ.num_gates(); ++i ) { replaced.append_gate() = circ[i]; }
+  return replaced;
+}
+
+BOOST_AUTO_TEST_CASE(memoization)
+{
+  std::mt19937 gen( 42 );
+  const auto circ = random_circuit( 8u, 500u, gen );
+
+  for ( const auto& f : functions )
+  {
+    cost_engine engine( f );
+    BOOST_CHECK_EQUAL( engine( circ ), costs( circ, f ) );
+
+    /* one entry per control count and number of negative controls */
+    BOOST_CHECK( engine.num_entries() <= 8u * 8u );
+
+    for ( const auto& g : circ )
+    {
+      BOOST_CHECK_EQUAL( engine( g, circ.lines() ), f( g, circ.lines() ) );
+    }
+
+    /* the same gates on another number of lines are memoized separately */
+    circuit wide( 12u );
+    for ( const auto& g : circ ) { wide.append_gate() = g; }
+    BOOST_CHECK_EQUAL( engine( wide ), costs( wide, f ) );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(delta)
+{
+  std::mt19937 gen( 42 );
+  const auto circ = random_circuit( 8u, 500u, gen );
+
+  circuit replacement( circ.lines() );
+  for ( auto i = 300u; i < 350u; ++i )
+  {
+    replacement.append_gate() = circ[i];
+  }
+
+  /* inner window, window at the end, empty window, and the whole circuit */
+  const std::vector<std::pair<unsigned, unsigned>> windows = {{100u, 200u}, {450u, 500u}, {250u, 250u}, {0u, 500u}};
+
+  for ( const auto& f : functions )
+  {
+    cost_engine engine( f );
+    for ( const auto& w : windows )
+    {
+      for ( const auto& r : {replacement, circuit( circ.lines() )} )
+      {
+        BOOST_CHECK_EQUAL( static_cast<long long>( costs( circ, f ) ) + engine.delta( circ, w.first, w.second, r ),
+                           static_cast<long long>( costs( replace_window( circ, w.first, w.second, r ), f ) ) );
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(parallel_reduction)
+{
+  std::mt19937 gen( 7 );
+  const auto circ = random_circuit( 10u, 100000u, gen );
+
+  const cost_engine sequential( ncv_quantum_costs{} );
+  for ( auto num_threads : {2u, 4u} )
+  {
+    cost_engine engine( ncv_quantum_costs(), num_threads );
+    BOOST_CHECK_EQUAL( engine( circ ), costs( circ, costs_by_gate_func( ncv_quantum_costs() ) ) );
+    BOOST_CHECK_EQUAL( engine( circ, 1000u, 90000u ), sequential( circ, 1000u, 90000u ) );
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
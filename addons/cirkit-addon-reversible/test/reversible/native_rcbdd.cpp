@@ -0,0 +1,137 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE native_rcbdd
+
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <core/properties.hpp>
+#include <reversible/circuit.hpp>
+#include <reversible/native_rcbdd.hpp>
+#include <reversible/functions/add_gates.hpp>
+#include <reversible/functions/reverse_circuit.hpp>
+#include <reversible/synthesis/symbolic_transformation_based_synthesis.hpp>
+#include <reversible/utils/permutation.hpp>
+
+#include "random_circuit.h"
+
+using namespace cirkit;
+using namespace cirkit::test;
+
+circuit synthesize( const circuit& spec )
+{
+  native_rcbdd cf( spec.lines() );
+  cf.set_num_inputs( spec.lines() );
+  cf.set_num_outputs( spec.lines() );
+  cf.set_chi( cf.create_from_circuit( spec ) );
+
+  circuit circ;
+  symbolic_transformation_based_synthesis( circ, cf );
+  return circ;
+}
+
+BOOST_AUTO_TEST_CASE(relations)
+{
+  std::mt19937 gen( 42 );
+
+  for ( auto lines = 2u; lines <= 6u; ++lines )
+  {
+    const auto spec = random_circuit( lines, 20u, gen, 1.0 / 3.0 );
+
+    native_rcbdd cf( lines );
+    const auto f = cf.create_from_circuit( spec );
+    const auto identity = cf.create_from_circuit( circuit( lines ) );
+
+    /* inversion renames xs and ys through the temporary variables */
+    circuit rev;
+    reverse_circuit( spec, rev );
+    BOOST_CHECK( cf.invert( f ).equals( cf.create_from_circuit( rev ) ) );
+    BOOST_CHECK( cf.invert( cf.invert( f ) ).equals( f ) );
+    BOOST_CHECK( cf.compose( f, cf.invert( f ) ).equals( identity ) );
+    BOOST_CHECK( cf.compose( identity, f ).equals( f ) );
+
+    /* Toffoli gates are self-inverse */
+    for ( const auto& g : spec )
+    {
+      BOOST_CHECK( cf.is_self_inverse( cf.create_from_gate( g ) ) );
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(synthesis)
+{
+  std::mt19937 gen( 42 );
+
+  for ( auto lines = 2u; lines <= 6u; ++lines )
+  {
+    const auto spec = random_circuit( lines, 20u, gen, 1.0 / 3.0 );
+
+    const auto circ = synthesize( spec );
+    BOOST_CHECK_EQUAL( circ.lines(), lines );
+    BOOST_CHECK( circuit_to_permutation( circ ) == circuit_to_permutation( spec ) );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_jobs)
+{
+  std::mt19937 gen( 7 );
+
+  std::vector<circuit> specs;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    specs.push_back( random_circuit( 6u, 30u, gen, 1.0 / 3.0 ) );
+  }
+
+  /* each job uses its own manager */
+  std::vector<circuit> circs( specs.size() );
+  std::vector<std::thread> threads;
+  for ( auto i = 0u; i < specs.size(); ++i )
+  {
+    threads.emplace_back( [&specs, &circs, i]() { circs[i] = synthesize( specs[i] ); } );
+  }
+  for ( auto& t : threads )
+  {
+    t.join();
+  }
+
+  /* and gives the same result as running the jobs one after another */
+  for ( auto i = 0u; i < specs.size(); ++i )
+  {
+    BOOST_CHECK( circuit_to_permutation( circs[i] ) == circuit_to_permutation( specs[i] ) );
+    BOOST_CHECK_EQUAL( circs[i].num_gates(), synthesize( specs[i] ).num_gates() );
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
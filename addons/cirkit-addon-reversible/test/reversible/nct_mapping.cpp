@@ -0,0 +1,159 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE nct_mapping
+
+#include <random>
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/test/included/unit_test.hpp>
+
+#include <core/properties.hpp>
+#include <reversible/circuit.hpp>
+#include <reversible/functions/add_gates.hpp>
+#include <reversible/mapping/nct_mapping.hpp>
+#include <reversible/simulation/simple_simulation.hpp>
+#include <reversible/utils/permutation.hpp>
+
+#include "random_circuit.h"
+
+using namespace cirkit;
+using namespace cirkit::test;
+
+void check_nct( const circuit& circ )
+{
+  for ( const auto& g : circ )
+  {
+    BOOST_CHECK( g.controls().size() <= 2u );
+  }
+}
+
+void check_same_gates( const circuit& a, const circuit& b )
+{
+  BOOST_REQUIRE_EQUAL( a.num_gates(), b.num_gates() );
+  for ( auto i = 0u; i < a.num_gates(); ++i )
+  {
+    BOOST_CHECK( a[i].controls() == b[i].controls() );
+    BOOST_CHECK( a[i].targets() == b[i].targets() );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(simple)
+{
+  std::mt19937 gen( 42 );
+
+  for ( auto lines = 4u; lines <= 9u; ++lines )
+  {
+    /* no gate controls all other lines, hence no ancilla is added */
+    auto circ = random_circuit( lines, 50u, gen );
+    for ( auto& g : circ )
+    {
+      if ( g.controls().size() == lines - 1u ) { g.remove_control( g.controls().front() ); }
+    }
+
+    const auto mapped = nct_mapping( circ );
+
+    BOOST_CHECK_EQUAL( mapped.lines(), lines );
+    BOOST_CHECK( circuit_to_permutation( mapped ) == circuit_to_permutation( circ ) );
+    check_nct( mapped );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(fully_controlled)
+{
+  std::mt19937 gen( 5 );
+
+  for ( auto lines = 4u; lines <= 8u; ++lines )
+  {
+    /* a gate controlled on all other lines, every other control is negative */
+    auto circ = random_circuit( lines, 10u, gen );
+    gate::control_container controls;
+    for ( auto l = 1u; l < lines; ++l )
+    {
+      controls.push_back( make_var( l, l % 2u == 0u ) );
+    }
+    insert_toffoli( circ, 5u, controls, 0u );
+
+    const auto mapped = nct_mapping( circ );
+    check_nct( mapped );
+
+    /* the extra ancilla is the last line, it starts and ends in 0 */
+    BOOST_REQUIRE_EQUAL( mapped.lines(), lines + 1u );
+    for ( auto x = 0u; x < ( 1u << lines ); ++x )
+    {
+      boost::dynamic_bitset<> input( lines, x ), output, mapped_output;
+      BOOST_CHECK( simple_simulation( output, circ, input ) );
+
+      input.push_back( false );
+      BOOST_CHECK( simple_simulation( mapped_output, mapped, input ) );
+      BOOST_CHECK( !mapped_output[lines] );
+
+      mapped_output.resize( lines );
+      BOOST_CHECK( mapped_output == output );
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(cache)
+{
+  /* gates that only differ in the polarity of their controls share one decomposition */
+  circuit circ( 8u );
+  for ( auto i = 0u; i < 100u; ++i )
+  {
+    append_toffoli( circ, gate::control_container{make_var( 1u, i % 2u == 0u ), make_var( 2u, i % 3u == 0u ), make_var( 4u )}, 6u );
+    append_toffoli( circ, gate::control_container{make_var( 0u ), make_var( 3u, false ), make_var( 5u ), make_var( 7u )}, 2u );
+  }
+
+  auto statistics = std::make_shared<properties>();
+  const auto mapped = nct_mapping( circ, properties::ptr(), statistics );
+
+  BOOST_CHECK_EQUAL( statistics->get<unsigned>( "cache_entries" ), 2u );
+  BOOST_CHECK( circuit_to_permutation( mapped ) == circuit_to_permutation( circ ) );
+  check_nct( mapped );
+}
+
+BOOST_AUTO_TEST_CASE(parallel)
+{
+  std::mt19937 gen( 7 );
+  const auto circ = random_circuit( 12u, 20000u, gen );
+
+  const auto seq = nct_mapping( circ );
+  for ( auto num_threads : {2u, 4u} )
+  {
+    auto settings = std::make_shared<properties>();
+    settings->set( "num_threads", num_threads );
+
+    /* chunks are written to their precomputed positions, hence the result does not depend on the threads */
+    check_same_gates( seq, nct_mapping( circ, settings ) );
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,106 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE peephole_optimization
+
+#include <random>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <core/properties.hpp>
+#include <reversible/circuit.hpp>
+#include <reversible/functions/add_gates.hpp>
+#include <reversible/optimization/peephole_optimization.hpp>
+#include <reversible/utils/permutation.hpp>
+
+#include "random_circuit.h"
+
+BOOST_AUTO_TEST_CASE(simple)
+{
+  using namespace cirkit;
+
+  circuit circ( 4u );
+  append_toffoli( circ, {make_var( 0u ), make_var( 1u )}, 2u );
+  append_cnot( circ, 0u, 3u );
+  append_toffoli( circ, {make_var( 0u ), make_var( 1u, false )}, 2u );
+  append_cnot( circ, 0u, 3u );
+
+  /* first and third gate merge into CNOT(0, 2) across CNOT(0, 3), then both CNOT(0, 3) cancel */
+  auto statistics = std::make_shared<properties>();
+  circuit opt;
+  peephole_optimization( opt, circ, properties::ptr(), statistics );
+
+  BOOST_CHECK_EQUAL( opt.num_gates(), 1u );
+  BOOST_CHECK_EQUAL( statistics->get<unsigned>( "polarity_merges" ), 1u );
+  BOOST_CHECK_EQUAL( statistics->get<unsigned>( "cancellations" ), 1u );
+  BOOST_CHECK( circuit_to_permutation( opt ) == circuit_to_permutation( circ ) );
+}
+
+BOOST_AUTO_TEST_CASE(random_circuits)
+{
+  using namespace cirkit;
+
+  std::mt19937 gen( 42 );
+
+  for ( auto lines = 2u; lines <= 8u; ++lines )
+  {
+    const auto gates = test::random_circuit( lines, 200u, gen, 0.25 );
+
+    circuit circ( lines );
+    for ( const auto& g : gates )
+    {
+      auto controls = g.controls();
+      const auto target = g.targets().front();
+
+      append_toffoli( circ, controls, target );
+
+      /* mergeable neighbours */
+      if ( !controls.empty() && gen() % 4u == 0u )
+      {
+        controls.back().set_polarity( !controls.back().polarity() );
+        append_toffoli( circ, controls, target );
+      }
+      if ( !controls.empty() && gen() % 4u == 0u )
+      {
+        controls.pop_back();
+        append_toffoli( circ, controls, target );
+      }
+    }
+
+    circuit opt;
+    peephole_optimization( opt, circ );
+
+    BOOST_CHECK( opt.num_gates() < circ.num_gates() );
+    BOOST_CHECK( circuit_to_permutation( opt ) == circuit_to_permutation( circ ) );
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,68 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <random>
+#include <vector>
+
+#include <reversible/circuit.hpp>
+#include <reversible/functions/add_gates.hpp>
+
+namespace cirkit {
+namespace test {
+
+/* random Toffoli circuit, each line other than the target is a control
+ * with the given probability, and two thirds of the controls are positive */
+inline circuit random_circuit( unsigned lines, unsigned num_gates, std::mt19937& gen, double control_probability = 0.5 )
+{
+  circuit circ( lines );
+
+  std::bernoulli_distribution is_control( control_probability );
+  for ( auto i = 0u; i < num_gates; ++i )
+  {
+    const auto target = gen() % lines;
+
+    gate::control_container controls;
+    for ( auto l = 0u; l < lines; ++l )
+    {
+      if ( l != target && is_control( gen ) )
+      {
+        controls.push_back( make_var( l, gen() % 3u != 0u ) );
+      }
+    }
+    append_toffoli( circ, controls, target );
+  }
+
+  return circ;
+}
+
+}
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,86 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE simulation_equivalence_check
+
+#include <random>
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/test/included/unit_test.hpp>
+
+#include <core/properties.hpp>
+#include <reversible/circuit.hpp>
+#include <reversible/functions/add_gates.hpp>
+#include <reversible/simulation/simple_simulation.hpp>
+#include <reversible/verification/simulation_equivalence_check.hpp>
+
+#include "random_circuit.h"
+
+BOOST_AUTO_TEST_CASE(simple)
+{
+  using namespace cirkit;
+
+  const auto lines = 14u;
+
+  std::mt19937 gen( 42 );
+  const auto circ1 = test::random_circuit( lines, 100u, gen, 0.25 );
+
+  circuit circ3( lines );
+  for ( const auto& g : circ1 )
+  {
+    append_toffoli( circ3, g.controls(), g.targets().front() );
+  }
+
+  auto settings = std::make_shared<properties>();
+  settings->set( "num_threads", 4u );
+  settings->set( "block_words", 4u );
+
+  BOOST_CHECK( simulation_equivalence_check( circ1, circ3, settings ) );
+
+  /* differ only in one pattern */
+  gate::control_container all;
+  for ( auto l = 1u; l < lines; ++l )
+  {
+    all.push_back( make_var( l, l % 3u != 0u ) );
+  }
+  append_toffoli( circ3, all, 0u );
+
+  auto statistics = std::make_shared<properties>();
+  BOOST_CHECK( !simulation_equivalence_check( circ1, circ3, settings, statistics ) );
+
+  const auto cex = statistics->get<boost::dynamic_bitset<>>( "counterexample" );
+  boost::dynamic_bitset<> out1, out3;
+  simple_simulation( out1, circ1, cex );
+  simple_simulation( out3, circ3, cex );
+  BOOST_CHECK( out1 != out3 );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,112 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE stream_realization
+
+#include <memory>
+#include <sstream>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <reversible/circuit.hpp>
+#include <reversible/functions/add_gates.hpp>
+#include <reversible/io/stream_realization.hpp>
+#include <reversible/io/write_realization.hpp>
+#include <reversible/mapping/nct_mapping.hpp>
+#include <reversible/utils/costs.hpp>
+
+using namespace cirkit;
+
+circuit example_circuit()
+{
+  circuit circ( 5u );
+  append_toffoli( circ, {make_var( 0u ), make_var( 1u, false ), make_var( 2u ), make_var( 3u )}, 4u );
+  append_cnot( circ, 0u, 1u );
+  append_fredkin( circ, {make_var( 4u )}, 2u, 3u );
+  circ.annotate( append_not( circ, 2u ), "label", "x" );
+  append_toffoli( circ, {make_var( 1u ), make_var( 2u ), make_var( 3u )}, 0u );
+  append_toffoli( circ, {make_var( 0u ), make_var( 1u ), make_var( 2u ), make_var( 3u )}, 4u );
+  return circ;
+}
+
+BOOST_AUTO_TEST_CASE(simple)
+{
+  const auto circ = example_circuit();
+
+  std::stringstream in, out;
+  write_realization( circ, in );
+
+  std::unique_ptr<costs_accumulator> acc;
+  const auto result = stream_realization( in,
+                                          [&]( const circuit& header ) {
+                                            BOOST_CHECK_EQUAL( header.num_gates(), 0u );
+                                            write_realization_header( header, out );
+                                            acc.reset( new costs_accumulator( header.lines(), ncv_quantum_costs() ) );
+                                          },
+                                          [&]( const gate& g, const std::map<std::string, std::string>& annotations ) {
+                                            write_realization_gate( g, annotations, out );
+                                            acc->add( g );
+                                          } );
+  write_realization_footer( out );
+
+  BOOST_CHECK( result );
+  BOOST_CHECK_EQUAL( in.str(), out.str() );
+  BOOST_CHECK_EQUAL( acc->num_gates(), costs( circ, costs_by_circuit_func( gate_costs() ) ) );
+  BOOST_CHECK_EQUAL( acc->depth(), costs( circ, costs_by_circuit_func( depth_costs() ) ) );
+  BOOST_CHECK_EQUAL( acc->costs(), costs( circ, costs_by_gate_func( ncv_quantum_costs() ) ) );
+}
+
+BOOST_AUTO_TEST_CASE(nct)
+{
+  circuit circ( 5u );
+  append_toffoli( circ, {make_var( 0u ), make_var( 1u ), make_var( 2u ), make_var( 3u )}, 4u );
+  append_toffoli( circ, {make_var( 0u ), make_var( 1u, false ), make_var( 2u )}, 3u );
+  append_cnot( circ, 4u, 0u );
+
+  const auto mapped = nct_mapping( circ );
+
+  circuit header( circ.lines() ), streamed;
+  nct_mapping_stream mapper( header, true, [&streamed]( const gate& g ) { streamed.append_gate() = g; } );
+  for ( const auto& g : circ )
+  {
+    mapper( g );
+  }
+
+  BOOST_CHECK_EQUAL( header.lines(), mapped.lines() );
+  BOOST_REQUIRE_EQUAL( streamed.num_gates(), mapped.num_gates() );
+  for ( auto i = 0u; i < mapped.num_gates(); ++i )
+  {
+    BOOST_CHECK( streamed[i].controls() == mapped[i].controls() );
+    BOOST_CHECK( streamed[i].targets() == mapped[i].targets() );
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
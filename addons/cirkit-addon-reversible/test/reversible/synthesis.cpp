@@ -27,7 +27,9 @@
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE truth_table
 
+#include <algorithm>
 #include <cmath>
+#include <random>
 #include <vector>
 
 #include <boost/assign/std/vector.hpp>
@@ -43,6 +45,7 @@
 #include <reversible/synthesis/reed_muller_synthesis.hpp>
 #include <reversible/synthesis/transformation_based_synthesis.hpp>
 #include <reversible/synthesis/transposition_based_synthesis.hpp>
+#include <reversible/utils/permutation.hpp>
 
 using namespace cirkit;
 
@@ -97,6 +100,29 @@ BOOST_AUTO_TEST_CASE(simple)
   }
 }
 
+BOOST_AUTO_TEST_CASE(packed_permutation)
+{
+  std::mt19937 gen( 42 );
+
+  permutation_t permutation( 1u << 10u );
+  for ( auto i = 0u; i < permutation.size(); ++i )
+  {
+    permutation[i] = i;
+  }
+  std::shuffle( permutation.begin(), permutation.end(), gen );
+
+  for ( auto fredkin : {false, true} )
+  {
+    auto settings = std::make_shared<properties>();
+    settings->set( "fredkin", fredkin );
+    settings->set( "num_threads", 2u );
+
+    circuit circ;
+    BOOST_CHECK( transformation_based_synthesis( circ, permutation, settings ) );
+    BOOST_CHECK( circuit_to_permutation( circ ) == permutation );
+  }
+}
+
 // Local Variables:
 // c-basic-offset: 2
 // eval: (c-set-offset 'substatement-open 0)
@@ -0,0 +1,305 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE transformation_based_synthesis
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <core/properties.hpp>
+#include <reversible/circuit.hpp>
+#include <reversible/truth_table.hpp>
+#include <reversible/functions/add_gates.hpp>
+#include <reversible/synthesis/transformation_based_synthesis.hpp>
+#include <reversible/utils/permutation.hpp>
+
+using namespace cirkit;
+
+using row_t = std::pair<unsigned, unsigned>;
+using gate_list_t = std::vector<std::pair<std::vector<unsigned>, std::vector<unsigned>>>;
+
+/* the original algorithm, which updates every row of the truth table for each
+ * gate and sorts it again after gates in front direction */
+class reference_tbs
+{
+public:
+  reference_tbs( const permutation_t& perm, unsigned bw )
+    : circ( bw )
+  {
+    for ( auto i = 0u; i < perm.size(); ++i )
+    {
+      tt.push_back( {i, perm[i]} );
+    }
+  }
+
+  circuit run( bool bidirectional, bool fredkin, bool fredkin_lookback )
+  {
+    if ( !bidirectional )
+    {
+      for ( auto b = 0u; b < circ.lines(); ++b )
+      {
+        if ( ( tt[0u].second >> b ) & 1u )
+        {
+          add_gate( 0u, b, b, false );
+        }
+      }
+    }
+
+    for ( auto i = bidirectional ? 0u : 1u; i < tt.size(); ++i )
+    {
+      if ( tt[i].first == tt[i].second ) { continue; }
+
+      auto front = false;
+      auto index = i;
+      if ( bidirectional )
+      {
+        const auto other = std::find_if( tt.begin(), tt.end(), [&]( const row_t& r ) { return r.second == tt[i].first; } ) - tt.begin();
+        if ( distance( tt[other] ) < distance( tt[i] ) )
+        {
+          front = true;
+          index = other;
+        }
+      }
+      adjust_line( index, front, fredkin, fredkin_lookback );
+    }
+
+    return circ;
+  }
+
+private:
+  static unsigned distance( const row_t& r )
+  {
+    return __builtin_popcount( r.first ^ r.second );
+  }
+
+  void add_gate( unsigned controls, unsigned t1, unsigned t2, bool front )
+  {
+    const auto n = circ.lines();
+
+    gate::control_container cs;
+    for ( auto b = 0u; b < n; ++b )
+    {
+      if ( ( controls >> b ) & 1u ) { cs.push_back( make_var( n - 1u - b ) ); }
+    }
+    if ( t1 == t2 )
+    {
+      insert_toffoli( circ, pos, cs, n - 1u - t1 );
+    }
+    else
+    {
+      insert_fredkin( circ, pos, cs, n - 1u - t1, n - 1u - t2 );
+    }
+
+    for ( auto& r : tt )
+    {
+      auto& bits = front ? r.first : r.second;
+      if ( ( bits & controls ) != controls ) { continue; }
+      if ( t1 == t2 )
+      {
+        bits ^= 1u << t1;
+      }
+      else if ( ( ( bits >> t1 ) ^ ( bits >> t2 ) ) & 1u )
+      {
+        bits ^= ( 1u << t1 ) | ( 1u << t2 );
+      }
+    }
+
+    if ( front )
+    {
+      ++pos;
+      std::sort( tt.begin(), tt.end() );
+    }
+  }
+
+  void adjust_line( unsigned line, bool front, bool fredkin, bool fredkin_lookback )
+  {
+    const auto input = tt[line].first, output = tt[line].second;
+    auto p = ( input ^ output ) & ( front ? output : input );
+    auto q = ( input ^ output ) & ( front ? input : output );
+    auto mask = front ? input : output;
+    const auto mask_compare = front ? output : input;
+
+    auto found = fredkin;
+    while ( found )
+    {
+      found = false;
+      for ( auto b1 = 0u; b1 < 32u && !found; ++b1 )
+      {
+        if ( !( ( p >> b1 ) & 1u ) ) { continue; }
+        for ( auto b2 = 0u; b2 < 32u && !found; ++b2 )
+        {
+          if ( !( ( q >> b2 ) & 1u ) ) { continue; }
+
+          const auto mask_copy = mask & ~( 1u << b1 ) & ~( 1u << b2 );
+          auto valid = mask_copy > mask_compare;
+          if ( !valid && fredkin_lookback )
+          {
+            valid = true;
+            auto current = 0u;
+            do
+            {
+              if ( ( mask_copy & current ) == mask_copy && ( ( ( current >> b1 ) ^ ( current >> b2 ) ) & 1u ) )
+              {
+                valid = false;
+                break;
+              }
+              current = ( current + 1u ) % tt.size();
+            } while ( current != mask_compare );
+          }
+
+          if ( valid )
+          {
+            add_gate( mask_copy, b1, b2, front );
+            p &= ~( 1u << b1 );
+            q &= ~( 1u << b2 );
+            mask = ( mask | ( 1u << b1 ) ) & ~( 1u << b2 );
+            found = true;
+          }
+        }
+      }
+    }
+
+    for ( auto b = 0u; b < 32u; ++b )
+    {
+      if ( ( p >> b ) & 1u )
+      {
+        add_gate( mask, b, b, front );
+        mask |= 1u << b;
+      }
+    }
+    for ( auto b = 0u; b < 32u; ++b )
+    {
+      if ( ( q >> b ) & 1u )
+      {
+        mask &= ~( 1u << b );
+        add_gate( mask, b, b, front );
+      }
+    }
+  }
+
+  circuit            circ;
+  std::vector<row_t> tt;
+  unsigned           pos = 0u;
+};
+
+gate_list_t gate_list( const circuit& circ )
+{
+  gate_list_t list;
+  for ( const auto& g : circ )
+  {
+    std::vector<unsigned> controls;
+    for ( const auto& c : g.controls() )
+    {
+      controls.push_back( c.line() );
+    }
+    std::sort( controls.begin(), controls.end() );
+    list.push_back( {controls, std::vector<unsigned>( g.targets().begin(), g.targets().end() )} );
+  }
+  return list;
+}
+
+permutation_t random_permutation( unsigned bw, std::mt19937& gen )
+{
+  permutation_t perm( 1u << bw );
+  std::iota( perm.begin(), perm.end(), 0u );
+  std::shuffle( perm.begin(), perm.end(), gen );
+  return perm;
+}
+
+BOOST_AUTO_TEST_CASE(same_as_reference)
+{
+  std::mt19937 gen( 42 );
+
+  for ( auto bw = 2u; bw <= 6u; ++bw )
+  {
+    for ( auto k = 0u; k < 10u; ++k )
+    {
+      const auto perm = random_permutation( bw, gen );
+
+      for ( auto mode = 0u; mode < 6u; ++mode )
+      {
+        const auto bidirectional = ( mode & 1u ) != 0u;
+        const auto fredkin = mode >= 2u;
+        const auto fredkin_lookback = mode >= 4u;
+
+        auto settings = std::make_shared<properties>();
+        settings->set( "bidirectional", bidirectional );
+        settings->set( "fredkin", fredkin );
+        settings->set( "fredkin_lookback", fredkin_lookback );
+        settings->set( "num_threads", 1u );
+
+        circuit circ;
+        BOOST_REQUIRE( transformation_based_synthesis( circ, perm, settings ) );
+        BOOST_CHECK( gate_list( circ ) == gate_list( reference_tbs( perm, bw ).run( bidirectional, fredkin, fredkin_lookback ) ) );
+        BOOST_CHECK( circuit_to_permutation( circ ) == perm );
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(shuffled_spec)
+{
+  std::mt19937 gen( 7 );
+
+  const auto bw = 4u;
+  const auto perm = random_permutation( bw, gen );
+
+  std::vector<unsigned> rows( perm.size() );
+  std::iota( rows.begin(), rows.end(), 0u );
+  std::shuffle( rows.begin(), rows.end(), gen );
+
+  binary_truth_table spec;
+  for ( auto i : rows )
+  {
+    spec.add_entry( number_to_truth_table_cube( i, bw ), number_to_truth_table_cube( perm[i], bw ) );
+  }
+
+  circuit circ;
+  BOOST_REQUIRE( transformation_based_synthesis( circ, spec ) );
+  BOOST_CHECK( circuit_to_permutation( circ ) == perm );
+}
+
+BOOST_AUTO_TEST_CASE(invalid_permutation)
+{
+  circuit circ;
+
+  auto statistics = std::make_shared<properties>();
+  BOOST_CHECK( !transformation_based_synthesis( circ, permutation_t{0u, 1u, 1u, 3u}, properties::ptr(), statistics ) );
+  BOOST_CHECK( !transformation_based_synthesis( circ, permutation_t{0u, 1u, 2u, 4u}, properties::ptr(), statistics ) );
+  BOOST_CHECK( transformation_based_synthesis( circ, permutation_t{3u, 1u, 2u, 0u}, properties::ptr(), statistics ) );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
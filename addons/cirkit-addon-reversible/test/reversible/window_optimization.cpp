@@ -0,0 +1,109 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE window_optimization
+
+#include <random>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <core/properties.hpp>
+#include <reversible/circuit.hpp>
+#include <reversible/functions/add_gates.hpp>
+#include <reversible/optimization/window_optimization.hpp>
+#include <reversible/utils/costs.hpp>
+#include <reversible/utils/permutation.hpp>
+
+#include "random_circuit.h"
+
+BOOST_AUTO_TEST_CASE(simple)
+{
+  using namespace cirkit;
+
+  const auto lines = 8u;
+
+  std::mt19937 gen( 3 );
+  const auto gates = test::random_circuit( lines, 200u, gen, 0.2 );
+
+  /* random gates, some of them duplicated */
+  circuit circ( lines );
+  for ( const auto& g : gates )
+  {
+    append_toffoli( circ, g.controls(), g.targets().front() );
+    if ( gen() % 5u == 0u )
+    {
+      append_toffoli( circ, g.controls(), g.targets().front() );
+    }
+  }
+
+  std::vector<unsigned> num_gates;
+  for ( auto num_threads : {1u, 4u} )
+  {
+    auto settings = std::make_shared<properties>();
+    settings->set( "num_threads", num_threads );
+
+    circuit opt;
+    BOOST_CHECK( parallel_window_optimization( opt, circ, settings ) );
+    BOOST_CHECK( opt.num_gates() < circ.num_gates() );
+    BOOST_CHECK( circuit_to_permutation( opt ) == circuit_to_permutation( circ ) );
+
+    num_gates.push_back( opt.num_gates() );
+  }
+
+  BOOST_CHECK( num_gates[0u] == num_gates[1u] );
+}
+
+BOOST_AUTO_TEST_CASE(memoized_costs)
+{
+  using namespace cirkit;
+
+  std::mt19937 gen( 5 );
+  const auto circ = test::random_circuit( 6u, 300u, gen, 0.3 );
+
+  std::vector<circuit> opts;
+  for ( auto memoize_costs : {false, true} )
+  {
+    auto settings = std::make_shared<properties>();
+    settings->set( "cost_function", cost_function( costs_by_gate_func( transistor_costs() ) ) );
+    settings->set( "memoize_costs", memoize_costs );
+    settings->set( "num_threads", 1u );
+
+    circuit opt;
+    BOOST_CHECK( parallel_window_optimization( opt, circ, settings ) );
+    BOOST_CHECK( circuit_to_permutation( opt ) == circuit_to_permutation( circ ) );
+    opts.push_back( opt );
+  }
+
+  BOOST_CHECK_EQUAL( costs( opts[0u], costs_by_gate_func( transistor_costs() ) ), costs( opts[1u], costs_by_gate_func( transistor_costs() ) ) );
+  BOOST_CHECK_EQUAL( opts[0u].num_gates(), opts[1u].num_gates() );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -32,18 +32,28 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <functional>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <regex>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
 #include <sys/wait.h>
 #include <unistd.h>
 
 #include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/replace.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/filesystem.hpp>
@@ -58,6 +68,7 @@
 #include <alice/commands/current.hpp>
 #include <alice/commands/help.hpp>
 #include <alice/commands/print.hpp>
+#include <alice/commands/profile.hpp>
 #include <alice/commands/ps.hpp>
 #include <alice/commands/quit.hpp>
 #include <alice/commands/read_io.hpp>
@@ -181,6 +192,8 @@ template<class... S>
 class cli_main
 {
 public:
+  using command_factory = std::function<std::shared_ptr<alice::command>( const environment::ptr& )>;
+
   cli_main( const std::string& prefix )
     : env( std::make_shared<environment>() ),
       prefix( prefix )
@@ -198,16 +211,17 @@ public:
      * see store.hpp for more details
      */
     set_category( "General" );
-    insert_command( "alias",   std::make_shared<alias_command>( env ) );
-    insert_command( "convert", std::make_shared<convert_command<S...>>( env ) );
-    insert_command( "current", std::make_shared<current_command<S...>>( env ) );
-    insert_command( "help",    std::make_shared<help_command>( env ) );
-    insert_command( "print",   std::make_shared<print_command<S...>>( env ) );
-    insert_command( "ps",      std::make_shared<ps_command<S...>>( env ) );
-    insert_command( "quit",    std::make_shared<quit_command>( env ) );
-    insert_command( "set",     std::make_shared<set_command>( env ) );
-    insert_command( "show",    std::make_shared<show_command<S...>>( env ) );
-    insert_command( "store",   std::make_shared<store_command<S...>>( env ) );
+    insert_command( "alias",   make_factory<alias_command>() );
+    insert_command( "convert", make_factory<convert_command<S...>>() );
+    insert_command( "current", make_factory<current_command<S...>>() );
+    insert_command( "help",    make_factory<help_command>() );
+    insert_command( "print",   make_factory<print_command<S...>>() );
+    insert_command( "profile", make_factory<profile_command>() );
+    insert_command( "ps",      make_factory<ps_command<S...>>() );
+    insert_command( "quit",    make_factory<quit_command>() );
+    insert_command( "set",     make_factory<set_command>() );
+    insert_command( "show",    make_factory<show_command<S...>>() );
+    insert_command( "store",   make_factory<store_command<S...>>() );
 
     opts.add_options()
       ( "command,c",     po::value( &command ), "process semicolon-separated list of commands" )
@@ -216,6 +230,9 @@ public:
       ( "counter,n",                            "show a counter in the prefix" )
       ( "interactive,i",                        "continue in interactive mode after processing commands (in command or file mode)" )
       ( "log,l",         po::value( &logname ), "logs the execution and stores many statistical information" )
+      ( "profile,p",     po::value( &profilename ), "writes a profile record for each command to a JSON Lines file" )
+      ( "batch,b",       po::value( &batchname ), "runs the commands (command or file mode) for each design listed in this file,\n{} and {.} are replaced by the design's path with and without extension" )
+      ( "jobs,j",        po::value( &jobs )->default_value( jobs ), "number of designs processed in parallel in batch mode (0: all cores),\ncommands must be thread-safe if greater than 1" )
       ( "help,h",                               "produce help message" )
       ;
   }
@@ -225,22 +242,36 @@ public:
     category = _category;
   }
 
+  /* inserts a command instance, which is not available in batch mode */
   void insert_command( const std::string& name, const std::shared_ptr<command>& cmd )
   {
     env->categories[category].push_back( name );
     env->commands[name] = cmd;
   }
 
+  /* inserts a command through a factory such that each environment gets its own instance */
+  void insert_command( const std::string& name, const command_factory& factory )
+  {
+    factories.emplace_back( category, name, factory );
+    insert_command( name, factory( env ) );
+  }
+
+  template<typename Cmd>
+  static command_factory make_factory()
+  {
+    return []( const environment::ptr& env ) -> std::shared_ptr<alice::command> { return std::make_shared<Cmd>( env ); };
+  }
+
   template<typename Tag>
   void insert_read_command( const std::string& name, const std::string& label )
   {
-    insert_command( name, std::make_shared<read_io_command<Tag, S...>>( env, label ) );
+    insert_command( name, [label]( const environment::ptr& env ) -> std::shared_ptr<alice::command> { return std::make_shared<read_io_command<Tag, S...>>( env, label ); } );
   }
 
   template<typename Tag>
   void insert_write_command( const std::string& name, const std::string& label )
   {
-    insert_command( name, std::make_shared<write_io_command<Tag, S...>>( env, label ) );
+    insert_command( name, [label]( const environment::ptr& env ) -> std::shared_ptr<alice::command> { return std::make_shared<write_io_command<Tag, S...>>( env, label ); } );
   }
 
   int run( int argc, char ** argv )
@@ -256,12 +287,22 @@ public:
 
     read_aliases();
 
+    if ( vm.count( "batch" ) )
+    {
+      return run_batch();
+    }
+
     if ( vm.count( "log" ) )
     {
       env->log = true;
       env->start_logging( logname );
     }
 
+    if ( vm.count( "profile" ) )
+    {
+      env->start_profiling( profilename );
+    }
+
     if ( vm.count( "command" ) )
     {
       std::vector<std::string> split;
@@ -340,6 +381,21 @@ public:
 
 private:
   bool execute_line( const std::string& line )
+  {
+    return execute_line( env, line );
+  }
+
+  bool process_file( const std::string& filename, bool echo )
+  {
+    return process_file( env, filename, echo );
+  }
+
+  std::string preprocess_alias( const std::string& line )
+  {
+    return preprocess_alias( env, line );
+  }
+
+  bool execute_line( const environment::ptr& cenv, const std::string& line )
   {
     /* ignore comments and empty lines */
     if ( line.empty() || line[0] == '#' ) { return false; }
@@ -353,7 +409,7 @@ private:
 
       for ( const auto& cline : lines )
       {
-        result = result && execute_line( preprocess_alias( cline ) );
+        result = result && execute_line( cenv, preprocess_alias( cenv, cline ) );
       }
 
       return result;
@@ -372,12 +428,12 @@ private:
         std::cout << '%' << std::endl;
       }
 
-      if ( env->log )
+      if ( cenv->log )
       {
         command::log_map_t log;
         log["status"] = result.first;
         log["output"] = result.second;
-        env->log_command( command::log_opt_t( log ), line, now );
+        cenv->log_command( command::log_opt_t( log ), line, now );
       }
 
       return true;
@@ -388,7 +444,7 @@ private:
     {
       auto filename = line.substr( 1u );
       boost::trim( filename );
-      process_file( filename, vm.count( "echo" ) );
+      process_file( cenv, filename, vm.count( "echo" ) );
       return true;
     }
 
@@ -403,17 +459,25 @@ private:
       }
     }
 
-    const auto it = env->commands.find( vline.front() );
-    if ( it != env->commands.end() )
+    const auto it = cenv->commands.find( vline.front() );
+    if ( it != cenv->commands.end() )
     {
       const auto now = std::chrono::system_clock::now();
+      const auto snapshot = cenv->take_profile_snapshot();
       const auto result = it->second->run( vline );
 
-      if ( result && env->log )
+      if ( result && cenv->log )
       {
-        env->log_command( it->second, line, now );
+        cenv->log_command( it->second, line, now );
       }
 
+      if ( it->first != "profile" )
+      {
+        cenv->profile_command( it->second, it->first, line, result, snapshot );
+      }
+
+      cenv->enforce_memory_limits();
+
       return result;
     }
     else
@@ -424,12 +488,13 @@ private:
   }
 
   /**
+   * @param cenv     environment in which the commands are executed
    * @param filename filename with commands
    * @param echo     true, if command should be echoed before execution
    *
    * @return true, if program should exit after this call
    */
-  bool process_file( const std::string& filename, bool echo )
+  bool process_file( const environment::ptr& cenv, const std::string& filename, bool echo )
   {
     std::ifstream in( filename.c_str(), std::ifstream::in );
 
@@ -450,9 +515,9 @@ private:
         std::cout << get_prefix() << line << std::endl;
       }
 
-      execute_line( preprocess_alias( line ) );
+      execute_line( cenv, preprocess_alias( cenv, line ) );
 
-      if ( env->quit )
+      if ( cenv->quit )
       {
         /* quit */
         return true;
@@ -486,11 +551,11 @@ private:
     }
   }
 
-  std::string preprocess_alias( const std::string& line )
+  std::string preprocess_alias( const environment::ptr& cenv, const std::string& line )
   {
     std::smatch m;
 
-    for ( const auto& p : env->aliases )
+    for ( const auto& p : cenv->aliases )
     {
       if ( std::regex_match( line, m, std::regex( p.first ) ) )
       {
@@ -503,13 +568,205 @@ private:
 
         auto str = fmt.str();
         boost::trim( str );
-        return preprocess_alias( str );
+        return preprocess_alias( cenv, str );
       }
     }
 
     return line;
   }
 
+  /* new environment with all stores and all commands inserted through factories */
+  environment::ptr make_environment() const
+  {
+    const auto benv = std::make_shared<environment>();
+    [](...){}( add_store_helper<S>( benv )... );
+
+    for ( const auto& f : factories )
+    {
+      benv->categories[std::get<0>( f )].push_back( std::get<1>( f ) );
+      benv->commands[std::get<1>( f )] = std::get<2>( f )( benv );
+    }
+
+    benv->aliases   = env->aliases;
+    benv->variables = env->variables;
+
+    return benv;
+  }
+
+  struct batch_result
+  {
+    std::string design;
+    bool        status = true;
+    double      wall = 0.0;
+    std::string log;
+    std::deque<profile_record> profile;
+  };
+
+  /* runs the script on one design in its own environment */
+  batch_result run_design( const std::string& design, const std::vector<std::string>& script )
+  {
+    batch_result result;
+    result.design = design;
+
+    const auto benv = make_environment();
+    benv->variables["design"] = design;
+    benv->max_profile_records = 0u; /* all records are written after the batch */
+
+    const auto log = std::make_shared<std::ostringstream>();
+    benv->log = true;
+    benv->start_logging( log );
+
+    const auto stem = boost::filesystem::path( design ).replace_extension().string();
+    const auto start = std::chrono::steady_clock::now();
+
+    for ( auto line : script )
+    {
+      boost::replace_all( line, "{.}", stem );
+      boost::replace_all( line, "{}", design );
+
+      if ( !execute_line( benv, preprocess_alias( benv, line ) ) )
+      {
+        result.status = false;
+        break;
+      }
+
+      if ( benv->quit ) { break; }
+    }
+
+    result.wall = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+
+    benv->stop_logging();
+    result.log = log->str();
+
+    result.profile = benv->profile_records;
+    for ( auto& r : result.profile )
+    {
+      r.design = design;
+    }
+
+    return result;
+  }
+
+  /* runs the command or file script for each design on a worker pool */
+  int run_batch()
+  {
+    std::vector<std::string> designs;
+    {
+      std::ifstream in( batchname.c_str(), std::ifstream::in );
+      if ( !in.good() )
+      {
+        std::cout << "[e] file " << batchname << " not found" << std::endl;
+        return 1;
+      }
+
+      std::string line;
+      while ( getline( in, line ) )
+      {
+        boost::trim( line );
+        if ( !line.empty() && line[0] != '#' )
+        {
+          designs.push_back( line );
+        }
+      }
+    }
+
+    std::vector<std::string> script;
+    if ( vm.count( "command" ) )
+    {
+      script.push_back( command );
+    }
+    else if ( vm.count( "file" ) )
+    {
+      std::ifstream in( file.c_str(), std::ifstream::in );
+      if ( !in.good() )
+      {
+        std::cout << "[e] file " << file << " not found" << std::endl;
+        return 1;
+      }
+
+      std::string line;
+      while ( getline( in, line ) )
+      {
+        boost::trim( line );
+        if ( !line.empty() && line[0] != '#' )
+        {
+          script.push_back( line );
+        }
+      }
+    }
+    else
+    {
+      std::cout << "[e] batch mode requires command or file mode" << std::endl;
+      return 1;
+    }
+
+    std::vector<batch_result> results( designs.size() );
+    std::atomic<unsigned> next( 0u );
+
+    const auto worker = [&]() {
+      for ( auto i = next++; i < designs.size(); i = next++ )
+      {
+        results[i] = run_design( designs[i], script );
+      }
+    };
+
+    const auto num_threads = std::min<unsigned>( designs.size(), jobs ? jobs : std::max( 1u, std::thread::hardware_concurrency() ) );
+    std::vector<std::thread> threads;
+    for ( auto i = 1u; i < num_threads; ++i )
+    {
+      threads.emplace_back( worker );
+    }
+    worker();
+    for ( auto& t : threads )
+    {
+      t.join();
+    }
+
+    auto failed = 0u;
+    for ( const auto& r : results )
+    {
+      if ( !r.status ) { ++failed; }
+    }
+
+    if ( vm.count( "log" ) )
+    {
+      std::ofstream os( logname.c_str(), std::ofstream::out );
+      os << "[";
+      for ( auto i = 0u; i < results.size(); ++i )
+      {
+        const auto& r = results[i];
+        os << ( i ? ",\n" : "\n" )
+           << boost::format( "{\"design\": \"%s\", \"status\": %s, \"wall\": %.6f,\n\"commands\": %s,\n\"profile\": [" )
+              % detail::json_escape( r.design ) % ( r.status ? "true" : "false" ) % r.wall % r.log;
+        for ( auto j = 0u; j < r.profile.size(); ++j )
+        {
+          os << ( j ? ",\n" : "" );
+          environment::write_profile_record( os, r.profile[j] );
+        }
+        os << "]}";
+      }
+      os << "\n]" << std::endl;
+    }
+
+    /* records of all designs in list order, each one tagged with its design */
+    if ( vm.count( "profile" ) )
+    {
+      std::ofstream os( profilename.c_str(), std::ofstream::out );
+      for ( const auto& r : results )
+      {
+        for ( const auto& rec : r.profile )
+        {
+          environment::write_profile_record( os, rec );
+          os << std::endl;
+        }
+      }
+    }
+
+    std::cout << boost::format( "[i] processed %d designs, %d failed" ) % results.size() % failed << std::endl;
+
+    return failed ? 1 : 0;
+  }
+
 private:
   std::string             prefix;
 
@@ -520,6 +777,11 @@ private:
   std::string             command;
   std::string             file;
   std::string             logname;
+  std::string             profilename;
+  std::string             batchname;
+  unsigned                jobs = 1u;
+
+  std::vector<std::tuple<std::string, std::string, command_factory>> factories;
 
   unsigned                counter = 1u;
 };
@@ -527,7 +789,7 @@ private:
 #define ALICE_S(x) #x
 #define ALICE_SX(x) ALICE_S(x)
 
-#define ADD_COMMAND( name ) cli.insert_command( #name, std::make_shared<name##_command>( cli.env ) );
+#define ADD_COMMAND( name ) cli.insert_command( #name, cli.make_factory<name##_command>() );
 #define ADD_READ_COMMAND( name, label ) cli.insert_read_command<io_##name##_tag_t>( "read_" ALICE_SX(name), label );
 #define ADD_WRITE_COMMAND( name, label ) cli.insert_write_command<io_##name##_tag_t>( "write_" ALICE_SX(name), label );
 
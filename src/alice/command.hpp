@@ -32,18 +32,26 @@
 
 #pragma once
 
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
 #include <cstring>
 #include <ctime>
+#include <deque>
 #include <iomanip>
 #include <iostream>
 #include <fstream>
 #include <functional>
 #include <locale>
+#include <map>
+#include <memory>
+#include <set>
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
+#include <sys/resource.h>
 
 #include <boost/format.hpp>
 #include <boost/optional.hpp>
@@ -106,6 +114,16 @@ public:
     os << i;
   }
 
+  void operator()( unsigned long i ) const
+  {
+    os << i;
+  }
+
+  void operator()( unsigned long long i ) const
+  {
+    os << i;
+  }
+
   void operator()( double d ) const
   {
     os << d;
@@ -156,29 +174,141 @@ inline std::string make_caption( const std::string& caption, const std::string&
   return c;
 }
 
-using log_var_t = boost::variant<std::string, int, unsigned, double, bool, std::vector<std::string>, std::vector<int>, std::vector<unsigned>, std::vector<std::vector<int>>, std::vector<std::vector<unsigned>>>;
+using log_var_t = boost::variant<std::string, int, unsigned, unsigned long, unsigned long long, double, bool, std::vector<std::string>, std::vector<int>, std::vector<unsigned>, std::vector<double>, std::vector<std::vector<int>>, std::vector<std::vector<unsigned>>>;
 using log_map_t = std::unordered_map<std::string, log_var_t>;
 using log_opt_t = boost::optional<log_map_t>;
 
+/* writes a log map as a single-line JSON object with sorted keys */
+inline void write_log_map( std::ostream& os, const log_map_t& map )
+{
+  std::map<std::string, const log_var_t*> sorted;
+  for ( const auto& p : map )
+  {
+    sorted[p.first] = &p.second;
+  }
+
+  log_var_visitor vis( os );
+
+  os << "{";
+  auto first = true;
+  for ( const auto& p : sorted )
+  {
+    os << ( first ? "" : ", " ) << "\"" << json_escape( p.first ) << "\": ";
+    boost::apply_visitor( vis, *p.second );
+    first = false;
+  }
+  os << "}";
+}
+
+/* wall time, CPU time (user and system) and peak RSS (in KB) of the process */
+struct resource_usage
+{
+  static resource_usage now()
+  {
+    resource_usage usage;
+    usage.wall = std::chrono::steady_clock::now();
+
+    rusage ru;
+    getrusage( RUSAGE_SELF, &ru );
+    usage.cpu = ru.ru_utime.tv_sec + ru.ru_stime.tv_sec + ( ru.ru_utime.tv_usec + ru.ru_stime.tv_usec ) / 1.0e6;
+    usage.max_rss = ru.ru_maxrss;
+
+    return usage;
+  }
+
+  std::chrono::steady_clock::time_point wall;
+  double                                cpu = 0.0;
+  long                                  max_rss = 0;
+};
+
 }
 
+/******************************************************************************
+ * profiling                                                                  *
+ ******************************************************************************/
+
+/* one executed command as recorded by the profiler */
+struct profile_record
+{
+  std::string                        design; /* only set in batch mode */
+  std::string                        command;
+  std::string                        name;
+  bool                               status = true;
+  double                             wall = 0.0;
+  double                             cpu = 0.0;
+  long                               rss_delta = 0;
+  std::map<std::string, std::size_t> stores_before;
+  std::map<std::string, std::size_t> stores_after;
+  detail::log_opt_t                  statistics;
+};
+
+/* state of the process and stores before a command is executed */
+struct profile_snapshot
+{
+  detail::resource_usage             usage;
+  std::map<std::string, std::size_t> store_sizes;
+};
+
 /******************************************************************************
  * cli_store                                                                  *
  ******************************************************************************/
 
+/* customization points for memory accounting and spilling, see below */
+template<typename T>
+std::size_t store_entry_memory( const T& element );
+
+template<typename T>
+bool store_can_spill();
+
+template<typename T>
+void store_write_spill( std::ostream& os, const T& element );
+
+template<typename T>
+T store_read_spill( std::istream& is );
+
+/* type-independent part of a store */
+class cli_store_base
+{
+public:
+  virtual ~cli_store_base() {}
+
+  virtual std::size_t size() const = 0;
+
+  /* estimated memory in bytes of all entries in memory */
+  virtual std::size_t memory() const = 0;
+
+  /* spills least recently used entries until memory() is within the limit */
+  virtual void enforce_memory_limit() = 0;
+};
+
+/* Entries are held through shared handles, which are shared between
+ * entries after copy_current() and detached on the first write access
+ * (copy-on-write).  Reading through a const store never copies, write
+ * access is current_mutable() and modify(), and the non-const current()
+ * and operator[] are write access as well.  If a memory limit is set, the
+ * least recently used entries are written to a spill file and reloaded
+ * when accessed.  Slots in the spill file are reused when entries are
+ * spilled again. */
 template<class T>
-class cli_store
+class cli_store : public cli_store_base
 {
 public:
   explicit cli_store( const std::string& name ) : _name( name ) {}
 
-  inline T& current()
+  cli_store( const cli_store& ) = delete;
+  cli_store& operator=( const cli_store& ) = delete;
+
+  ~cli_store()
   {
-    if ( _current < 0 )
+    if ( _spill )
     {
-      throw boost::str( boost::format( "[e] no current %s available" ) % _name );
+      std::fclose( _spill );
     }
-    return _data[_current];
+  }
+
+  inline T& current()
+  {
+    return current_mutable();
   }
 
   inline const T& current() const
@@ -187,7 +317,7 @@ public:
     {
       throw boost::str( boost::format( "[e] no current %s available" ) % _name );
     }
-    return _data.at( _current );
+    return load( _current );
   }
 
   inline T& operator*()
@@ -202,25 +332,44 @@ public:
 
   inline T& operator[]( unsigned i )
   {
-    return _data[i];
+    return modify( i );
   }
 
   inline const T& operator[]( unsigned i ) const
   {
-    return _data.at( i );
+    return load( i );
   }
 
-  inline bool empty() const
+  /* write access, detaches the entry if it is shared */
+  inline T& current_mutable()
   {
-    return _data.empty();
+    if ( _current < 0 )
+    {
+      throw boost::str( boost::format( "[e] no current %s available" ) % _name );
+    }
+    return modify( _current );
+  }
+
+  T& modify( unsigned i )
+  {
+    load( i );
+
+    auto& e = _data[i];
+    if ( e.data.use_count() > 1 )
+    {
+      e.data = std::make_shared<T>( *e.data );
+    }
+    e.dirty = true; /* entry may be modified, its spill slot is rewritten on the next spill */
+
+    return *e.data;
   }
 
-  inline const std::vector<T>& data() const
+  inline bool empty() const
   {
-    return _data;
+    return _data.empty();
   }
 
-  inline typename std::vector<T>::size_type size() const
+  inline std::size_t size() const
   {
     return _data.size();
   }
@@ -237,24 +386,248 @@ public:
 
   void extend()
   {
-    const auto s = _data.size();
-    _data.resize( s + 1u );
-    _current = s;
-    current() = T();
+    _data.emplace_back();
+    _data.back().data = std::make_shared<T>();
+    _current = _data.size() - 1;
+    _data.back().last_access = ++_clock;
+  }
+
+  /* adds a new entry that shares the current one until either is modified */
+  void copy_current()
+  {
+    load( _current );
+    _data.push_back( _data.at( _current ) );
+    _data.back().offset = -1; /* the spill slot stays with the original entry */
+    _data.back().capacity = 0u;
+    _data.back().dirty = true;
+    _current = _data.size() - 1;
+    _data.back().last_access = ++_clock;
+  }
+
+  /* read-only handle, which stays valid when the entry is modified or spilled */
+  std::shared_ptr<const T> handle( unsigned i ) const
+  {
+    load( i );
+    return _data[i].data;
   }
 
   void clear()
   {
     _data.clear();
+    _free_slots.clear();
     _current = -1;
+
+    if ( _spill )
+    {
+      std::fclose( _spill );
+      _spill = nullptr;
+    }
+  }
+
+public: /* memory accounting */
+  inline bool is_spilled( unsigned i ) const
+  {
+    return !_data.at( i ).data;
+  }
+
+  /* estimated memory of an entry, for spilled entries at the time of spilling */
+  std::size_t entry_memory( unsigned i ) const
+  {
+    const auto& e = _data.at( i );
+    return e.data ? store_entry_memory<T>( *e.data ) : e.memory;
+  }
+
+  std::size_t memory() const
+  {
+    std::set<const T*> counted;
+    std::size_t total = 0u;
+
+    for ( const auto& e : _data )
+    {
+      if ( e.data && counted.insert( e.data.get() ).second )
+      {
+        total += store_entry_memory<T>( *e.data );
+      }
+    }
+
+    return total;
+  }
+
+  /* size of the spill file in bytes */
+  std::size_t spill_file_size() const
+  {
+    if ( !_spill ) { return 0u; }
+    std::fseek( _spill, 0, SEEK_END );
+    return std::ftell( _spill );
+  }
+
+  inline std::size_t memory_limit() const
+  {
+    return _memory_limit;
+  }
+
+  /* limit in bytes, 0 for no limit */
+  inline void set_memory_limit( std::size_t limit )
+  {
+    _memory_limit = limit;
+  }
+
+  void enforce_memory_limit()
+  {
+    if ( _memory_limit == 0u || !store_can_spill<T>() )
+    {
+      return;
+    }
+
+    auto total = memory();
+    if ( total <= _memory_limit )
+    {
+      return;
+    }
+
+    /* only entries that are not current and not shared can be spilled */
+    std::vector<unsigned> candidates;
+    for ( auto i = 0u; i < _data.size(); ++i )
+    {
+      if ( static_cast<int>( i ) != _current && _data[i].data && _data[i].data.use_count() == 1 )
+      {
+        candidates.push_back( i );
+      }
+    }
+    std::sort( candidates.begin(), candidates.end(), [this]( unsigned a, unsigned b ) { return _data[a].last_access < _data[b].last_access; } );
+
+    for ( auto i : candidates )
+    {
+      if ( total <= _memory_limit ) { break; }
+
+      const auto mem = store_entry_memory<T>( *_data[i].data );
+      spill( i );
+      total -= std::min( total, mem );
+    }
+  }
+
+private:
+  struct entry
+  {
+    std::shared_ptr<T> data;               /* empty if spilled */
+    long               offset = -1;        /* position of the slot in the spill file, -1 if none */
+    std::size_t        capacity = 0u;      /* size of the slot */
+    std::size_t        length = 0u;        /* bytes used in the slot */
+    bool               dirty = true;       /* data differs from the slot */
+    std::size_t        memory = 0u;        /* memory at time of spilling */
+    unsigned long      last_access = 0u;
+  };
+
+  const T& load( unsigned i ) const
+  {
+    auto& e = _data.at( i );
+
+    if ( !e.data )
+    {
+      std::string buffer( e.length, '\0' );
+      std::fseek( _spill, e.offset, SEEK_SET );
+      if ( std::fread( &buffer[0], 1, e.length, _spill ) != e.length )
+      {
+        throw boost::str( boost::format( "[e] cannot reload %s from spill file" ) % _name );
+      }
+
+      std::istringstream is( buffer );
+      e.data = std::make_shared<T>( store_read_spill<T>( is ) );
+    }
+
+    e.last_access = ++_clock;
+    return *e.data;
+  }
+
+  void spill( unsigned i )
+  {
+    auto& e = _data[i];
+
+    e.memory = store_entry_memory<T>( *e.data );
+
+    if ( e.dirty )
+    {
+      if ( !_spill && !( _spill = std::tmpfile() ) )
+      {
+        return;
+      }
+
+      std::ostringstream os;
+      store_write_spill<T>( os, *e.data );
+      const auto buffer = os.str();
+
+      /* a modified entry is rewritten into its old slot if it still fits,
+         otherwise the slot is released and the first free slot that fits
+         is taken, the file only grows if there is none */
+      if ( e.offset >= 0 && buffer.size() > e.capacity )
+      {
+        _free_slots.emplace_back( e.offset, e.capacity );
+        e.offset = -1;
+        e.capacity = 0u;
+      }
+
+      if ( e.offset < 0 )
+      {
+        const auto it = std::find_if( _free_slots.begin(), _free_slots.end(),
+                                      [&buffer]( const std::pair<long, std::size_t>& slot ) { return slot.second >= buffer.size(); } );
+        if ( it != _free_slots.end() )
+        {
+          e.offset = it->first;
+          e.capacity = it->second;
+          _free_slots.erase( it );
+        }
+        else
+        {
+          std::fseek( _spill, 0, SEEK_END );
+          e.offset = std::ftell( _spill );
+          e.capacity = buffer.size();
+        }
+      }
+
+      std::fseek( _spill, e.offset, SEEK_SET );
+      e.length = buffer.size();
+      if ( std::fwrite( buffer.data(), 1, buffer.size(), _spill ) != buffer.size() )
+      {
+        return;
+      }
+      e.dirty = false;
+    }
+
+    e.data.reset();
   }
 
 private:
-  std::string    _name;
-  std::vector<T> _data;
-  int            _current = -1;
+  std::string                _name;
+  mutable std::vector<entry> _data;
+  int                        _current = -1;
+
+  std::size_t                _memory_limit = 0u;
+  mutable unsigned long      _clock = 0u;
+  std::FILE*                 _spill = nullptr;
+  std::vector<std::pair<long, std::size_t>> _free_slots; /* released slots in the spill file */
 };
 
+template<typename T>
+void print_store_memory( std::ostream& os, const cli_store<T>& store )
+{
+  auto spilled = 0u;
+  for ( auto i = 0u; i < store.size(); ++i )
+  {
+    if ( store.is_spilled( i ) ) { ++spilled; }
+  }
+
+  os << boost::format( "[i] memory: %.1f KB in memory, %d entries spilled" ) % ( store.memory() / 1024.0 ) % spilled;
+  if ( spilled )
+  {
+    os << boost::format( " (spill file %.1f KB)" ) % ( store.spill_file_size() / 1024.0 );
+  }
+  if ( store.memory_limit() )
+  {
+    os << boost::format( ", limit %.1f MB" ) % ( store.memory_limit() / 1048576.0 );
+  }
+  os << std::endl;
+}
+
 template<typename T>
 struct store_info {};
 
@@ -272,7 +645,9 @@ public:
   template<typename T>
   void add_store( const std::string& key, const std::string& name )
   {
-    stores.insert( {key, std::make_shared<cli_store<T>>( name )} );
+    const auto store = std::make_shared<cli_store<T>>( name );
+    stores.insert( {key, store} );
+    store_bases.insert( {key, store} );
   }
 
   template<typename T>
@@ -292,8 +667,13 @@ public:
 public: /* logging */
   void start_logging( const std::string& filename )
   {
-    logger.open( filename.c_str(), std::ofstream::out );
-    logger << "[";
+    start_logging( std::make_shared<std::ofstream>( filename.c_str(), std::ofstream::out ) );
+  }
+
+  void start_logging( const std::shared_ptr<std::ostream>& os )
+  {
+    logger = os;
+    *logger << "[";
   }
 
   void log_command( const std::shared_ptr<command>& cmd, const std::string& cmdstring, const std::chrono::system_clock::time_point& start );
@@ -303,7 +683,7 @@ public: /* logging */
 
     if ( !log_first_command )
     {
-      logger << "," << std::endl;
+      *logger << "," << std::endl;
     }
     else
     {
@@ -311,29 +691,117 @@ public: /* logging */
     }
 
     const auto start_c = std::chrono::system_clock::to_time_t( start );
+    std::tm start_tm;
+    localtime_r( &start_c, &start_tm ); /* reentrant, environments may log concurrently in batch mode */
     char timestr[20];
-    std::strftime( timestr, sizeof( timestr ), "%F %T", std::localtime( &start_c ) );
-    logger << format( "{\n"
+    std::strftime( timestr, sizeof( timestr ), "%F %T", &start_tm );
+    *logger << format( "{\n"
                       "  \"command\": \"%s\",\n"
                       "  \"time\": \"%s\"" ) % detail::json_escape( cmdstring ) % timestr;
 
     if ( cmdlog != boost::none )
     {
-      detail::log_var_visitor vis( logger );
+      detail::log_var_visitor vis( *logger );
 
       for ( const auto& p : *cmdlog )
       {
-        logger << format( ",\n  \"%s\": " ) % p.first;
+        *logger << format( ",\n  \"%s\": " ) % p.first;
         boost::apply_visitor( vis, p.second );
       }
     }
 
-    logger << "\n}";
+    *logger << "\n}";
   }
 
   void stop_logging()
   {
-    logger << "]" << std::endl;
+    *logger << "]" << std::endl;
+  }
+
+public: /* profiling */
+  void start_profiling( const std::string& filename )
+  {
+    profiler.open( filename.c_str(), std::ofstream::out );
+  }
+
+  profile_snapshot take_profile_snapshot() const
+  {
+    profile_snapshot snapshot;
+    for ( const auto& p : store_bases )
+    {
+      snapshot.store_sizes[p.first] = p.second->size();
+    }
+    snapshot.usage = detail::resource_usage::now();
+    return snapshot;
+  }
+
+  void profile_command( const std::shared_ptr<command>& cmd, const std::string& name, const std::string& cmdstring, bool status, const profile_snapshot& before );
+  void profile_command( const detail::log_opt_t& statistics, const std::string& name, const std::string& cmdstring, bool status, const profile_snapshot& before )
+  {
+    const auto after = take_profile_snapshot();
+
+    profile_record record;
+    record.command       = cmdstring;
+    record.name          = name;
+    record.status        = status;
+    record.wall          = std::chrono::duration<double>( after.usage.wall - before.usage.wall ).count();
+    record.cpu           = after.usage.cpu - before.usage.cpu;
+    record.rss_delta     = after.usage.max_rss - before.usage.max_rss;
+    record.stores_before = before.store_sizes;
+    record.stores_after  = after.store_sizes;
+    record.statistics    = statistics;
+
+    if ( profiler.is_open() )
+    {
+      write_profile_record( profiler, record );
+      profiler << std::endl;
+    }
+
+    /* only the most recent records are kept in memory, the file gets all */
+    profile_records.push_back( record );
+    if ( max_profile_records != 0u && profile_records.size() > max_profile_records )
+    {
+      profile_records.erase( profile_records.begin(), profile_records.end() - max_profile_records );
+    }
+  }
+
+  /* writes a record as one line of JSON (JSON Lines format) */
+  static void write_profile_record( std::ostream& os, const profile_record& record )
+  {
+    const auto write_sizes = [&os]( const std::map<std::string, std::size_t>& sizes ) {
+      os << "{";
+      auto first = true;
+      for ( const auto& p : sizes )
+      {
+        os << ( first ? "" : ", " ) << "\"" << p.first << "\": " << p.second;
+        first = false;
+      }
+      os << "}";
+    };
+
+    os << "{";
+    if ( !record.design.empty() )
+    {
+      os << "\"design\": \"" << detail::json_escape( record.design ) << "\", ";
+    }
+    os << boost::format( "\"command\": \"%s\", \"name\": \"%s\", \"status\": %s, \"wall\": %.6f, \"cpu\": %.6f, \"rss_delta\": %d, \"stores_before\": " )
+      % detail::json_escape( record.command ) % detail::json_escape( record.name ) % ( record.status ? "true" : "false" )
+      % record.wall % record.cpu % record.rss_delta;
+    write_sizes( record.stores_before );
+    os << ", \"stores_after\": ";
+    write_sizes( record.stores_after );
+    os << ", \"statistics\": ";
+    detail::write_log_map( os, record.statistics ? *record.statistics : detail::log_map_t() );
+    os << "}";
+  }
+
+public: /* memory */
+  void enforce_memory_limits()
+  {
+    for ( const auto& p : store_bases )
+    {
+      p.second->enforce_memory_limit();
+    }
   }
 
 public: /* variables */
@@ -345,13 +813,18 @@ public: /* variables */
 
 public:
   std::map<std::string, boost::any>               stores;
+  std::map<std::string, std::shared_ptr<cli_store_base>> store_bases;
   std::map<std::string, std::shared_ptr<command>> commands;
   std::map<std::string, std::vector<std::string>> categories;
   std::map<std::string, std::string>              variables;
 
   bool                                            log = false;
   bool                                            log_first_command = true;
-  std::ofstream                                   logger;
+  std::shared_ptr<std::ostream>                   logger;
+
+  std::ofstream                                   profiler;
+  std::deque<profile_record>                      profile_records;
+  std::size_t                                     max_profile_records = 1000u; /* 0: unlimited */
 
   std::map<std::string, std::string>              aliases;
 
@@ -428,6 +901,9 @@ protected:
 public:
   virtual log_opt_t log() const { return boost::none; }
 
+  /* statistics of the last execution, recorded by the profiler */
+  virtual log_opt_t log_statistics() const { return boost::none; }
+
 protected:
   /* positional arguments */
   void add_positional_option( const std::string& option )
@@ -452,6 +928,11 @@ inline void environment::log_command( const std::shared_ptr<command>& cmd, const
   log_command( cmd->log(), cmdstring, start );
 }
 
+inline void environment::profile_command( const std::shared_ptr<command>& cmd, const std::string& name, const std::string& cmdstring, bool status, const profile_snapshot& before )
+{
+  profile_command( cmd->log_statistics(), name, cmdstring, status, before );
+}
+
 /******************************************************************************
  * customize stores                                                           *
  ******************************************************************************/
@@ -497,6 +978,33 @@ command::log_opt_t log_store_entry_statistics( const T& element )
   return boost::none;
 }
 
+/* estimated memory in bytes */
+template<typename T>
+std::size_t store_entry_memory( const T& element )
+{
+  return sizeof( T );
+}
+
+/* spilling requires store_write_spill and store_read_spill */
+template<typename T>
+bool store_can_spill()
+{
+  return false;
+}
+
+template<typename T>
+void store_write_spill( std::ostream& os, const T& element )
+{
+  assert( false );
+}
+
+template<typename T>
+T store_read_spill( std::istream& is )
+{
+  assert( false );
+  return T();
+}
+
 template<typename Source, typename Dest>
 bool store_can_convert()
 {
@@ -45,13 +45,15 @@ int print_helper( const command& cmd, const environment::ptr& env )
 
   if ( cmd.is_set( option ) )
   {
-    if ( env->store<S>().current_index() == -1 )
+    const auto& store = env->store<S>();
+
+    if ( store.current_index() == -1 )
     {
       std::cout << "[w] no " << name << " in store" << std::endl;
     }
     else
     {
-      print_store_entry<S>( std::cout, env->store<S>().current() );
+      print_store_entry<S>( std::cout, store.current() );
     }
   }
   return 0;
@@ -0,0 +1,312 @@
+/* alice: A C++ EDA command line interface API
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * @file profile.hpp
+ *
+ * @brief Summarize profiled commands
+ *
+ * @author agent
+ * @since  2.3
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <alice/command.hpp>
+#include <alice/rules.hpp>
+
+using namespace boost::program_options;
+
+namespace alice
+{
+
+class profile_command : public command
+{
+public:
+  profile_command( const environment::ptr& env )
+    : command( env, "Summarize run-time and memory of executed commands" )
+  {
+    opts.add_options()
+      ( "top,t",   value( &top )->default_value( top ), "number of hotspots to show" )
+      ( "all,a",                                         "show every recorded command" )
+      ( "write,w", value( &filename ),                   "write recorded commands to JSON Lines file" )
+      ( "read,r",  value( &readname ),                   "summarize the commands in a JSON Lines file instead of the recorded ones" )
+      ( "clear,c",                                       "clear recorded commands" )
+      ( "limit,l", value( &limit ),                      "number of recent commands to keep (0: unlimited)" )
+      ;
+  }
+
+protected:
+  rules_t validity_rules() const
+  {
+    return {file_exists_if_set( *this, readname, "read" )};
+  }
+
+  bool execute()
+  {
+    if ( is_set( "limit" ) )
+    {
+      env->max_profile_records = limit;
+      if ( limit != 0u && env->profile_records.size() > limit )
+      {
+        env->profile_records.erase( env->profile_records.begin(), env->profile_records.end() - limit );
+      }
+    }
+
+    std::deque<profile_record> file_records;
+    if ( is_set( "read" ) && !read_profile_records( readname, file_records ) )
+    {
+      return true;
+    }
+
+    const auto& records = is_set( "read" ) ? file_records : env->profile_records;
+
+    if ( is_set( "all" ) )
+    {
+      for ( const auto& r : records )
+      {
+        std::cout << boost::format( "[i] %8.2f secs %8.2f secs %8d KB  %s" ) % r.wall % r.cpu % r.rss_delta % r.command << std::endl;
+      }
+    }
+
+    if ( is_set( "write" ) )
+    {
+      std::ofstream os( filename.c_str(), std::ofstream::out );
+      for ( const auto& r : records )
+      {
+        environment::write_profile_record( os, r );
+        os << std::endl;
+      }
+    }
+
+    /* aggregate by command name */
+    std::map<std::string, hotspot> by_name;
+    total_wall = 0.0;
+
+    for ( const auto& r : records )
+    {
+      auto& h = by_name[r.name];
+      h.name = r.name;
+      ++h.calls;
+      h.wall += r.wall;
+      h.cpu += r.cpu;
+      h.rss_delta = std::max( h.rss_delta, r.rss_delta );
+      total_wall += r.wall;
+    }
+
+    hotspots.clear();
+    for ( const auto& p : by_name )
+    {
+      hotspots.push_back( p.second );
+    }
+    std::stable_sort( hotspots.begin(), hotspots.end(), []( const hotspot& a, const hotspot& b ) { return a.wall > b.wall; } );
+    if ( hotspots.size() > top )
+    {
+      hotspots.resize( top );
+    }
+
+    std::cout << boost::format( "[i] %d commands, %.2f secs in total" ) % records.size() % total_wall << std::endl;
+    std::cout << "[i]      command  calls   wall (secs)      %    cpu (secs)  max RSS delta (KB)" << std::endl;
+    for ( const auto& h : hotspots )
+    {
+      std::cout << boost::format( "[i] %12s %6d %13.2f %6.1f %13.2f %19d" )
+        % h.name % h.calls % h.wall % ( total_wall > 0.0 ? 100.0 * h.wall / total_wall : 0.0 ) % h.cpu % h.rss_delta << std::endl;
+    }
+
+    if ( is_set( "clear" ) )
+    {
+      env->profile_records.clear();
+    }
+
+    return true;
+  }
+
+public:
+  log_opt_t log() const
+  {
+    std::vector<std::string> names;
+    std::vector<unsigned> calls;
+
+    for ( const auto& h : hotspots )
+    {
+      names.push_back( h.name );
+      calls.push_back( h.calls );
+    }
+
+    return log_opt_t({
+        {"hotspots", names},
+        {"calls", calls},
+        {"total_wall", total_wall}
+      });
+  }
+
+private:
+  using ptree = boost::property_tree::ptree;
+
+  static bool read_profile_records( const std::string& name, std::deque<profile_record>& records )
+  {
+    std::ifstream in( name.c_str(), std::ifstream::in );
+    std::string line;
+    auto line_number = 0u;
+
+    while ( std::getline( in, line ) )
+    {
+      ++line_number;
+      if ( line.find_first_not_of( " \t\r" ) == std::string::npos ) { continue; }
+
+      profile_record record;
+      if ( !read_profile_record( line, record ) )
+      {
+        std::cout << boost::format( "[e] line %d of %s is not a profile record" ) % line_number % name << std::endl;
+        return false;
+      }
+      records.push_back( record );
+    }
+
+    return true;
+  }
+
+  /* reads a line as written by environment::write_profile_record */
+  static bool read_profile_record( const std::string& line, profile_record& record )
+  {
+    try
+    {
+      ptree pt;
+      std::istringstream is( line );
+      boost::property_tree::read_json( is, pt );
+
+      record.design    = pt.get<std::string>( "design", "" );
+      record.command   = pt.get<std::string>( "command" );
+      record.name      = pt.get<std::string>( "name" );
+      record.status    = pt.get<bool>( "status", true );
+      record.wall      = pt.get<double>( "wall" );
+      record.cpu       = pt.get<double>( "cpu", 0.0 );
+      record.rss_delta = pt.get<long>( "rss_delta", 0 );
+
+      for ( const auto& p : pt.get_child( "stores_before", ptree() ) )
+      {
+        record.stores_before[p.first] = p.second.get_value<std::size_t>();
+      }
+      for ( const auto& p : pt.get_child( "stores_after", ptree() ) )
+      {
+        record.stores_after[p.first] = p.second.get_value<std::size_t>();
+      }
+
+      log_map_t statistics;
+      for ( const auto& p : pt.get_child( "statistics", ptree() ) )
+      {
+        statistics[p.first] = read_log_value( p.second );
+      }
+      record.statistics = statistics;
+    }
+    catch ( const boost::property_tree::ptree_error& )
+    {
+      return false;
+    }
+
+    return true;
+  }
+
+  /* the parser keeps all values as strings, hence numbers and Booleans are
+   * recovered from their spelling and arrays of numbers become vectors */
+  static log_var_t read_log_value( const ptree& node )
+  {
+    if ( node.empty() )
+    {
+      const auto& s = node.data();
+      if ( s == "true" || s == "false" ) { return s == "true"; }
+
+      long i;
+      double d;
+      if ( parse_integer( s, i ) && i >= std::numeric_limits<int>::min() && i <= std::numeric_limits<int>::max() ) { return static_cast<int>( i ); }
+      if ( parse_double( s, d ) ) { return d; }
+      return s;
+    }
+
+    std::vector<std::string> strings;
+    std::vector<double>      numbers;
+    for ( const auto& c : node )
+    {
+      double d;
+      strings.push_back( c.second.data() );
+      if ( c.second.empty() && parse_double( c.second.data(), d ) ) { numbers.push_back( d ); }
+    }
+    if ( numbers.size() == strings.size() ) { return numbers; }
+    return strings;
+  }
+
+  static bool parse_integer( const std::string& s, long& value )
+  {
+    char* end;
+    value = std::strtol( s.c_str(), &end, 10 );
+    return !s.empty() && *end == '\0';
+  }
+
+  static bool parse_double( const std::string& s, double& value )
+  {
+    char* end;
+    value = std::strtod( s.c_str(), &end );
+    return !s.empty() && *end == '\0';
+  }
+
+  struct hotspot
+  {
+    std::string name;
+    unsigned    calls = 0u;
+    double      wall = 0.0;
+    double      cpu = 0.0;
+    long        rss_delta = 0;
+  };
+
+  unsigned             top = 10u;
+  std::string          filename;
+  std::string          readname;
+  unsigned             limit = 0u;
+
+  std::vector<hotspot> hotspots;
+  double               total_wall = 0.0;
+};
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
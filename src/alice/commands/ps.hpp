@@ -50,13 +50,17 @@ int ps_helper( const command& cmd, const environment::ptr& env )
 
   if ( cmd.is_set( option ) )
   {
-    if ( env->store<S>().current_index() == -1 )
+    const auto& store = env->store<S>();
+
+    if ( store.current_index() == -1 )
     {
       std::cout << "[w] no " << name << " in store" << std::endl;
     }
     else
     {
-      print_store_entry_statistics<S>( std::cout, env->store<S>().current() );
+      print_store_entry_statistics<S>( std::cout, store.current() );
+      std::cout << boost::format( "[i] entry memory: %.1f KB" ) % ( store.entry_memory( store.current_index() ) / 1024.0 ) << std::endl;
+      print_store_memory( std::cout, store );
     }
   }
 
@@ -75,13 +79,15 @@ int ps_log_helper( const command& cmd, const environment::ptr& env, command::log
 
   if ( cmd.is_set( option ) )
   {
-    if ( env->store<S>().current_index() == -1 )
+    const auto& store = env->store<S>();
+
+    if ( store.current_index() == -1 )
     {
       ret = boost::none;
     }
     else
     {
-      ret = log_store_entry_statistics<S>( env->store<S>().current() );
+      ret = log_store_entry_statistics<S>( store.current() );
     }
   }
 
@@ -59,19 +59,68 @@ int show_helper( const command& cmd, const environment::ptr& env )
     else
     {
       std::cout << boost::format( "[i] %s in store:" ) % name_plural << std::endl;
-      auto index = 0u;
-      for ( const auto& element : store.data() )
+      for ( auto index = 0u; index < store.size(); ++index )
       {
-        std::cout << boost::format( "  %c %2d: " ) % ( store.current_index() == index ? '*' : ' ' ) % index;
-        std::cout << store_entry_to_string<S>( element ) << std::endl;
-        ++index;
+        std::cout << boost::format( "  %c %2d: " ) % ( store.current_index() == static_cast<int>( index ) ? '*' : ' ' ) % index;
+
+        if ( store.is_spilled( index ) )
+        {
+          std::cout << boost::format( "spilled (%.1f KB)" ) % ( store.entry_memory( index ) / 1024.0 ) << std::endl;
+        }
+        else
+        {
+          std::cout << store_entry_to_string<S>( store[index] ) << boost::format( " (%.1f KB)" ) % ( store.entry_memory( index ) / 1024.0 ) << std::endl;
+        }
       }
+      print_store_memory( std::cout, store );
     }
   }
 
   return 0;
 }
 
+template<typename S>
+int copy_helper( const command& cmd, const environment::ptr& env )
+{
+  constexpr auto option = store_info<S>::option;
+  constexpr auto name   = store_info<S>::name;
+
+  if ( cmd.is_set( option ) )
+  {
+    auto& store = env->store<S>();
+
+    if ( store.current_index() == -1 )
+    {
+      std::cout << "[w] no " << name << " in store" << std::endl;
+    }
+    else
+    {
+      store.copy_current();
+    }
+  }
+  return 0;
+}
+
+template<typename S>
+int limit_helper( const command& cmd, const environment::ptr& env, unsigned limit )
+{
+  constexpr auto option = store_info<S>::option;
+  constexpr auto name   = store_info<S>::name;
+
+  if ( cmd.is_set( option ) )
+  {
+    if ( limit != 0u && !store_can_spill<S>() )
+    {
+      std::cout << "[w] " << name << " entries cannot be spilled, the limit has no effect" << std::endl;
+    }
+
+    auto& store = env->store<S>();
+    store.set_memory_limit( static_cast<std::size_t>( limit ) << 20u );
+    store.enforce_memory_limit();
+  }
+  return 0;
+}
+
 template<typename S>
 int clear_helper( const command& cmd, const environment::ptr& env )
 {
@@ -94,6 +143,8 @@ public:
     opts.add_options()
       ( "show",  "show contents" )
       ( "clear", "clear contents" )
+      ( "copy",  "copy current entry into a new entry, shared until modified" )
+      ( "limit", po::value( &limit ), "memory limit in MB, least recently used entries are spilled to disk (0: no limit)" )
       ;
 
     [](...){}( add_option_helper<S>( opts )... );
@@ -103,24 +154,36 @@ protected:
   rules_t validity_rules() const
   {
     return {
-      {[this]() { return static_cast<unsigned>( is_set( "show" ) ) + static_cast<unsigned>( is_set( "clear" ) ) <= 1u; }, "only one operation can be specified" },
+      {[this]() { return static_cast<unsigned>( is_set( "show" ) ) + static_cast<unsigned>( is_set( "clear" ) ) + static_cast<unsigned>( is_set( "copy" ) ) <= 1u; }, "only one operation can be specified" },
       {[this]() { return any_true_helper( { is_set( store_info<S>::option )... } ); }, "no store has been specified" }
     };
   }
 
   bool execute()
   {
-    if ( is_set( "show" ) || !is_set( "clear" ) )
+    if ( is_set( "limit" ) )
     {
-      [](...){}( show_helper<S>( *this, env )... );
+      [](...){}( limit_helper<S>( *this, env, limit )... );
     }
-    else if ( is_set( "clear" ) )
+
+    if ( is_set( "clear" ) )
     {
       [](...){}( clear_helper<S>( *this, env )... );
     }
+    else if ( is_set( "copy" ) )
+    {
+      [](...){}( copy_helper<S>( *this, env )... );
+    }
+    else if ( is_set( "show" ) || !is_set( "limit" ) )
+    {
+      [](...){}( show_helper<S>( *this, env )... );
+    }
 
     return true;
   }
+
+private:
+  unsigned limit = 0u;
 };
 
 }
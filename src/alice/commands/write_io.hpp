@@ -66,13 +66,15 @@ int write_io_helper( command& cmd, const std::string& default_option, const envi
 
   if ( cmd.is_set( option ) || option == default_option )
   {
-    if ( env->store<S>().current_index() == -1 )
+    const auto& store = env->store<S>();
+
+    if ( store.current_index() == -1 )
     {
       std::cout << "[w] no " << name << " selected in store" << std::endl;
     }
     else
     {
-      store_write_io_type<S, Tag>( env->store<S>().current(), filename, cmd );
+      store_write_io_type<S, Tag>( store.current(), filename, cmd );
     }
   }
   return 0;
@@ -0,0 +1,336 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "error_estimation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <boost/graph/topological_sort.hpp>
+#include <boost/math/distributions/normal.hpp>
+
+#include <core/utils/thread_pool.hpp>
+#include <core/utils/timer.hpp>
+#include <classical/utils/aig_utils.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/* AND gates in topological order with fanins as literals over simulation slots */
+class flat_aig
+{
+public:
+  explicit flat_aig( const aig_graph& aig )
+  {
+    const auto& info = aig_info( aig );
+
+    /* slot 0 is the constant, followed by the inputs */
+    std::vector<unsigned> slot( boost::num_vertices( aig ), 0u );
+    _num_inputs = info.inputs.size();
+    for ( auto i = 0u; i < _num_inputs; ++i )
+    {
+      slot[info.inputs[i]] = i + 1u;
+    }
+
+    std::vector<aig_node> topsort( boost::num_vertices( aig ) );
+    boost::topological_sort( aig, topsort.begin() );
+
+    auto next = _num_inputs + 1u;
+    for ( const auto& node : topsort )
+    {
+      if ( boost::out_degree( node, aig ) == 0u ) { continue; }
+
+      for ( const auto& c : get_children( aig, node ) )
+      {
+        _fanins.push_back( ( slot[c.node] << 1u ) | ( c.complemented ? 1u : 0u ) );
+      }
+      slot[node] = next++;
+    }
+    _num_slots = next;
+
+    for ( const auto& o : info.outputs )
+    {
+      _outputs.push_back( ( slot[o.first.node] << 1u ) | ( o.first.complemented ? 1u : 0u ) );
+    }
+  }
+
+  inline unsigned num_inputs() const  { return _num_inputs; }
+  inline unsigned num_outputs() const { return _outputs.size(); }
+
+  /* values contains the input words in slots 1 to num_inputs */
+  void simulate( std::vector<std::uint64_t>& values, unsigned words ) const
+  {
+    values.resize( _num_slots * words );
+    std::fill( values.begin(), values.begin() + words, 0u );
+
+    auto* out = &values[( _num_inputs + 1u ) * words];
+    for ( auto i = 0u; i < _fanins.size(); i += 2u )
+    {
+      const auto l0 = _fanins[i];
+      const auto l1 = _fanins[i + 1u];
+      const auto* v0 = &values[( l0 >> 1u ) * words];
+      const auto* v1 = &values[( l1 >> 1u ) * words];
+      const auto m0 = ( l0 & 1u ) ? ~std::uint64_t( 0u ) : std::uint64_t( 0u );
+      const auto m1 = ( l1 & 1u ) ? ~std::uint64_t( 0u ) : std::uint64_t( 0u );
+
+      for ( auto w = 0u; w < words; ++w )
+      {
+        out[w] = ( v0[w] ^ m0 ) & ( v1[w] ^ m1 );
+      }
+      out += words;
+    }
+  }
+
+  inline std::uint64_t output( const std::vector<std::uint64_t>& values, unsigned k, unsigned w, unsigned words ) const
+  {
+    const auto l = _outputs[k];
+    return values[( l >> 1u ) * words + w] ^ ( ( l & 1u ) ? ~std::uint64_t( 0u ) : std::uint64_t( 0u ) );
+  }
+
+private:
+  unsigned              _num_inputs;
+  unsigned              _num_slots;
+  std::vector<unsigned> _fanins;
+  std::vector<unsigned> _outputs;
+};
+
+struct sample_statistics
+{
+  void merge( const sample_statistics& other )
+  {
+    samples += other.samples;
+    errors  += other.errors;
+    sum     += other.sum;
+    sum_sq  += other.sum_sq;
+    max      = std::max( max, other.max );
+  }
+
+  unsigned long long               samples = 0ull;
+  unsigned long long               errors = 0ull;
+  long double                      sum = 0.0;
+  long double                      sum_sq = 0.0;
+  boost::multiprecision::uint256_t max = 0;
+};
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+inline unsigned count_trailing_zeros( std::uint64_t v )
+{
+  return __builtin_ctzll( v );
+}
+
+sample_statistics simulate_block( const flat_aig& f, const flat_aig& fhat, unsigned seed, unsigned long long block, unsigned words )
+{
+  /* every block has its own generator, such that results do not depend on scheduling */
+  std::seed_seq seq{ seed, static_cast<unsigned>( block ), static_cast<unsigned>( block >> 32u ) };
+  std::mt19937_64 gen( seq );
+
+  std::vector<std::uint64_t> values_f( ( f.num_inputs() + 1u ) * words );
+  for ( auto i = words; i < values_f.size(); ++i )
+  {
+    values_f[i] = gen();
+  }
+  std::vector<std::uint64_t> values_fhat( values_f );
+
+  f.simulate( values_f, words );
+  fhat.simulate( values_fhat, words );
+
+  const auto m = f.num_outputs();
+  std::vector<std::uint64_t> diff( m );
+
+  sample_statistics stats;
+  stats.samples = 64ull * words;
+
+  for ( auto w = 0u; w < words; ++w )
+  {
+    /* bit-sliced subtraction */
+    std::uint64_t borrow = 0u, error = 0u;
+    for ( auto k = 0u; k < m; ++k )
+    {
+      const auto a = f.output( values_f, k, w, words );
+      const auto b = fhat.output( values_fhat, k, w, words );
+      error |= a ^ b;
+      diff[k] = a ^ b ^ borrow;
+      borrow = ( ~a & b ) | ( ~( a ^ b ) & borrow );
+    }
+
+    if ( !error ) { continue; }
+    stats.errors += __builtin_popcountll( error );
+
+    /* absolute value, borrow is the sign */
+    auto carry = borrow;
+    for ( auto k = 0u; k < m; ++k )
+    {
+      const auto x = diff[k] ^ borrow;
+      diff[k] = x ^ carry;
+      carry = x & carry;
+    }
+
+    /* per pattern values for the variance */
+    long double values[64] = {};
+    for ( auto k = 0u; k < m; ++k )
+    {
+      for ( auto bits = diff[k]; bits; bits &= bits - 1u )
+      {
+        values[count_trailing_zeros( bits )] += std::ldexp( 1.0L, k );
+      }
+    }
+    for ( auto v : values )
+    {
+      stats.sum += v;
+      stats.sum_sq += v * v;
+    }
+
+    /* maximum by narrowing down candidates from the most significant bit */
+    auto candidates = error;
+    for ( auto k = m; k-- > 0u; )
+    {
+      if ( candidates & diff[k] ) { candidates &= diff[k]; }
+    }
+
+    const auto j = count_trailing_zeros( candidates );
+    boost::multiprecision::uint256_t max = 0;
+    for ( auto k = m; k-- > 0u; )
+    {
+      max <<= 1u;
+      if ( ( diff[k] >> j ) & 1u ) { max |= 1u; }
+    }
+    stats.max = std::max( stats.max, max );
+  }
+
+  return stats;
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+error_estimate estimate_error( const aig_graph& f, const aig_graph& fhat,
+                               const properties::ptr& settings,
+                               const properties::ptr& statistics )
+{
+  /* settings */
+  const auto confidence         = get( settings, "confidence",         0.95 );
+  const auto error_rate_width   = get( settings, "error_rate_width",   0.001 );
+  const auto average_case_width = get( settings, "average_case_width", 0.01 );
+  const auto min_samples        = get( settings, "min_samples",        1ull << 16u );
+  const auto max_samples        = get( settings, "max_samples",        1ull << 26u );
+  const auto block_words        = std::max( get( settings, "block_words", 4u ), 1u );
+  const auto num_threads        = get( settings, "num_threads",        0u );
+  const auto seed               = get( settings, "seed",               0u );
+
+  /* timer */
+  properties_timer t( statistics );
+
+  error_estimate result;
+
+  const flat_aig sf( f ), sfhat( fhat );
+  if ( sf.num_inputs() != sfhat.num_inputs() || sf.num_outputs() != sfhat.num_outputs() )
+  {
+    set_error_message( statistics, "circuits have incompatible sizes" );
+    return result;
+  }
+  if ( sf.num_outputs() > 256u )
+  {
+    set_error_message( statistics, "at most 256 outputs are supported" );
+    return result;
+  }
+
+  const auto z = boost::math::quantile( boost::math::normal(), 1.0 - ( 1.0 - confidence ) / 2.0 );
+  const auto threads = num_threads == 0u ? std::max( std::thread::hardware_concurrency(), 1u ) : num_threads;
+  const auto block_samples = 64ull * block_words;
+
+  const auto enqueue_block = [&]( thread_pool& pool, unsigned long long b ) {
+    return pool.enqueue( [&sf, &sfhat, seed, block_words, b]() {
+        return simulate_block( sf, sfhat, seed, b, block_words );
+      } );
+  };
+
+  /* blocks are merged in block order and the stopping criterion is checked
+     after each block, blocks simulated ahead of that are discarded; hence the
+     result does not depend on the number of threads */
+  thread_pool pool( threads );
+  std::deque<std::future<sample_statistics>> futures;
+  sample_statistics stats;
+  auto next_block = 0ull;
+  auto blocks = 0ull;
+
+  while ( stats.samples < max_samples )
+  {
+    /* keep several blocks per thread in flight, to balance the load */
+    while ( futures.size() < 4u * threads && stats.samples + futures.size() * block_samples < max_samples )
+    {
+      futures.push_back( enqueue_block( pool, next_block++ ) );
+    }
+
+    stats.merge( futures.front().get() );
+    futures.pop_front();
+    ++blocks;
+
+    const auto n = static_cast<double>( stats.samples );
+    const auto p = stats.errors / n;
+    const auto mean = static_cast<double>( stats.sum / n );
+    const auto var = std::max( static_cast<double>( ( stats.sum_sq - n * mean * mean ) / std::max( n - 1.0, 1.0 ) ), 0.0 );
+
+    result.samples            = stats.samples;
+    result.error_rate         = p;
+    result.error_rate_width   = z * std::sqrt( p * ( 1.0 - p ) / n + z * z / ( 4.0 * n * n ) ) / ( 1.0 + z * z / n );
+    result.average_case       = mean;
+    result.average_case_width = z * std::sqrt( var / n );
+    result.worst_case         = stats.max;
+
+    if ( stats.samples >= min_samples &&
+         result.error_rate_width <= error_rate_width &&
+         result.average_case_width <= average_case_width * mean )
+    {
+      break;
+    }
+  }
+
+  set( statistics, "blocks", blocks );
+
+  return result;
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
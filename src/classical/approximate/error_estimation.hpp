@@ -0,0 +1,101 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file error_estimation.hpp
+ *
+ * @brief Simulation-based estimation of error metrics
+ *
+ * @author agent
+ * @since  2.3
+ */
+
+#ifndef ERROR_ESTIMATION_HPP
+#define ERROR_ESTIMATION_HPP
+
+#include <boost/multiprecision/cpp_int.hpp>
+
+#include <core/properties.hpp>
+#include <classical/aig.hpp>
+
+namespace cirkit
+{
+
+struct error_estimate
+{
+  unsigned long long               samples = 0ull;
+
+  /* estimates and half-widths of their confidence intervals */
+  double                           error_rate = 0.0;
+  double                           error_rate_width = 0.0;
+  double                           average_case = 0.0;
+  double                           average_case_width = 0.0;
+
+  /* largest observed error, this is a lower bound for the worst-case error */
+  boost::multiprecision::uint256_t worst_case = 0;
+};
+
+/**
+ * @brief Estimates error rate, average-case, and worst-case error by random simulation
+ *
+ * Both AIGs are simulated bit-parallel on the same random input
+ * patterns, where the ith outputs are the ith bits of the compared
+ * numbers.  Pattern blocks are simulated in parallel and merged in
+ * block order, and the simulation stops after the first block for
+ * which the confidence interval of the error
+ * rate (Wilson score interval) has at most the absolute half-width
+ * error_rate_width, and the one of the average-case error at most the
+ * half-width average_case_width relative to the estimate.  This is
+ * meant for circuits that are too large for the exact BDD-based
+ * metrics in error_metrics.hpp.
+ *
+ * Settings:
+ * - confidence (double, 0.95): confidence level of the intervals
+ * - error_rate_width (double, 0.001)
+ * - average_case_width (double, 0.01)
+ * - min_samples (unsigned long long, 2^16)
+ * - max_samples (unsigned long long, 2^26)
+ * - block_words (unsigned, 4): 64-bit words simulated per block
+ * - num_threads (unsigned, 0): 0 uses all cores
+ * - seed (unsigned, 0): results only depend on the seed, not on the number of threads
+ *
+ * Statistics:
+ * - runtime (double)
+ * - blocks (unsigned long long): number of merged blocks
+ */
+error_estimate estimate_error( const aig_graph& f, const aig_graph& fhat,
+                               const properties::ptr& settings = properties::ptr(),
+                               const properties::ptr& statistics = properties::ptr() );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -169,9 +169,10 @@ boost::multiprecision::uint256_t get_weighted_sum( const std::vector<bdd>& f )
   auto fr = f; boost::reverse( fr );
   auto chi = characteristic_function( fr, mgr_chi );
 
-  boost::multiprecision::uint256_t sum = 0;
   const boost::multiprecision::uint256_t one = 1;
   std::stack<std::pair<bdd, boost::dynamic_bitset<>>> stack;
+  std::vector<bdd> leafs;
+  std::vector<boost::dynamic_bitset<>> values;
 
   stack.push( {chi, boost::dynamic_bitset<>( level )} );
 
@@ -181,7 +182,8 @@ boost::multiprecision::uint256_t get_weighted_sum( const std::vector<bdd>& f )
 
     if ( p.first.var() >= level )
     {
-      sum += to_multiprecision<boost::multiprecision::uint256_t>( p.second ) * ( count_solutions( p.first ) / ( one << level ) );
+      leafs.push_back( p.first );
+      values.push_back( p.second );
     }
     else
     {
@@ -191,6 +193,15 @@ boost::multiprecision::uint256_t get_weighted_sum( const std::vector<bdd>& f )
     }
   }
 
+  /* count all leafs in one sweep */
+  const auto counts = count_solutions( leafs );
+
+  boost::multiprecision::uint256_t sum = 0;
+  for ( auto i = 0u; i < leafs.size(); ++i )
+  {
+    sum += to_multiprecision<boost::multiprecision::uint256_t>( values[i] ) * ( counts[i] / ( one << level ) );
+  }
+
   return sum;
 }
 
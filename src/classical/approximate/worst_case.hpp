@@ -49,6 +49,26 @@ boost::multiprecision::uint256_t worst_case( const aig_graph& f, const aig_graph
                                              const properties::ptr& settings = properties::ptr(),
                                              const properties::ptr& statistics = properties::ptr() );
 
+/**
+ * @brief Worst-case error with the native SAT interface
+ *
+ * Encodes the miter |f - fhat|, where outputs are unsigned numbers
+ * with the first output as least significant bit, using aig_word
+ * and add_aig, and determines the maximum bit by bit from the most
+ * significant one.  Each bit is one query under an assumption to the
+ * same incremental solver, decided bits are added as unit clauses,
+ * and bits that are already set in the last model do not need a
+ * query.
+ *
+ * Statistics:
+ * - runtime (double)
+ * - sat_calls (unsigned)
+ * - conflicts (unsigned long long)
+ */
+boost::multiprecision::uint256_t worst_case_native( const aig_graph& f, const aig_graph& fhat,
+                                                    const properties::ptr& settings = properties::ptr(),
+                                                    const properties::ptr& statistics = properties::ptr() );
+
 }
 
 #endif
@@ -0,0 +1,176 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "worst_case.hpp"
+
+#include <boost/format.hpp>
+#include <boost/graph/topological_sort.hpp>
+
+#include <core/utils/bitset_utils.hpp>
+#include <core/utils/timer.hpp>
+#include <classical/aig_word.hpp>
+#include <classical/sat/minisat.hpp>
+#include <classical/sat/utils/add_aig.hpp>
+#include <classical/utils/aig_utils.hpp>
+
+#define LN( x ) if ( verbose ) { std::cout << x << std::endl; }
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+/* copies src into dest on top of the inputs pis and returns its outputs */
+static aig_word append_aig( aig_graph& dest, const aig_graph& src, const std::vector<aig_function>& pis )
+{
+  const auto& info = aig_info( src );
+
+  std::vector<aig_function> map( boost::num_vertices( src ) );
+  map[info.constant] = aig_get_constant( dest, false );
+  for ( auto i = 0u; i < info.inputs.size(); ++i )
+  {
+    map[info.inputs[i]] = pis[i];
+  }
+
+  std::vector<aig_node> topsort( boost::num_vertices( src ) );
+  boost::topological_sort( src, topsort.begin() );
+
+  for ( const auto& node : topsort )
+  {
+    if ( boost::out_degree( node, src ) == 0u ) { continue; }
+
+    const auto children = get_children( src, node );
+    map[node] = aig_create_and( dest, make_function( map[children[0u].node], children[0u].complemented ),
+                                      make_function( map[children[1u].node], children[1u].complemented ) );
+  }
+
+  aig_word outputs;
+  for ( const auto& o : info.outputs )
+  {
+    outputs.push_back( make_function( map[o.first.node], o.first.complemented ) );
+  }
+  return outputs;
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+boost::multiprecision::uint256_t worst_case_native( const aig_graph& f, const aig_graph& fhat,
+                                                    const properties::ptr& settings,
+                                                    const properties::ptr& statistics )
+{
+  const auto verbose = get( settings, "verbose", false );
+
+  properties_timer t( statistics );
+
+  const auto& finfo = aig_info( f );
+  const auto& fhatinfo = aig_info( fhat );
+
+  if ( ( finfo.inputs.size() != fhatinfo.inputs.size() ) || ( finfo.outputs.size() != fhatinfo.outputs.size() ) )
+  {
+    set_error_message( statistics, "circuits have incompatible sizes" );
+    return 0;
+  }
+
+  const auto num_bits = finfo.outputs.size();
+
+  /* miter with shared inputs */
+  aig_graph miter;
+  aig_initialize( miter );
+
+  std::vector<aig_function> pis;
+  for ( const auto& input : finfo.inputs )
+  {
+    pis.push_back( aig_create_pi( miter, finfo.node_names.at( input ) ) );
+  }
+
+  const auto wf    = append_aig( miter, f, pis );
+  const auto wfhat = append_aig( miter, fhat, pis );
+
+  /* absolute difference as larger minus smaller number */
+  const auto less = aig_create_bvult( miter, wf, wfhat );
+  const auto diff = aig_create_bvsub( miter, aig_create_ite( miter, less, wfhat, wf ), aig_create_ite( miter, less, wf, wfhat ) );
+  aig_create_wo( miter, diff, "diff" );
+
+  LN( boost::format( "[i] miter has %d nodes" ) % boost::num_vertices( miter ) );
+
+  /* encode */
+  auto solver = make_solver<minisat_solver>();
+  std::vector<int> piids, poids;
+  add_aig( solver, miter, 1, piids, poids );
+
+  solver_execution_statistics solver_statistics;
+  auto sat_calls = 0u;
+  auto conflicts = 0ull;
+
+  auto model = solve( solver, solver_statistics );
+  ++sat_calls;
+  conflicts += solver_statistics.num_conflicts;
+  assert( model );
+
+  /* maximize from the most significant bit */
+  boost::dynamic_bitset<> sol( num_bits );
+  for ( auto k = num_bits; k-- > 0u; )
+  {
+    /* the last model satisfies all decided bits */
+    if ( !model->first[poids[k] - 1] )
+    {
+      const auto result = solve( solver, solver_statistics, {poids[k]} );
+      ++sat_calls;
+      conflicts += solver_statistics.num_conflicts;
+
+      if ( !result )
+      {
+        add_clause( solver )( {-poids[k]} );
+        continue;
+      }
+      model = result;
+    }
+
+    sol.set( k );
+    add_clause( solver )( {poids[k]} );
+  }
+
+  set( statistics, "sat_calls", sat_calls );
+  set( statistics, "conflicts", conflicts );
+
+  return to_multiprecision<boost::multiprecision::uint256_t>( sol );
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -63,22 +63,23 @@ protected:
 
   inline aig_graph& aig()
   {
-    return store.current();
+    return store.current_mutable();
   }
 
   inline const aig_graph& aig() const
   {
-    return store.current();
+    const auto& entries = store;
+    return entries.current();
   }
 
   inline aig_graph_info& info()
   {
-    return aig_info( store.current() );
+    return aig_info( aig() );
   }
 
   inline const aig_graph_info& info() const
   {
-    return aig_info( store.current() );
+    return aig_info( aig() );
   }
 
 protected:
@@ -121,12 +121,13 @@ protected:
 
   inline aig_graph& aig()
   {
-    return env->store<aig_graph>().current();
+    return env->store<aig_graph>().current_mutable();
   }
 
   inline const aig_graph& aig() const
   {
-    return env->store<aig_graph>().current();
+    const auto& entries = env->store<aig_graph>();
+    return entries.current();
   }
 
   inline aig_graph_info& aig_info()
@@ -141,12 +142,13 @@ protected:
 
   inline mig_graph& mig()
   {
-    return env->store<mig_graph>().current();
+    return env->store<mig_graph>().current_mutable();
   }
 
   inline const mig_graph& mig() const
   {
-    return env->store<mig_graph>().current();
+    const auto& entries = env->store<mig_graph>();
+    return entries.current();
   }
 
   inline mig_graph_info& mig_info()
@@ -84,7 +84,8 @@ bool abc_command::execute()
 
   if ( !aigs.empty() && !is_set( "empty" ) )
   {
-    const auto& aig = aigs.current();
+    const auto& entries = env->store<aig_graph>();
+    const auto& aig = entries.current();
     abc::Gia_Man_t *gia = cirkit_to_gia( aig );
     if ( gia )
     {
@@ -74,7 +74,7 @@ command::rules_t cec_command::validity_rules() const
 
 bool cec_command::execute()
 {
-  auto& aigs = env->store<aig_graph>();
+  const auto& aigs = env->store<aig_graph>();
 
   const auto& aig_circ1 = aigs[circ1];
   const auto& aig_circ2 = aigs[circ2];
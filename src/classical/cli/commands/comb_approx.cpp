@@ -92,7 +92,7 @@ bool comb_approx_command::execute()
 {
   using boost::format;
 
-  auto& aigs = env->store<aig_graph>();
+  const auto& aigs = env->store<aig_graph>();
   // auto& bdds = env->store<bdd_function_t>();
 
   bdd_manager_ptr  manager;
@@ -178,11 +178,12 @@ bool comb_approx_command::execute()
       aig_create_po( aig, func.value, info.outputs[func.index].second );
     }
 
-    if ( aigs.empty() || is_set( "new" ) )
+    auto& store = env->store<aig_graph>();
+    if ( store.empty() || is_set( "new" ) )
     {
-      aigs.extend();
+      store.extend();
     }
-    aigs.current() = aig;
+    store.current() = aig;
   }
   else if ( is_set( "bdd" ) )
   {
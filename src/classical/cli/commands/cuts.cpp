@@ -72,12 +72,14 @@ cuts_command::cuts_command( const environment::ptr& env ) : aig_mig_command( env
 
 bool cuts_command::execute_aig()
 {
-  paged_aig_cuts cuts( aig(), node_count, is_set( "parallel" ) );
+  const auto& self = *this;
+
+  paged_aig_cuts cuts( self.aig(), node_count, is_set( "parallel" ) );
   std::cout << boost::format( "[i] found %d cuts in %.2f secs (%d KB)" ) % cuts.total_cut_count() % cuts.enumeration_time() % ( cuts.memory() >> 10u ) << std::endl;
 
   if ( is_verbose() )
   {
-    for ( const auto& p : boost::make_iterator_range( vertices( aig() ) ) )
+    for ( const auto& p : boost::make_iterator_range( vertices( self.aig() ) ) )
     {
       std::cout << boost::format( "[i] node %d has %d cuts" ) % p % cuts.count( p ) << std::endl;
       for ( const auto& cut : cuts.cuts( p ) )
@@ -104,12 +106,14 @@ bool cuts_command::execute_aig()
 
 bool cuts_command::execute_mig()
 {
-  mig_cuts_paged cuts( mig(), node_count );
+  const auto& self = *this;
+
+  mig_cuts_paged cuts( self.mig(), node_count );
   std::cout << boost::format( "[i] found %d cuts in %.2f secs (%d KB)" ) % cuts.total_cut_count() % cuts.enumeration_time() % ( cuts.memory() >> 10u ) << std::endl;
 
   if ( is_verbose() )
   {
-    for ( const auto& p : boost::make_iterator_range( vertices( mig() ) ) )
+    for ( const auto& p : boost::make_iterator_range( vertices( self.mig() ) ) )
     {
       std::cout << boost::format( "[i] node %d has %d cuts" ) % p % cuts.count( p ) << std::endl;
       for ( const auto& cut : cuts.cuts( p ) )
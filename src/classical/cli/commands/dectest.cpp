@@ -78,7 +78,8 @@ command::rules_t dectest_command::validity_rules() const
 bool dectest_command::execute()
 {
   /* truth table in store */
-  const auto& func = env->store<tt>().current();
+  const auto& tts = env->store<tt>();
+  const auto& func = tts.current();
 
   if ( is_set( "staircase" ) )
   {
@@ -92,21 +92,23 @@ depth_command::depth_command( const environment::ptr& env )
 
 bool depth_command::execute_aig()
 {
+  const auto& self = *this;
+
   if ( is_set( "arriving" ) )
   {
     arriving.clear();
-    for ( const auto& output : aig_info().outputs )
+    for ( const auto& output : self.aig_info().outputs )
     {
-      const auto times = arriving_times( output.first.node, aig() );
+      const auto times = arriving_times( output.first.node, self.aig() );
       std::cout << boost::format( "[i] arriving times at %s" ) % output.second << std::endl;
 
       std::vector<int> pis;
-      for ( auto pi : aig_info().inputs )
+      for ( auto pi : self.aig_info().inputs )
       {
         const auto it = times.find( pi );
         if ( it != times.end() )
         {
-          std::cout << boost::format( "[i] - %s : %d" ) % aig_info().node_names.at( it->first ) % it->second << std::endl;
+          std::cout << boost::format( "[i] - %s : %d" ) % self.aig_info().node_names.at( it->first ) % it->second << std::endl;
           pis.push_back( it->second );
         }
         else
@@ -123,21 +125,23 @@ bool depth_command::execute_aig()
 
 bool depth_command::execute_mig()
 {
+  const auto& self = *this;
+
   if ( is_set( "arriving" ) )
   {
     arriving.clear();
-    for ( const auto& output : mig_info().outputs )
+    for ( const auto& output : self.mig_info().outputs )
     {
-      const auto times = arriving_times( output.first.node, mig() );
+      const auto times = arriving_times( output.first.node, self.mig() );
       std::cout << boost::format( "[i] arriving times at %s" ) % output.second << std::endl;
 
       std::vector<int> pis;
-      for ( auto pi : mig_info().inputs )
+      for ( auto pi : self.mig_info().inputs )
       {
         const auto it = times.find( pi );
         if ( it != times.end() )
         {
-          std::cout << boost::format( "[i] - %s : %d" ) % mig_info().node_names.at( it->first ) % it->second << std::endl;
+          std::cout << boost::format( "[i] - %s : %d" ) % self.mig_info().node_names.at( it->first ) % it->second << std::endl;
           pis.push_back( it->second );
         }
         else
@@ -55,9 +55,11 @@ memristor_command::memristor_command( const environment::ptr& env )
 
 bool memristor_command::execute()
 {
+  const auto& self = *this;
+
   if ( is_set( "costs" ) )
   {
-    std::tie( memristors, operations ) = memristor_costs( mig() );
+    std::tie( memristors, operations ) = memristor_costs( self.mig() );
     std::cout << "[i] #memristors: " << memristors << " #operations: " << operations << std::endl;
   }
 
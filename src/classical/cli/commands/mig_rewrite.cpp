@@ -21,6 +21,7 @@
 #include <boost/format.hpp>
 
 #include <core/utils/program_options.hpp>
+#include <classical/mig/mig_depth_rewriting.hpp>
 #include <classical/mig/mig_rewriting.hpp>
 #include <classical/mig/mig_mighty_rewriting.hpp>
 
@@ -44,7 +45,7 @@ namespace cirkit
 mig_rewrite_command::mig_rewrite_command( const environment::ptr& env ) : mig_base_command( env, "MIG rewriting" )
 {
   opts.add_options()
-    ( "metric",   value_with_default( &metric ),   "Cost metric for optimization\n0: depth\n1: area\n2: memristor\n3: MIGhty" )
+    ( "metric",   value_with_default( &metric ),   "Cost metric for optimization\n0: depth\n1: area\n2: memristor\n3: MIGhty\n4: depth (incremental, effort 0 runs until no gain)" )
     ( "nodist",                                    "Don't use distributivity rule" )
     ( "noassoc",                                   "Don't use associativity rule" )
     ( "nocassoc",                                  "Don't use complementary associativity rule" )
@@ -77,6 +78,9 @@ bool mig_rewrite_command::execute()
   case 3u:
     mig() = mig_mighty_depth_rewriting( mig(), settings, statistics );
     break;
+  case 4u:
+    mig() = mig_incremental_depth_rewriting( mig(), settings, statistics );
+    break;
   }
 
   std::cout << boost::format( "[i] run-time: %.2f secs" ) % statistics->get<double>( "runtime" ) << std::endl;
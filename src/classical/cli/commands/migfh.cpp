@@ -60,6 +60,8 @@ migfh_command::migfh_command( const environment::ptr& env ) : mig_base_command(
     ( "allow_area_inc",                                          "allow area increase for candidates (only bottom-up)" )
     ( "allow_depth_inc",                                         "allow depth increase for candidates (only bottom-up)" )
     ( "sort_area_first", value_with_default( &sort_area_first ), "sort candidates by area, then depth (only bottom-up)" )
+    ( "parallel",                                                "optimize FFRs in parallel (only top-down with FFRs)" )
+    ( "threads",         value_with_default( &threads ),         "number of threads for parallel mode (0: number of cores)" )
     ;
   be_verbose();
 }
@@ -76,6 +78,8 @@ bool migfh_command::execute()
   settings->set( "allow_area_inc",      is_set( "allow_area_inc" ) );
   settings->set( "allow_depth_inc",     is_set( "allow_depth_inc" ) );
   settings->set( "sort_area_first",     sort_area_first );
+  settings->set( "parallel",            is_set( "parallel" ) );
+  settings->set( "num_threads",         threads );
   mig() = mig_functional_hashing( mig(), settings, statistics );
 
   auto cache_hit  = statistics->get<unsigned long>( "cache_hit" );
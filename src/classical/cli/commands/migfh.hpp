@@ -57,6 +57,7 @@ private:
   unsigned hash            = 1u << 13u;
   unsigned max_candidates  = 10u;
   bool     sort_area_first = true;
+  unsigned threads         = 0u;
 };
 
 }
@@ -138,7 +138,7 @@ bool npn_command::execute()
 
   if ( is_set( "truthtable" ) )
   {
-    auto& tts = env->store<tt>();
+    const auto& tts = env->store<tt>();
 
     npn = func( tts.current(), phase, perm, properties::ptr(), statistics );
 
@@ -148,8 +148,9 @@ bool npn_command::execute()
 
     if ( is_set( "store" ) )
     {
-      tts.extend();
-      tts.current() = npn;
+      auto& store = env->store<tt>();
+      store.extend();
+      store.current() = npn;
     }
   }
 
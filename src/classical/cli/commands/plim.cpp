@@ -52,20 +52,30 @@ plim_command::plim_command( const environment::ptr& env )
 {
   opts.add_options()
     ( "print,p",                                                         "print the program" )
-    ( "generator_strategy,s", value_with_default( &generator_strategy ), "memristor generator request strategy:\n0: LIFO\n1: FIFO" )
+    ( "generator_strategy,s", value_with_default( &generator_strategy ), "memristor generator request strategy:\n0: LIFO\n1: FIFO\n2: lowest index" )
     ( "naive",                                                           "turn off all optimization" )
     ( "progress",                                                        "show progress" )
+    ( "lookahead",            value_with_default( &lookahead ),          "lookahead depth for candidate selection (0: priority queue)" )
+    ( "portfolio",                                                       "compile with several schedules in parallel and return the best program" )
+    ( "objective",            value_with_default( &objective ),          "objective in portfolio mode:\n0: RRAM count\n1: step count" )
+    ( "threads",              value_with_default( &threads ),            "number of threads in portfolio mode (0: number of cores)" )
     ;
   be_verbose();
 }
 
 bool plim_command::execute()
 {
+  const auto& self = *this;
+
   const auto settings = make_settings();
   settings->set( "enable_cost_function", !is_set( "naive" ) );
   settings->set( "generator_strategy", generator_strategy );
   settings->set( "progress", is_set( "progress" ) );
-  const auto program = compile_for_plim( mig(), settings, statistics );
+  settings->set( "lookahead", lookahead );
+  settings->set( "portfolio", is_set( "portfolio" ) );
+  settings->set( "objective", objective );
+  settings->set( "num_threads", threads );
+  const auto program = compile_for_plim( self.mig(), settings, statistics );
 
   if ( is_set( "progress" ) )
   {
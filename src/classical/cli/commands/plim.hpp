@@ -55,6 +55,9 @@ public:
 
 private:
   unsigned generator_strategy = 0u;
+  unsigned lookahead          = 0u;
+  unsigned objective          = 0u;
+  unsigned threads            = 0u;
 };
 
 }
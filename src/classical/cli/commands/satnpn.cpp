@@ -58,6 +58,7 @@ satnpn_command::satnpn_command( const environment::ptr& env )
     ( "miter,m",    value_with_default( &miter ),     "Miter:\n0: single miter\n1: shared miter" )
     ( "encoding,e", value_with_default( &encoding ),  "Encoding:\n0: Tseytin\n2: EMS" )
     ( "heuristic",  value_with_default( &heuristic ), "Heuristic:\n0: flip-swap\n1: sifting" )
+    ( "threads,t",  value_with_default( &threads ),   "Number of threads for shared miter (0: all cores)" )
     ;
   be_verbose();
 }
@@ -76,6 +77,7 @@ bool satnpn_command::execute()
   settings->set( "miter", miter );
   settings->set( "encoding", encoding );
   settings->set( "heuristic", heuristic );
+  settings->set( "num_threads", threads );
   aig() = aig_npn_canonization( aig_current, settings, statistics );
 
   std::cout << boost::format( "[i] run-time:       %.2f secs\n[i] run-time "
@@ -100,6 +102,7 @@ command::log_opt_t satnpn_command::log() const
       {"miter", miter},
       {"encoding", encoding},
       {"heuristic", heuristic},
+      {"threads", threads},
       {"runtime", statistics->get<double>( "runtime" )},
       {"sat_runtime", statistics->get<double>( "sat_runtime" )},
       {"miter_runtime", statistics->get<double>( "miter_runtime" )},
@@ -56,6 +56,7 @@ private:
   unsigned miter = 0u;
   unsigned encoding = 0u;
   unsigned heuristic = 0u;
+  unsigned threads = 1u;
 };
 
 }
@@ -78,6 +78,8 @@ command::rules_t simgraph_command::validity_rules() const
 
 bool simgraph_command::execute()
 {
+  const auto& self = *this;
+
   std::vector<unsigned> types;
   foreach_string( vectors, ",", [&]( const std::string& s ) {
       if      ( s == "ah" ) types += 0u;
@@ -96,7 +98,7 @@ bool simgraph_command::execute()
   }
   statistics = std::make_shared<properties>();
 
-  const auto graph = create_simulation_graph( aig(), types, settings, statistics );
+  const auto graph = create_simulation_graph( self.aig(), types, settings, statistics );
 
   std::cout << format( "[i] create_simulation_graph:  %.2f secs" ) % statistics->get<double>( "runtime" ) << std::endl
             << format( "[i] - labeling time:          %.2f secs" ) % statistics->get<double>( "labeling_runtime" ) << std::endl
@@ -105,7 +107,7 @@ bool simgraph_command::execute()
 
   if ( is_set( "signatures" ) && signatures )
   {
-    const auto& _info = info();
+    const auto& _info = self.info();
     const auto& meta  = boost::get_property( graph, boost::graph_meta );
     const auto offset = meta.num_inputs + meta.num_vectors;
     const auto& sigs  = boost::get( boost::vertex_simulation_signature, graph );
@@ -127,16 +129,18 @@ bool simgraph_command::execute()
 
 void simgraph_command::write_pattern_file()
 {
+  const auto& self = *this;
+
   std::ofstream os( patternname.c_str(), std::ofstream::out );
 
-  os << format( "PatternList %s %s" ) % info().model_name % vectors << std::endl << std::endl;
+  os << format( "PatternList %s %s" ) % self.info().model_name % vectors << std::endl << std::endl;
 
-  os << format( "PI %d" ) % info().inputs.size() << std::endl;
+  os << format( "PI %d" ) % self.info().inputs.size() << std::endl;
 
   std::vector<std::string> input_names;
-  for ( const auto& input : info().inputs )
+  for ( const auto& input : self.info().inputs )
   {
-    input_names += info().node_names.at( input );
+    input_names += self.info().node_names.at( input );
   }
 
   os << any_join( input_names, " " ) << std::endl << std::endl;
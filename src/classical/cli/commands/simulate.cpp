@@ -127,23 +127,25 @@ command::rules_t simulate_command::validity_rules() const
 
 bool simulate_command::execute_aig()
 {
+  const auto& self = *this;
+
   tts.clear();
 
   if ( is_set( "pattern" ) )
   {
     simple_assignment_simulator::aig_name_value_map m;
-    for ( auto i = 0u; i < aig_info().inputs.size(); ++i )
+    for ( auto i = 0u; i < self.aig_info().inputs.size(); ++i )
     {
-      m.insert( { aig_info().node_names.at( aig_info().inputs.at( i ) ), pattern[i] == '1' } );
+      m.insert( { self.aig_info().node_names.at( self.aig_info().inputs.at( i ) ), pattern[i] == '1' } );
     }
     simple_assignment_simulator sim( m );
 
     properties_timer t( statistics );
 
     auto settings = make_settings();
-    auto result = simulate_aig( aig(), sim, settings );
+    auto result = simulate_aig( self.aig(), sim, settings );
 
-    for ( const auto& p : aig_info().outputs )
+    for ( const auto& p : self.aig_info().outputs )
     {
       std::cout << boost::format( "[i] %s : %d" ) % p.second % result[p.first] << std::endl;
     }
@@ -182,9 +184,9 @@ bool simulate_command::execute_aig()
 
     properties_timer t( statistics );
 
-    auto values = simulate_aig( aig(), simple_assignment_simulator( massignment ) );
+    auto values = simulate_aig( self.aig(), simple_assignment_simulator( massignment ) );
 
-    for ( const auto& o : aig_info().outputs )
+    for ( const auto& o : self.aig_info().outputs )
     {
       std::cout << boost::format( "[i] %s : %d" ) % o.second % values[o.first] << std::endl;
     }
@@ -193,9 +195,9 @@ bool simulate_command::execute_aig()
   {
     properties_timer t( statistics );
 
-    auto values = simulate_aig( aig(), tt_simulator() );
+    auto values = simulate_aig( self.aig(), tt_simulator() );
 
-    for ( const auto& o : aig_info().outputs )
+    for ( const auto& o : self.aig_info().outputs )
     {
       auto tt = values[o.first];
 
@@ -216,11 +218,11 @@ bool simulate_command::execute_aig()
        class. */
     Cudd mgr;
     bdd_simulator simulator( mgr );
-    auto values = simulate_aig( aig(), simulator );
+    auto values = simulate_aig( self.aig(), simulator );
 
     std::vector<BDD> bdds;
 
-    for ( const auto& o : aig_info().outputs )
+    for ( const auto& o : self.aig_info().outputs )
     {
       if ( !is_set( "quiet" ) )
       {
@@ -244,36 +246,38 @@ bool simulate_command::execute_aig()
 
 bool simulate_command::execute_mig()
 {
+  const auto& self = *this;
+
   tts.clear();
 
   if ( is_set( "pattern" ) )
   {
     mig_simple_assignment_simulator::mig_name_value_map m;
-    for ( auto i = 0u; i < mig_info().inputs.size(); ++i )
+    for ( auto i = 0u; i < self.mig_info().inputs.size(); ++i )
     {
-      m.insert( { mig_info().node_names.at( mig_info().inputs.at( i ) ), pattern[i] == '1' } );
+      m.insert( { self.mig_info().node_names.at( self.mig_info().inputs.at( i ) ), pattern[i] == '1' } );
     }
     mig_simple_assignment_simulator sim( m );
 
     auto settings = make_settings();
-    auto result = simulate_mig( mig(), sim, settings );
+    auto result = simulate_mig( self.mig(), sim, settings );
 
-    for ( const auto& p : mig_info().outputs )
+    for ( const auto& p : self.mig_info().outputs )
     {
       std::cout << boost::format( "[i] %s : %d" ) % p.second % result[p.first] << std::endl;
     }
   }
   else if ( is_set( "tt" ) )
   {
-    auto values = simulate_mig( mig(), mig_tt_simulator() );
+    auto values = simulate_mig( self.mig(), mig_tt_simulator() );
 
-    for ( const auto& o : mig_info().outputs )
+    for ( const auto& o : self.mig_info().outputs )
     {
       auto tt = values[o.first];
 
-      if ( mig_info().inputs.size() < tt_num_vars( tt ) )
+      if ( self.mig_info().inputs.size() < tt_num_vars( tt ) )
       {
-        tt_shrink( tt, mig_info().inputs.size() );
+        tt_shrink( tt, self.mig_info().inputs.size() );
       }
 
       std::cout << boost::format( "[i] %s : " ) % o.second << tt << " (" << tt_to_hex( tt ) << ")" << std::endl;
@@ -55,14 +55,16 @@ support_command::support_command( const environment::ptr& env ) : aig_base_comma
 
 bool support_command::execute()
 {
+  const auto& self = *this;
+
   auto settings = make_settings();
   auto statistics = std::make_shared<properties>();
 
-  auto support = aig_structural_support( aig(), settings, statistics );
+  auto support = aig_structural_support( self.aig(), settings, statistics );
 
   std::cout << "[i] structural support" << std::endl;
 
-  const auto& _info = info();
+  const auto& _info = self.info();
   for ( const auto& output : _info.outputs )
   {
     std::cout << boost::format( "    %s :" ) % output.second;
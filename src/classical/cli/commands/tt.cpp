@@ -146,7 +146,8 @@ command::log_opt_t tt_command::log() const
 {
   if ( is_set( "load" ) || is_set( "random" ) )
   {
-    return log_opt_t( {{"tt", to_string( env->store<tt>().current() )}} );
+    const auto& tts = env->store<tt>();
+    return log_opt_t( {{"tt", to_string( tts.current() )}} );
   }
   else
   {
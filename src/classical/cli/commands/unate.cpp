@@ -102,19 +102,21 @@ unate_command::unate_command( const environment::ptr& env )
 
 bool unate_command::execute()
 {
+  const auto& self = *this;
+
   const auto settings = make_settings();
   settings->set( "progress", is_set( "progress" ) );
   settings->set( "skiplist", is_set( "skiplist" ) );
 
   if ( is_set( "print" ) )
   {
-    if ( info().unateness.empty() )
+    if ( self.info().unateness.empty() )
     {
       std::cout << "[w] AIG has no unateness information" << std::endl;
     }
     else
     {
-      print_unateness( std::cout, info().unateness, info() );
+      print_unateness( std::cout, self.info().unateness, self.info() );
     }
     return true;
   }
@@ -124,19 +126,19 @@ bool unate_command::execute()
   switch ( approach )
   {
   case 0u:
-    u = unateness_naive( aig(), settings, statistics );
+    u = unateness_naive( self.aig(), settings, statistics );
     break;
   case 1u:
-    u = unateness( aig(), settings, statistics );
+    u = unateness( self.aig(), settings, statistics );
     break;
   case 2u:
-    u = unateness_split( aig(), settings, statistics );
+    u = unateness_split( self.aig(), settings, statistics );
     break;
   case 3u:
-    u = unateness_split_parallel( aig(), settings, statistics );
+    u = unateness_split_parallel( self.aig(), settings, statistics );
     break;
   case 4u:
-    u = unateness_split_inputs_parallel( aig(), settings, statistics );
+    u = unateness_split_inputs_parallel( self.aig(), settings, statistics );
     break;
   }
 
@@ -158,7 +160,7 @@ bool unate_command::execute()
     }
     std::ostream os( buf );
 
-    print_unateness( os, u, info() );
+    print_unateness( os, u, self.info() );
   }
 
   std::cout << boost::format( "[i] run-time (total): %.2f secs" ) % statistics->get<double>( "runtime" ) << std::endl
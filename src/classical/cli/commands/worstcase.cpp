@@ -26,8 +26,11 @@
 
 #include "worstcase.hpp"
 
+#include <boost/format.hpp>
+
 #include <core/utils/program_options.hpp>
 #include <classical/cli/stores.hpp>
+#include <classical/approximate/error_estimation.hpp>
 #include <classical/approximate/worst_case.hpp>
 
 namespace cirkit
@@ -51,6 +54,10 @@ worstcase_command::worstcase_command( const environment::ptr& env )
   opts.add_options()
     ( "id1", value_with_default( &id1 ), "id of first circuit" )
     ( "id2", value_with_default( &id2 ), "id of second circuit" )
+    ( "sample,s", "estimate error rate, average-case, and worst-case error by random simulation" )
+    ( "confidence", value_with_default( &confidence ), "confidence level for sampling" )
+    ( "threads", value_with_default( &threads ), "number of threads for sampling (0: all cores)" )
+    ( "native,n", "compute unsigned worst-case error with native SAT solver instead of ABC" )
     ;
   be_verbose();
 }
@@ -61,7 +68,26 @@ bool worstcase_command::execute()
 
   auto settings = make_settings();
 
-  std::cout << worst_case( aigs[id1], aigs[id2], settings, statistics ) << std::endl;
+  if ( is_set( "sample" ) )
+  {
+    settings->set( "confidence", confidence );
+    settings->set( "num_threads", threads );
+
+    const auto est = estimate_error( aigs[id1], aigs[id2], settings, statistics );
+
+    std::cout << boost::format( "[i] samples:      %d" ) % est.samples << std::endl
+              << boost::format( "[i] error rate:   %.6f +/- %.6f" ) % est.error_rate % est.error_rate_width << std::endl
+              << boost::format( "[i] average case: %.2f +/- %.2f" ) % est.average_case % est.average_case_width << std::endl
+              << "[i] worst case:   >= " << est.worst_case << std::endl;
+  }
+  else if ( is_set( "native" ) )
+  {
+    std::cout << worst_case_native( aigs[id1], aigs[id2], settings, statistics ) << std::endl;
+  }
+  else
+  {
+    std::cout << worst_case( aigs[id1], aigs[id2], settings, statistics ) << std::endl;
+  }
 
   print_runtime();
 
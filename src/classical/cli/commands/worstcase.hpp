@@ -52,6 +52,8 @@ protected:
 private:
   unsigned id1 = 0u;
   unsigned id2 = 1u;
+  double   confidence = 0.95;
+  unsigned threads = 0u;
 };
 
 }
@@ -67,17 +67,18 @@ protected:
 
   inline mig_graph& mig()
   {
-    return store.current();
+    return store.current_mutable();
   }
 
   inline const mig_graph& mig() const
   {
-    return store.current();
+    const auto& entries = store;
+    return entries.current();
   }
 
   inline const mig_graph_info& info() const
   {
-    return mig_info( store.current() );
+    return mig_info( mig() );
   }
 
 protected:
@@ -45,6 +45,7 @@
 #include <classical/functions/aig_to_mig.hpp>
 #include <classical/functions/compute_levels.hpp>
 #include <classical/functions/simulate_aig.hpp>
+#include <classical/io/aig_serialize.hpp>
 #include <classical/io/read_aiger.hpp>
 #include <classical/io/read_bench.hpp>
 #include <classical/io/read_symmetries.hpp>
@@ -72,6 +73,15 @@ namespace alice
 
 using namespace cirkit;
 
+/* estimated memory of a boost graph, and of a node in a std::map (without the value) */
+template<typename G>
+std::size_t graph_memory( const G& g )
+{
+  return sizeof( G ) + boost::num_vertices( g ) * sizeof( typename G::stored_vertex ) + boost::num_edges( g ) * sizeof( typename G::StoredEdge );
+}
+
+constexpr std::size_t map_node_overhead = 4u * sizeof( void* );
+
 /******************************************************************************
  * aig_graph                                                                  *
  ******************************************************************************/
@@ -153,6 +163,32 @@ command::log_opt_t log_store_entry_statistics<aig_graph>( const aig_graph& aig )
       {"depth", static_cast<int>( depth )}});
 }
 
+template<>
+std::size_t store_entry_memory<aig_graph>( const aig_graph& aig )
+{
+  const auto& info = aig_info( aig );
+
+  return graph_memory( aig )
+    + info.strash.size() * ( sizeof( decltype( info.strash )::value_type ) + map_node_overhead )
+    + info.node_names.size() * ( sizeof( decltype( info.node_names )::value_type ) + map_node_overhead )
+    + ( info.inputs.size() + info.outputs.size() ) * sizeof( std::pair<aig_function, std::string> );
+}
+
+/* the serialization keeps names, annotations and the strashing table, which AIGER drops */
+template<>
+void store_write_spill<aig_graph>( std::ostream& os, const aig_graph& aig )
+{
+  write_aig_serialized( aig, os );
+}
+
+template<>
+aig_graph store_read_spill<aig_graph>( std::istream& is )
+{
+  aig_graph aig;
+  read_aig_serialized( aig, is );
+  return aig;
+}
+
 template<>
 aig_graph store_convert<tt, aig_graph>( const tt& t )
 {
@@ -344,6 +380,16 @@ command::log_opt_t log_store_entry_statistics<mig_graph>( const mig_graph& mig )
     });
 }
 
+template<>
+std::size_t store_entry_memory<mig_graph>( const mig_graph& mig )
+{
+  const auto& info = mig_info( mig );
+
+  return graph_memory( mig )
+    + info.strash.capacity() * 4u * sizeof( mig_strash_table::literal_t )
+    + info.node_names.size() * ( sizeof( decltype( info.node_names )::value_type ) + map_node_overhead );
+}
+
 template<>
 expression_t::ptr store_convert<mig_graph, expression_t::ptr>( const mig_graph& mig )
 {
@@ -429,6 +475,24 @@ void print_store_entry<tt>( std::ostream& os, const tt& t )
      << t << std::endl;
 }
 
+template<>
+std::size_t store_entry_memory<tt>( const tt& t )
+{
+  return sizeof( tt ) + t.num_blocks() * sizeof( tt::block_type );
+}
+
+template<>
+void store_write_spill<tt>( std::ostream& os, const tt& t )
+{
+  write_bitset_binary( os, t );
+}
+
+template<>
+tt store_read_spill<tt>( std::istream& is )
+{
+  return read_bitset_binary( is );
+}
+
 template<>
 void store_write_io_type<tt, io_pla_tag_t>( const tt& t, const std::string& filename, const command& cmd )
 {
@@ -551,6 +615,13 @@ command::log_opt_t log_store_entry_statistics<xmg_graph>( const xmg_graph& xmg )
   return log;
 }
 
+template<>
+std::size_t store_entry_memory<xmg_graph>( const xmg_graph& xmg )
+{
+  /* graph, fanout and level bookkeeping, and one strash entry per gate */
+  return graph_memory( xmg.graph() ) + xmg.size() * ( 3u * sizeof( unsigned ) + sizeof( std::tuple<xmg_function, xmg_function, xmg_function> ) + 2u * sizeof( void* ) );
+}
+
 show_store_entry<xmg_graph>::show_store_entry( command& cmd )
 {
   boost::program_options::options_description xmg_options( "XMG options" );
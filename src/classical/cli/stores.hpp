@@ -96,6 +96,18 @@ void print_store_entry_statistics<aig_graph>( std::ostream& os, const aig_graph&
 template<>
 command::log_opt_t log_store_entry_statistics<aig_graph>( const aig_graph& aig );
 
+template<>
+std::size_t store_entry_memory<aig_graph>( const aig_graph& aig );
+
+template<>
+inline bool store_can_spill<aig_graph>() { return true; }
+
+template<>
+void store_write_spill<aig_graph>( std::ostream& os, const aig_graph& aig );
+
+template<>
+aig_graph store_read_spill<aig_graph>( std::istream& is );
+
 template<>
 inline bool store_can_convert<tt, aig_graph>() { return true; }
 
@@ -180,6 +192,9 @@ void print_store_entry_statistics<mig_graph>( std::ostream& os, const mig_graph&
 template<>
 command::log_opt_t log_store_entry_statistics<mig_graph>( const mig_graph& mig );
 
+template<>
+std::size_t store_entry_memory<mig_graph>( const mig_graph& mig );
+
 template<>
 inline bool store_can_convert<mig_graph, aig_graph>() { return true; }
 
@@ -290,6 +305,18 @@ std::string store_entry_to_string<tt>( const tt& t );
 template<>
 void print_store_entry<tt>( std::ostream& os, const tt& t );
 
+template<>
+std::size_t store_entry_memory<tt>( const tt& t );
+
+template<>
+inline bool store_can_spill<tt>() { return true; }
+
+template<>
+void store_write_spill<tt>( std::ostream& os, const tt& t );
+
+template<>
+tt store_read_spill<tt>( std::istream& is );
+
 template<>
 inline bool store_can_write_io_type<tt, io_pla_tag_t>( command& cmd ) { return true; }
 
@@ -357,6 +384,9 @@ void print_store_entry_statistics<xmg_graph>( std::ostream& os, const xmg_graph&
 template<>
 command::log_opt_t log_store_entry_statistics<xmg_graph>( const xmg_graph& xmg );
 
+template<>
+std::size_t store_entry_memory<xmg_graph>( const xmg_graph& xmg );
+
 template<>
 struct show_store_entry<xmg_graph>
 {
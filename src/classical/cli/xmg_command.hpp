@@ -67,12 +67,13 @@ protected:
 
   inline xmg_graph& xmg()
   {
-    return store.current();
+    return store.current_mutable();
   }
 
   inline const xmg_graph& xmg() const
   {
-    return store.current();
+    const auto& entries = store;
+    return entries.current();
   }
 
 protected:
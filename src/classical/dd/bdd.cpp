@@ -385,13 +385,14 @@ unsigned bdd_manager::bdd_round_to( unsigned f, unsigned level, unsigned cop, un
 {
   properties::ptr settings = std::make_shared<properties>();
   properties::ptr statistics = std::make_shared<properties>();
+  settings->set( "node_counts", true );
 
   count_solutions( bdd( this, f ), settings, statistics );
 
-  return bdd_round_to( f, level, cop, to, statistics->get<std::map<unsigned, boost::multiprecision::uint256_t>>( "count_map" ) );
+  return bdd_round_to( f, level, cop, to, statistics->get<std::vector<boost::multiprecision::uint256_t>>( "node_counts" ) );
 }
 
-unsigned bdd_manager::bdd_round_to( unsigned f, unsigned level, unsigned cop, unsigned to, const std::map<unsigned, boost::multiprecision::uint256_t>& count_map )
+unsigned bdd_manager::bdd_round_to( unsigned f, unsigned level, unsigned cop, unsigned to, const std::vector<boost::multiprecision::uint256_t>& count_map )
 {
   /* terminating cases */
   if ( f <= 1u ) { return f; }
@@ -469,6 +470,90 @@ unsigned bdd_manager::bdd_round( unsigned f, unsigned level )
   return cache.insert( f, level, (unsigned)bdd_operation::round, idx );
 }
 
+unsigned bdd_manager::bdd_and_exists( unsigned f, unsigned g, unsigned cube )
+{
+  std::unordered_map<unsigned long long, unsigned> visited;
+  return bdd_and_exists( f, g, cube, visited );
+}
+
+unsigned bdd_manager::bdd_and_exists( unsigned f, unsigned g, unsigned cube, std::unordered_map<unsigned long long, unsigned>& visited )
+{
+  /* terminating cases */
+  if ( f == 0u || g == 0u )  { return 0u; }
+  if ( f == 1u && g == 1u )  { return 1u; }
+  if ( cube == 1u )          { return bdd_and( f, g ); }
+  if ( f == 1u || f == g )   { return bdd_exists( g, cube ); }
+  if ( g == 1u )             { return bdd_exists( f, cube ); }
+
+  /* commutativity */
+  if ( f > g ) { std::swap( f, g ); }
+
+  const auto& node1 = nodes.at( f );
+  const auto& node2 = nodes.at( g );
+  const auto v = std::min( node1.var, node2.var );
+
+  /* skip quantified variables above the top variable */
+  while ( cube != 1u && nodes.at( cube ).var < v )
+  {
+    cube = nodes.at( cube ).high;
+  }
+  if ( cube == 1u ) { return bdd_and( f, g ); }
+
+  /* the cube is determined by f and g, since it is a suffix of the original cube */
+  const auto key = ( static_cast<unsigned long long>( f ) << 32u ) | g;
+  const auto it = visited.find( key );
+  if ( it != visited.end() ) { return it->second; }
+
+  const auto f0 = node1.var == v ? node1.low : f;
+  const auto f1 = node1.var == v ? node1.high : f;
+  const auto g0 = node2.var == v ? node2.low : g;
+  const auto g1 = node2.var == v ? node2.high : g;
+
+  unsigned idx;
+  if ( nodes.at( cube ).var == v )
+  {
+    const auto next = nodes.at( cube ).high;
+    const auto rlow = bdd_and_exists( f0, g0, next, visited );
+    idx = rlow == 1u ? 1u : bdd_or( rlow, bdd_and_exists( f1, g1, next, visited ) );
+  }
+  else
+  {
+    const auto rlow  = bdd_and_exists( f0, g0, cube, visited );
+    const auto rhigh = bdd_and_exists( f1, g1, cube, visited );
+    idx = unique_create( v, rhigh, rlow );
+  }
+
+  visited.insert( {key, idx} );
+  return idx;
+}
+
+unsigned bdd_manager::bdd_rename( unsigned f, const std::vector<unsigned>& vars )
+{
+  assert( vars.size() == nvars );
+
+  std::unordered_map<unsigned, unsigned> visited;
+  return bdd_rename( f, vars, visited );
+}
+
+unsigned bdd_manager::bdd_rename( unsigned f, const std::vector<unsigned>& vars, std::unordered_map<unsigned, unsigned>& visited )
+{
+  /* terminating cases */
+  if ( f <= 1u ) { return f; }
+
+  const auto it = visited.find( f );
+  if ( it != visited.end() ) { return it->second; }
+
+  const auto& node = nodes.at( f );
+
+  /* order preserving, such that nodes can be created bottom-up without apply operations */
+  const auto rlow  = bdd_rename( node.low, vars, visited );
+  const auto rhigh = bdd_rename( node.high, vars, visited );
+  const auto idx   = unique_create( vars[node.var], rhigh, rlow );
+
+  visited.insert( {f, idx} );
+  return idx;
+}
+
 bdd_manager_ptr bdd_manager::create( unsigned nvars, unsigned log_max_objs, bool verbose )
 {
   return std::make_shared<bdd_manager>( nvars, log_max_objs, verbose );
@@ -600,6 +685,17 @@ bdd bdd::round( unsigned level ) const
   return bdd( manager, manager->bdd_round( index, level ) );
 }
 
+bdd bdd::and_exists( const bdd& other, const bdd& cube ) const
+{
+  assert( manager == other.manager && manager == cube.manager );
+  return bdd( manager, manager->bdd_and_exists( index, other.index, cube.index ) );
+}
+
+bdd bdd::rename( const std::vector<unsigned>& vars ) const
+{
+  return bdd( manager, manager->bdd_rename( index, vars ) );
+}
+
 bool bdd::equals( const bdd& other ) const
 {
   assert( manager == other.manager );
@@ -45,6 +45,8 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace cirkit
 {
@@ -82,6 +84,8 @@ struct bdd
   bdd round_down( unsigned level ) const;
   bdd round_up( unsigned level ) const;
   bdd round( unsigned level ) const;
+  bdd and_exists( const bdd& other, const bdd& cube ) const;
+  bdd rename( const std::vector<unsigned>& vars ) const;
 
   bool equals( const bdd& other ) const;
 
@@ -118,13 +122,21 @@ public:
   unsigned bdd_round_up( unsigned f, unsigned level );
   unsigned bdd_round( unsigned f, unsigned level );
 
+  /* existential quantification of the conjunction, without building f AND g */
+  unsigned bdd_and_exists( unsigned f, unsigned g, unsigned cube );
+
+  /* renames each variable v to vars[v], the renaming must preserve the order of variables in the support of f */
+  unsigned bdd_rename( unsigned f, const std::vector<unsigned>& vars );
+
   unsigned unique_create( unsigned var, unsigned high, unsigned low );
 
   static bdd_manager_ptr create( unsigned nvars, unsigned log_max_objs, bool verbose = false );
 
 private:
   unsigned bdd_round_to( unsigned f, unsigned level, unsigned cop, unsigned to );
-  unsigned bdd_round_to( unsigned f, unsigned level, unsigned cop, unsigned to, const std::map<unsigned, boost::multiprecision::uint256_t>& count_map );
+  unsigned bdd_round_to( unsigned f, unsigned level, unsigned cop, unsigned to, const std::vector<boost::multiprecision::uint256_t>& count_map );
+  unsigned bdd_and_exists( unsigned f, unsigned g, unsigned cube, std::unordered_map<unsigned long long, unsigned>& visited );
+  unsigned bdd_rename( unsigned f, const std::vector<unsigned>& vars, std::unordered_map<unsigned, unsigned>& visited );
 
 public:
   friend std::ostream& operator<<( std::ostream& os, const bdd_manager& mgr );
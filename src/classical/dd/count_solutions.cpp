@@ -26,10 +26,10 @@
 
 #include "count_solutions.hpp"
 
-#include <map>
+#include <algorithm>
+#include <cstdint>
 
 #include <core/utils/timer.hpp>
-#include <classical/dd/dd_depth_first.hpp>
 
 namespace cirkit
 {
@@ -42,6 +42,39 @@ namespace cirkit
  * Private functions                                                          *
  ******************************************************************************/
 
+/* dst += src << shift on width limbs, where bits beyond width limbs are dropped */
+inline void add_shifted( std::uint64_t* dst, const std::uint64_t* src, unsigned shift, unsigned width )
+{
+  const auto q = shift / 64u;
+  const auto r = shift % 64u;
+
+  std::uint64_t carry = 0u;
+  for ( auto k = q; k < width; ++k )
+  {
+    auto limb = src[k - q] << r;
+    if ( r != 0u && k > q )
+    {
+      limb |= src[k - q - 1u] >> ( 64u - r );
+    }
+
+    const auto sum = dst[k] + limb;
+    const auto c1 = sum < limb ? 1u : 0u;
+    dst[k] = sum + carry;
+    carry = c1 + ( dst[k] < sum ? 1u : 0u );
+  }
+}
+
+inline boost::multiprecision::uint256_t to_uint256( const std::uint64_t* limbs, unsigned width )
+{
+  boost::multiprecision::uint256_t r = 0;
+  for ( auto k = width; k-- > 0u; )
+  {
+    r <<= 64u;
+    r |= limbs[k];
+  }
+  return r;
+}
+
 /******************************************************************************
  * Public functions                                                           *
  ******************************************************************************/
@@ -50,19 +83,84 @@ boost::multiprecision::uint256_t count_solutions( const bdd& n,
                                                   const properties::ptr& settings,
                                                   const properties::ptr& statistics )
 {
+  return count_solutions( std::vector<bdd>{ n }, settings, statistics ).front();
+}
+
+std::vector<boost::multiprecision::uint256_t> count_solutions( const std::vector<bdd>& ns,
+                                                               const properties::ptr& settings,
+                                                               const properties::ptr& statistics )
+{
+  /* settings */
+  const auto node_counts = get( settings, "node_counts", false );
+
+  /* timer */
   properties_timer t( statistics );
 
-  std::map<unsigned, boost::multiprecision::uint256_t> c = { { 0u, 0 }, { 1u, 1 } };
-  const boost::multiprecision::uint256_t one = 1;
-  auto f = [&]( const bdd& n ) {
-    c[n.index] = ( one << ( n.low().var() - n.var() - 1u ) ) * c[n.low().index] +
-                 ( one << ( n.high().var() - n.var() - 1u ) ) * c[n.high().index];
-  };
-  dd_depth_first( n, detail::node_func_t<bdd>( f ) );
+  std::vector<boost::multiprecision::uint256_t> result;
+  if ( ns.empty() ) { return result; }
+
+  const auto& mgr = *ns.front().manager;
+  const auto nvars = mgr.num_vars();
+
+  /* counts have at most nvars + 1 bits */
+  const auto width = std::min( 4u, nvars / 64u + 1u );
+
+  auto top = 1u;
+  for ( const auto& n : ns )
+  {
+    assert( n.manager == &mgr );
+    top = std::max( top, n.index );
+  }
+
+  /* mark reachable nodes top-down */
+  std::vector<unsigned char> reachable( top + 1u, 0u );
+  for ( const auto& n : ns )
+  {
+    reachable[n.index] = 1u;
+  }
+  for ( auto i = top; i > 1u; --i )
+  {
+    if ( !reachable[i] ) { continue; }
+    const auto& node = mgr.get_node( i );
+    reachable[node.low] = reachable[node.high] = 1u;
+  }
+
+  /* count bottom-up */
+  std::vector<std::uint64_t> arena( ( top + 1u ) * width, 0u );
+  arena[width] = 1u;
+
+  for ( auto i = 2u; i <= top; ++i )
+  {
+    if ( !reachable[i] ) { continue; }
+
+    const auto& node = mgr.get_node( i );
+    auto* dst = &arena[i * width];
+    add_shifted( dst, &arena[node.low * width],  mgr.get_node( node.low ).var - node.var - 1u, width );
+    add_shifted( dst, &arena[node.high * width], mgr.get_node( node.high ).var - node.var - 1u, width );
+  }
+
+  result.reserve( ns.size() );
+  for ( const auto& n : ns )
+  {
+    std::vector<std::uint64_t> c( width, 0u );
+    add_shifted( c.data(), &arena[n.index * width], mgr.get_node( n.index ).var, width );
+    result.push_back( to_uint256( c.data(), width ) );
+  }
 
-  set( statistics, "count_map", c );
+  if ( node_counts )
+  {
+    std::vector<boost::multiprecision::uint256_t> counts( top + 1u );
+    for ( auto i = 0u; i <= top; ++i )
+    {
+      if ( reachable[i] || i <= 1u )
+      {
+        counts[i] = to_uint256( &arena[i * width], width );
+      }
+    }
+    set( statistics, "node_counts", counts );
+  }
 
-  return ( one << n.var() ) * c[n.index];
+  return result;
 }
 
 }
@@ -39,6 +39,8 @@
 #include <core/properties.hpp>
 #include <classical/dd/bdd.hpp>
 
+#include <vector>
+
 #include <boost/multiprecision/cpp_int.hpp>
 
 namespace cirkit
@@ -48,6 +50,22 @@ boost::multiprecision::uint256_t count_solutions( const bdd& n,
                                                   const properties::ptr& settings = properties::ptr(),
                                                   const properties::ptr& statistics = properties::ptr() );
 
+/**
+ * @brief Counts solutions of several BDDs of the same manager in one sweep
+ *
+ * Nodes are visited once in index order, which is a topological order
+ * in the native BDD package, and counts are kept in a dense arena of
+ * 64-bit limbs.  Counts are computed modulo 2^256.
+ *
+ * If the setting node_counts is true, the statistic node_counts is a
+ * std::vector<boost::multiprecision::uint256_t> indexed by node, which
+ * contains for each node reachable from ns the number of solutions
+ * over the variables from its own variable on.
+ */
+std::vector<boost::multiprecision::uint256_t> count_solutions( const std::vector<bdd>& ns,
+                                                               const properties::ptr& settings = properties::ptr(),
+                                                               const properties::ptr& statistics = properties::ptr() );
+
 }
 
 #endif
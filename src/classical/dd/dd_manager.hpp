@@ -102,6 +102,9 @@ public:
   unsigned get_high( unsigned z ) const;
   unsigned get_low( unsigned z ) const;
 
+  /* children always have a smaller index than their parent */
+  inline const dd_node& get_node( unsigned z ) const { return nodes[z]; }
+
   void dump_stats ( std::ostream& stream ) const;
 
 protected:
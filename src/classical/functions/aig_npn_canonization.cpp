@@ -26,6 +26,13 @@
 
 #include "aig_npn_canonization.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include <boost/format.hpp>
 #include <boost/range/algorithm_ext/iota.hpp>
 #include <boost/range/algorithm_ext/copy_n.hpp>
@@ -33,6 +40,7 @@
 #include <core/utils/bitset_utils.hpp>
 #include <core/utils/range_utils.hpp>
 #include <core/utils/terminal.hpp>
+#include <core/utils/thread_pool.hpp>
 #include <core/utils/timer.hpp>
 #include <classical/functions/aig_cone.hpp>
 #include <classical/functions/simulate_aig.hpp>
@@ -60,6 +68,54 @@ namespace cirkit
  * Types                                                                      *
  ******************************************************************************/
 
+/* wall time in which at least one of several threads is active */
+class activity_timer
+{
+public:
+  void start()
+  {
+    std::lock_guard<std::mutex> lock( mutex );
+    if ( active++ == 0u )
+    {
+      begin = std::chrono::steady_clock::now();
+    }
+  }
+
+  void stop()
+  {
+    std::lock_guard<std::mutex> lock( mutex );
+    if ( --active == 0u )
+    {
+      total += std::chrono::duration<double>( std::chrono::steady_clock::now() - begin ).count();
+    }
+  }
+
+  double runtime() const { return total; }
+
+private:
+  std::mutex                            mutex;
+  unsigned                              active = 0u;
+  std::chrono::steady_clock::time_point begin;
+  double                                total = 0.0;
+};
+
+class activity_guard
+{
+public:
+  explicit activity_guard( activity_timer* timer ) : timer( timer )
+  {
+    if ( timer ) { timer->start(); }
+  }
+
+  ~activity_guard()
+  {
+    if ( timer ) { timer->stop(); }
+  }
+
+private:
+  activity_timer* timer;
+};
+
 /******************************************************************************
  * Private functions                                                          *
  ******************************************************************************/
@@ -472,10 +528,12 @@ private:
 class aig_npn_canonization_shared_miter_manager
 {
 public:
+  /* if miter is given, it is copied instead of built from aig */
   aig_npn_canonization_shared_miter_manager( const aig_graph& aig,
                                              boost::dynamic_bitset<>& phase,
                                              std::vector<unsigned>& perm,
-                                             const properties::ptr& settings )
+                                             const properties::ptr& settings,
+                                             const aig_graph* miter = nullptr )
     : aig( aig ), info( aig_info( aig ) ), phase( phase ), perm( perm ),
       vars( info.inputs.size() ),
       polarities( info.inputs.size() << 1u ),
@@ -493,10 +551,28 @@ public:
     phase_next = phase;
     perm_next  = perm;
 
-    build_miter();
+    if ( miter )
+    {
+      this->miter = *miter;
+    }
+    else
+    {
+      build_miter();
+    }
     build_solver();
   }
 
+  const aig_graph& shared_miter() const
+  {
+    return miter;
+  }
+
+  void set_state( const std::vector<unsigned>& other_perm, const boost::dynamic_bitset<>& other_phase )
+  {
+    perm  = perm_next  = other_perm;
+    phase = phase_next = other_phase;
+  }
+
   void reset( bool output_phase )
   {
     phase.reset();
@@ -702,7 +778,10 @@ private:
         assumptions.push_back( polarities[i + n] * ( phase_next[i] ? 1 : -1 ) );
       }
 
-      const auto minterm = lexicographic_largest_solution( solver, lvars, assumptions, properties::ptr(), statistics );
+      const auto minterm = [&]() {
+        activity_guard guard( sat_activity );
+        return lexicographic_largest_solution( solver, lvars, assumptions, properties::ptr(), statistics );
+      }();
 
       ++lexsat_calls;
       sat_calls += statistics->get<unsigned>( "sat_calls" );
@@ -741,6 +820,7 @@ private:
   properties::ptr          statistics = std::make_shared<properties>();
 
 public:
+  activity_timer*          sat_activity     = nullptr; /* shared by parallel workers */
   unsigned long            sat_calls        = 0ul;
   unsigned long            lexsat_calls     = 0ul;
   double                   runtime          = 0.0;
@@ -898,6 +978,230 @@ void aig_npn_canonization_sifting_generic( const aig_graph& aig, boost::dynamic_
   fill_statistics( mgr, statistics );
 }
 
+/* a worker owns a state and an incremental solver on a copy of the shared miter */
+struct aig_npn_canonization_worker
+{
+  aig_npn_canonization_worker( const aig_graph& aig, const properties::ptr& settings, const aig_graph* miter )
+    : mgr( aig, phase, perm, settings, miter ) {}
+
+  boost::dynamic_bitset<>                   phase;
+  std::vector<unsigned>                     perm;
+  aig_npn_canonization_shared_miter_manager mgr;
+};
+
+using aig_npn_canonization_workers = std::vector<std::unique_ptr<aig_npn_canonization_worker>>;
+
+aig_npn_canonization_workers make_workers( const aig_graph& aig, const properties::ptr& settings, unsigned num_threads, activity_timer& sat_activity )
+{
+  aig_npn_canonization_workers workers;
+
+  workers.emplace_back( new aig_npn_canonization_worker( aig, settings, nullptr ) );
+  const auto& miter = workers.front()->mgr.shared_miter();
+
+  for ( auto i = 1u; i < num_threads; ++i )
+  {
+    workers.emplace_back( new aig_npn_canonization_worker( aig, settings, &miter ) );
+  }
+
+  for ( auto& w : workers )
+  {
+    w->mgr.sat_activity = &sat_activity;
+  }
+
+  return workers;
+}
+
+/* miters and encodings are built one after another in make_workers, so their
+ * summed run-times are wall times; SAT calls overlap, and their run-time is the
+ * wall time in which at least one worker solves */
+void fill_statistics( const aig_npn_canonization_workers& workers, const activity_timer& sat_activity, const properties::ptr& statistics )
+{
+  auto sat_calls = 0ul, lexsat_calls = 0ul;
+  auto miter_runtime = 0.0, encoding_runtime = 0.0;
+
+  for ( const auto& w : workers )
+  {
+    sat_calls        += w->mgr.sat_calls;
+    lexsat_calls     += w->mgr.lexsat_calls;
+    miter_runtime    += w->mgr.miter_runtime;
+    encoding_runtime += w->mgr.encoding_runtime;
+  }
+
+  set( statistics, "lexsat_calls", lexsat_calls );
+  set( statistics, "sat_calls", sat_calls );
+  set( statistics, "sat_runtime", sat_activity.runtime() );
+  set( statistics, "miter_runtime", miter_runtime );
+  set( statistics, "encoding_runtime", encoding_runtime );
+}
+
+/* Tries moves 0, ..., num_moves - 1 in this order, where a move that
+ * improves is committed before the next one is tried.  Each batch of
+ * moves is evaluated concurrently from the same state, and the first
+ * improving move of a batch is committed while the evaluation restarts
+ * after it.  The result is therefore the same as the serial one. */
+template<typename Fn>
+bool try_moves_parallel( aig_npn_canonization_workers& workers, thread_pool& pool,
+                         boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm,
+                         unsigned num_moves, Fn&& try_move )
+{
+  auto improvement = false;
+  auto pos = 0u;
+
+  while ( pos < num_moves )
+  {
+    const auto end = std::min<unsigned>( num_moves, pos + workers.size() );
+
+    std::vector<std::future<bool>> results;
+    for ( auto k = pos; k < end; ++k )
+    {
+      auto& mgr = workers[k - pos]->mgr;
+      results.push_back( pool.enqueue( [&mgr, &phase, &perm, &try_move, k]() {
+            mgr.set_state( perm, phase );
+            return try_move( mgr, k );
+          } ) );
+    }
+
+    auto first = end;
+    for ( auto k = pos; k < end; ++k )
+    {
+      if ( results[k - pos].get() && first == end )
+      {
+        first = k;
+      }
+    }
+
+    if ( first == end )
+    {
+      pos = end;
+    }
+    else
+    {
+      perm  = workers[first - pos]->perm;
+      phase = workers[first - pos]->phase;
+      improvement = true;
+      pos = first + 1u;
+    }
+  }
+
+  return improvement;
+}
+
+void aig_npn_canonization_flip_swap_parallel( const aig_graph& aig, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm,
+                                              unsigned num_threads,
+                                              const properties::ptr& settings,
+                                              const properties::ptr& statistics )
+{
+  /* settings */
+  const auto verbose = get( settings, "verbose", false );
+
+  /* timing */
+  properties_timer t( statistics );
+
+  const auto& info = aig_info( aig );
+
+  assert( info.outputs.size() == 1u ); /* assume single output AIG */
+
+  activity_timer sat_activity;
+  auto workers = make_workers( aig, settings, num_threads, sat_activity );
+  thread_pool pool( num_threads );
+
+  const auto n = info.inputs.size();
+  phase = workers.front()->phase;
+  perm  = workers.front()->perm;
+
+  /* input/output negations first, then swaps with increasing distance */
+  std::vector<std::pair<unsigned, unsigned>> swaps;
+  for ( auto d = 1u; d < n - 1; ++d )
+  {
+    for ( auto i = 0u; i < n - d; ++i )
+    {
+      swaps.push_back( {i, i + d} );
+    }
+  }
+
+  auto improvement = true;
+  auto round = 0u;
+  while ( improvement )
+  {
+    L( "[i] round " << ++round );
+
+    improvement = try_moves_parallel( workers, pool, phase, perm, n + 1u + swaps.size(), [n, &swaps]( aig_npn_canonization_shared_miter_manager& mgr, unsigned k ) {
+        return k <= n ? mgr.try_flip( k ) : mgr.try_swap( swaps[k - n - 1u].first, swaps[k - n - 1u].second );
+      } );
+  }
+
+  fill_statistics( workers, sat_activity, statistics );
+}
+
+void aig_npn_canonization_sifting_parallel( const aig_graph& aig, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm,
+                                            unsigned num_threads,
+                                            const properties::ptr& settings,
+                                            const properties::ptr& statistics )
+{
+  /* settings */
+  const auto verbose = get( settings, "verbose", false );
+
+  /* timing */
+  properties_timer t( statistics );
+
+  const auto& info = aig_info( aig );
+
+  assert( info.outputs.size() == 1u ); /* assume single output AIG */
+
+  activity_timer sat_activity;
+  auto workers = make_workers( aig, settings, num_threads, sat_activity );
+  thread_pool pool( num_threads );
+
+  const auto n = info.inputs.size();
+  phase = workers.front()->phase;
+  perm  = workers.front()->perm;
+
+  if ( n < 2u )
+  {
+    fill_statistics( workers, sat_activity, statistics );
+    return;
+  }
+
+  const auto sift = [&]() {
+    auto improvement = true;
+    auto round = 0u;
+    auto forward = true;
+
+    while ( improvement )
+    {
+      L( "[i] round " << ++round );
+
+      improvement = try_moves_parallel( workers, pool, phase, perm, n - 1u, [n, forward]( aig_npn_canonization_shared_miter_manager& mgr, unsigned k ) {
+          return mgr.try_sift( forward ? k : n - 2u - k );
+        } );
+
+      forward = !forward;
+    }
+  };
+
+  /* non-inverted function */
+  sift();
+
+  const auto best_perm = perm;
+  const auto best_phase = phase;
+
+  /* inverted function */
+  auto& mgr = workers.front()->mgr;
+  mgr.set_state( perm, phase );
+  mgr.reset( false );
+  phase = workers.front()->phase;
+  perm  = workers.front()->perm;
+
+  sift();
+
+  mgr.set_state( perm, phase );
+  mgr.try_explicit( best_perm, best_phase );
+  phase = workers.front()->phase;
+  perm  = workers.front()->perm;
+
+  fill_statistics( workers, sat_activity, statistics );
+}
+
 void aig_npn_canonization_flip_swap( const aig_graph& aig, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm,
                                      const properties::ptr& settings,
                                      const properties::ptr& statistics )
@@ -909,7 +1213,16 @@ void aig_npn_canonization_flip_swap_shared_miter( const aig_graph& aig, boost::d
                                                   const properties::ptr& settings,
                                                   const properties::ptr& statistics )
 {
-  aig_npn_canonization_flip_swap_generic<aig_npn_canonization_shared_miter_manager>( aig, phase, perm, settings, statistics );
+  const auto num_threads = get( settings, "num_threads", 1u );
+
+  if ( num_threads == 1u )
+  {
+    aig_npn_canonization_flip_swap_generic<aig_npn_canonization_shared_miter_manager>( aig, phase, perm, settings, statistics );
+  }
+  else
+  {
+    aig_npn_canonization_flip_swap_parallel( aig, phase, perm, num_threads ? num_threads : std::max( 1u, std::thread::hardware_concurrency() ), settings, statistics );
+  }
 }
 
 void aig_npn_canonization_sifting( const aig_graph& aig, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm,
@@ -923,7 +1236,16 @@ void aig_npn_canonization_sifting_shared_miter( const aig_graph& aig, boost::dyn
                                                 const properties::ptr& settings,
                                                 const properties::ptr& statistics )
 {
-  aig_npn_canonization_sifting_generic<aig_npn_canonization_shared_miter_manager>( aig, phase, perm, settings, statistics );
+  const auto num_threads = get( settings, "num_threads", 1u );
+
+  if ( num_threads == 1u )
+  {
+    aig_npn_canonization_sifting_generic<aig_npn_canonization_shared_miter_manager>( aig, phase, perm, settings, statistics );
+  }
+  else
+  {
+    aig_npn_canonization_sifting_parallel( aig, phase, perm, num_threads ? num_threads : std::max( 1u, std::thread::hardware_concurrency() ), settings, statistics );
+  }
 }
 
 aig_graph aig_npn_canonization( const aig_graph& aig,
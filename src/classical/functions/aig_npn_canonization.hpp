@@ -51,7 +51,7 @@ void aig_npn_canonization_flip_swap( const aig_graph& aig, boost::dynamic_bitset
                                      const properties::ptr& settings = properties::ptr(),
                                      const properties::ptr& statistics = properties::ptr() );
 
-/* requires a single-output AIG */
+/* requires a single-output AIG; setting num_threads (default 1, 0 for all cores) evaluates moves in parallel */
 void aig_npn_canonization_flip_swap_shared_miter( const aig_graph& aig, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm,
                                                   const properties::ptr& settings = properties::ptr(),
                                                   const properties::ptr& statistics = properties::ptr() );
@@ -61,7 +61,7 @@ void aig_npn_canonization_sifting( const aig_graph& aig, boost::dynamic_bitset<>
                                    const properties::ptr& settings = properties::ptr(),
                                    const properties::ptr& statistics = properties::ptr() );
 
-/* requires a single-output AIG */
+/* requires a single-output AIG; setting num_threads (default 1, 0 for all cores) evaluates moves in parallel */
 void aig_npn_canonization_sifting_shared_miter( const aig_graph& aig, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm,
                                                 const properties::ptr& settings = properties::ptr(),
                                                 const properties::ptr& statistics = properties::ptr() );
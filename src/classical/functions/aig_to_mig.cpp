@@ -81,6 +81,7 @@ mig_graph aig_to_mig( const aig_graph& aig,
 {
   mig_graph mig;
   mig_initialize( mig );
+  mig_reserve( mig, num_vertices( aig ) );
 
   auto& info_mig   = mig_info( mig );
   const auto& info = aig_info( aig );
@@ -0,0 +1,363 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "aig_serialize.hpp"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/range/iterator_range.hpp>
+
+#include <core/utils/bitset_utils.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+using annotation_t = std::map<std::string, std::string>;
+
+/* format version, increase when the layout changes */
+constexpr std::uint32_t aig_serialize_magic   = 0x43414947; /* "CAIG" */
+constexpr std::uint32_t aig_serialize_version = 1u;
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+template<typename T>
+inline void write_value( std::ostream& os, const T& value )
+{
+  os.write( reinterpret_cast<const char*>( &value ), sizeof( T ) );
+}
+
+template<typename T>
+inline T read_value( std::istream& is )
+{
+  T value;
+  if ( !is.read( reinterpret_cast<char*>( &value ), sizeof( T ) ) )
+  {
+    throw std::string( "[e] unexpected end of serialized AIG" );
+  }
+  return value;
+}
+
+inline void write_size( std::ostream& os, std::size_t size )
+{
+  write_value<std::uint64_t>( os, size );
+}
+
+inline std::size_t read_size( std::istream& is )
+{
+  return read_value<std::uint64_t>( is );
+}
+
+inline void write_bool( std::ostream& os, bool value )
+{
+  write_value<std::uint8_t>( os, value ? 1u : 0u );
+}
+
+inline bool read_bool( std::istream& is )
+{
+  return read_value<std::uint8_t>( is ) != 0u;
+}
+
+void write_string( std::ostream& os, const std::string& s )
+{
+  write_size( os, s.size() );
+  os.write( s.data(), s.size() );
+}
+
+std::string read_string( std::istream& is )
+{
+  std::string s( read_size( is ), '\0' );
+  if ( !s.empty() && !is.read( &s[0], s.size() ) )
+  {
+    throw std::string( "[e] unexpected end of serialized AIG" );
+  }
+  return s;
+}
+
+inline void write_node( std::ostream& os, aig_node node )
+{
+  write_size( os, node );
+}
+
+inline aig_node read_node( std::istream& is, std::size_t num_nodes )
+{
+  const auto node = read_size( is );
+  if ( node >= num_nodes )
+  {
+    throw std::string( "[e] invalid node in serialized AIG" );
+  }
+  return node;
+}
+
+inline void write_function( std::ostream& os, const aig_function& f )
+{
+  write_node( os, f.node );
+  write_bool( os, f.complemented );
+}
+
+inline aig_function read_function( std::istream& is, std::size_t num_nodes )
+{
+  const auto node = read_node( is, num_nodes );
+  return {node, read_bool( is )};
+}
+
+void write_nodes( std::ostream& os, const std::vector<aig_node>& nodes )
+{
+  write_size( os, nodes.size() );
+  for ( const auto& n : nodes )
+  {
+    write_node( os, n );
+  }
+}
+
+std::vector<aig_node> read_nodes( std::istream& is, std::size_t num_nodes )
+{
+  std::vector<aig_node> nodes( read_size( is ) );
+  for ( auto& n : nodes )
+  {
+    n = read_node( is, num_nodes );
+  }
+  return nodes;
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+void write_aig_serialized( const aig_graph& aig, std::ostream& os )
+{
+  const auto& info = boost::get_property( aig, boost::graph_name );
+  const auto& indexmap = boost::get( boost::vertex_name, aig );
+  const auto& annotations = boost::get( boost::vertex_annotation, aig );
+  const auto& complementmap = boost::get( boost::edge_complement, aig );
+
+  write_value( os, aig_serialize_magic );
+  write_value( os, aig_serialize_version );
+
+  /* nodes with their fanins in edge order, which is the order of the children */
+  write_size( os, boost::num_vertices( aig ) );
+  for ( const auto& node : boost::make_iterator_range( boost::vertices( aig ) ) )
+  {
+    write_value<std::uint32_t>( os, indexmap[node] );
+
+    const annotation_t& annotation = annotations[node];
+    write_size( os, annotation.size() );
+    for ( const auto& p : annotation )
+    {
+      write_string( os, p.first );
+      write_string( os, p.second );
+    }
+
+    write_size( os, boost::out_degree( node, aig ) );
+    for ( const auto& edge : boost::make_iterator_range( boost::out_edges( node, aig ) ) )
+    {
+      write_node( os, boost::target( edge, aig ) );
+      write_bool( os, complementmap[edge] );
+    }
+  }
+
+  /* graph information */
+  write_string( os, info.model_name );
+  write_node( os, info.constant );
+  write_bool( os, info.constant_used );
+  write_bool( os, info.enable_strashing );
+  write_bool( os, info.enable_local_optimization );
+
+  write_size( os, info.node_names.size() );
+  for ( const auto& p : info.node_names )
+  {
+    write_node( os, p.first );
+    write_string( os, p.second );
+  }
+
+  write_size( os, info.outputs.size() );
+  for ( const auto& p : info.outputs )
+  {
+    write_function( os, p.first );
+    write_string( os, p.second );
+  }
+
+  write_nodes( os, info.inputs );
+
+  write_size( os, info.cos.size() );
+  for ( const auto& f : info.cos )
+  {
+    write_function( os, f );
+  }
+
+  write_nodes( os, info.cis );
+
+  write_size( os, info.strash.size() );
+  for ( const auto& p : info.strash )
+  {
+    write_function( os, p.first.first );
+    write_function( os, p.first.second );
+    write_function( os, p.second );
+  }
+
+  write_size( os, info.latch.size() );
+  for ( const auto& p : info.latch )
+  {
+    write_function( os, p.first );
+    write_function( os, p.second );
+  }
+
+  write_bitset_binary( os, info.unateness );
+
+  write_size( os, info.input_symmetries.size() );
+  for ( const auto& p : info.input_symmetries )
+  {
+    write_node( os, p.first );
+    write_node( os, p.second );
+  }
+
+  write_size( os, info.trans_words.size() );
+  for ( const auto& w : info.trans_words )
+  {
+    write_nodes( os, w );
+  }
+}
+
+void read_aig_serialized( aig_graph& aig, std::istream& is )
+{
+  if ( read_value<std::uint32_t>( is ) != aig_serialize_magic )
+  {
+    throw std::string( "[e] stream does not contain a serialized AIG" );
+  }
+  if ( read_value<std::uint32_t>( is ) != aig_serialize_version )
+  {
+    throw std::string( "[e] unsupported version of serialized AIG" );
+  }
+
+  aig = aig_graph();
+  auto& info = boost::get_property( aig, boost::graph_name );
+  auto indexmap = boost::get( boost::vertex_name, aig );
+  auto annotations = boost::get( boost::vertex_annotation, aig );
+  auto complementmap = boost::get( boost::edge_complement, aig );
+
+  /* all nodes are added first, since fanins are referred to by index */
+  const auto num_nodes = read_size( is );
+  for ( auto i = 0u; i < num_nodes; ++i )
+  {
+    boost::add_vertex( aig );
+  }
+
+  for ( auto node = 0u; node < num_nodes; ++node )
+  {
+    indexmap[node] = read_value<std::uint32_t>( is );
+
+    auto& annotation = annotations[node];
+    const auto num_annotations = read_size( is );
+    for ( auto i = 0u; i < num_annotations; ++i )
+    {
+      const auto key = read_string( is );
+      annotation[key] = read_string( is );
+    }
+
+    const auto degree = read_size( is );
+    for ( auto i = 0u; i < degree; ++i )
+    {
+      const auto target = read_node( is, num_nodes );
+      complementmap[boost::add_edge( node, target, aig ).first] = read_bool( is );
+    }
+  }
+
+  info.model_name = read_string( is );
+  info.constant = read_node( is, num_nodes );
+  info.constant_used = read_bool( is );
+  info.enable_strashing = read_bool( is );
+  info.enable_local_optimization = read_bool( is );
+
+  const auto num_names = read_size( is );
+  for ( auto i = 0u; i < num_names; ++i )
+  {
+    const auto node = read_node( is, num_nodes );
+    info.node_names[node] = read_string( is );
+  }
+
+  info.outputs.resize( read_size( is ) );
+  for ( auto& p : info.outputs )
+  {
+    p.first = read_function( is, num_nodes );
+    p.second = read_string( is );
+  }
+
+  info.inputs = read_nodes( is, num_nodes );
+
+  info.cos.resize( read_size( is ) );
+  for ( auto& f : info.cos )
+  {
+    f = read_function( is, num_nodes );
+  }
+
+  info.cis = read_nodes( is, num_nodes );
+
+  const auto num_strash = read_size( is );
+  for ( auto i = 0u; i < num_strash; ++i )
+  {
+    const auto left = read_function( is, num_nodes );
+    const auto right = read_function( is, num_nodes );
+    info.strash[{left, right}] = read_function( is, num_nodes );
+  }
+
+  const auto num_latches = read_size( is );
+  for ( auto i = 0u; i < num_latches; ++i )
+  {
+    const auto in = read_function( is, num_nodes );
+    info.latch[in] = read_function( is, num_nodes );
+  }
+
+  info.unateness = read_bitset_binary( is );
+
+  info.input_symmetries.resize( read_size( is ) );
+  for ( auto& p : info.input_symmetries )
+  {
+    p.first = read_node( is, num_nodes );
+    p.second = read_node( is, num_nodes );
+  }
+
+  info.trans_words.resize( read_size( is ) );
+  for ( auto& w : info.trans_words )
+  {
+    w = read_nodes( is, num_nodes );
+  }
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,65 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file aig_serialize.hpp
+ *
+ * @brief Lossless binary serialization of AIGs
+ *
+ * Unlike AIGER, the format keeps the complete AIG: node indexes and
+ * fanin order, node names, vertex annotations, the structural hashing
+ * table, latches, unateness, symmetries, transformation words, and all
+ * flags.  Numbers are written in host byte order, hence the format is
+ * meant for temporary files such as the spill files of the stores.
+ *
+ * @author agent
+ * @since  2.3
+ */
+
+#ifndef AIG_SERIALIZE_HPP
+#define AIG_SERIALIZE_HPP
+
+#include <iostream>
+
+#include <classical/aig.hpp>
+
+namespace cirkit
+{
+
+void write_aig_serialized( const aig_graph& aig, std::ostream& os );
+
+/* throws a string if the stream does not contain a serialized AIG */
+void read_aig_serialized( aig_graph& aig, std::istream& is );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
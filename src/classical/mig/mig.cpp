@@ -45,6 +45,18 @@ namespace cirkit
  * Private functions                                                          *
  ******************************************************************************/
 
+inline mig_strash_table::literal_t mig_pack( const mig_function& f )
+{
+  /* node ( 1 << 31 ) - 1 complemented would be the empty literal */
+  assert( f.node < ( 1u << 31u ) - 1u );
+  return ( static_cast<mig_strash_table::literal_t>( f.node ) << 1u ) | static_cast<mig_strash_table::literal_t>( f.complemented );
+}
+
+inline mig_function mig_unpack( mig_strash_table::literal_t l )
+{
+  return { l >> 1u, ( l & 1u ) == 1u };
+}
+
 struct mig_dot_writer
 {
   mig_dot_writer( const mig_graph& mig ) : mig( mig )
@@ -203,12 +215,14 @@ mig_function mig_create_maj( mig_graph& mig, const mig_function& a, const mig_fu
   mig_function children[] = {a, b, c};
   std::sort( children, children + 3 );
 
-  const auto key = std::make_tuple( children[0], children[1], children[2] );
+  const auto ka = mig_pack( children[0] );
+  const auto kb = mig_pack( children[1] );
+  const auto kc = mig_pack( children[2] );
 
-  const auto it = info.strash.find( key );
-  if ( it != info.strash.end() )
+  const auto value = info.strash.find( ka, kb, kc );
+  if ( value != mig_strash_table::empty )
   {
-    return it->second;
+    return mig_unpack( value );
   }
 
   mig_node node = add_vertex( mig );
@@ -224,7 +238,13 @@ mig_function mig_create_maj( mig_graph& mig, const mig_function& a, const mig_fu
   complement[eb] = children[1].complemented;
   complement[ec] = children[2].complemented;
 
-  return info.strash[key] = { node, false };
+  info.strash.insert( ka, kb, kc, mig_pack( { node, false } ) );
+  return { node, false };
+}
+
+void mig_reserve( mig_graph& mig, unsigned num_gates )
+{
+  boost::get_property( mig, boost::graph_name ).strash.reserve( num_gates );
 }
 
 mig_function mig_create_and( mig_graph& mig, const mig_function& a, const mig_function& b )
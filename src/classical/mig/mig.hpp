@@ -36,9 +36,12 @@
 #ifndef MIG_HPP
 #define MIG_HPP
 
+#include <unordered_map>
+
 #include <core/properties.hpp>
 #include <core/utils/graph_utils.hpp>
 #include <classical/traits.hpp>
+#include <classical/mig/mig_strash_table.hpp>
 
 namespace cirkit
 {
@@ -76,13 +79,13 @@ struct mig_function
 
 struct mig_graph_info
 {
-  std::string                                                                  model_name;
-  detail::mig_traits_t::vertex_descriptor                                      constant;
-  bool                                                                         constant_used = false;
-  std::map<detail::mig_traits_t::vertex_descriptor, std::string>               node_names;
-  std::vector<std::pair<mig_function, std::string> >                           outputs;
-  std::vector<detail::mig_traits_t::vertex_descriptor>                         inputs;
-  std::map<std::tuple<mig_function, mig_function, mig_function>, mig_function> strash;
+  std::string                                                              model_name;
+  detail::mig_traits_t::vertex_descriptor                                  constant;
+  bool                                                                     constant_used = false;
+  std::unordered_map<detail::mig_traits_t::vertex_descriptor, std::string> node_names;
+  std::vector<std::pair<mig_function, std::string> >                       outputs;
+  std::vector<detail::mig_traits_t::vertex_descriptor>                     inputs;
+  mig_strash_table                                                         strash;
 };
 
 namespace detail
@@ -109,6 +112,9 @@ mig_function mig_create_and( mig_graph& mig, const mig_function& a, const mig_fu
 mig_function mig_create_or( mig_graph& mig, const mig_function& a, const mig_function& b );
 mig_function mig_create_xor( mig_graph& mig, const mig_function& a, const mig_function& b );
 
+/* size hint for the number of majority gates, avoids rehashing the strash table */
+void mig_reserve( mig_graph& mig, unsigned num_gates );
+
 void write_dot( const mig_graph& mig, std::ostream& os, const properties::ptr& settings = properties::ptr() );
 void write_dot( const mig_graph& mig, const std::string& filename, const properties::ptr& settings = properties::ptr() );
 
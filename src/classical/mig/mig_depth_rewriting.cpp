@@ -0,0 +1,630 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "mig_depth_rewriting.hpp"
+
+#include <array>
+#include <deque>
+#include <limits>
+#include <unordered_map>
+
+#include <boost/format.hpp>
+#include <boost/graph/topological_sort.hpp>
+#include <boost/range/algorithm.hpp>
+
+#include <core/utils/timer.hpp>
+#include <classical/mig/mig_utils.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+using mig_children_t = std::array<mig_function, 3u>;
+
+struct mig_children_hash
+{
+  std::size_t operator()( const mig_children_t& c ) const
+  {
+    std::size_t seed = 0u;
+    for ( const auto& f : c )
+    {
+      seed ^= std::hash<std::size_t>()( ( f.node << 1u ) | f.complemented ) + 0x9e3779b9 + ( seed << 6u ) + ( seed >> 2u );
+    }
+    return seed;
+  }
+};
+
+struct mig_children_equal
+{
+  bool operator()( const mig_children_t& a, const mig_children_t& b ) const
+  {
+    return a[0u] == b[0u] && a[1u] == b[1u] && a[2u] == b[2u];
+  }
+};
+
+/* mutable copy of a MIG in which gates can be changed in-place; node indexes
+   of the original MIG are kept, new gates are appended */
+class mig_depth_rewriting_manager
+{
+public:
+  mig_depth_rewriting_manager( const mig_graph& mig, bool verbose );
+
+  /* returns true if the depth decreased */
+  bool run_pass();
+  mig_graph extract() const;
+
+  inline unsigned depth() const { return max_level; }
+
+private:
+  inline bool is_gate( mig_node n ) const { return gate[n]; }
+  inline unsigned level( const mig_function& f ) const { return levels[f.node]; }
+  inline bool is_critical( mig_node n ) const { return levels[n] == required[n]; }
+
+  mig_function create_maj( const mig_function& a, const mig_function& b, const mig_function& c );
+  void replace_children( mig_node n, mig_children_t new_children );
+  void update_levels( mig_node n );
+
+  unsigned required_from_fanouts( mig_node n ) const;
+  void compute_required();
+  void update_required( const mig_children_t& old_children, const mig_children_t& new_children );
+
+  std::vector<mig_node> topological_order() const;
+  std::vector<mig_node> critical_nodes() const;
+
+  bool try_distributivity( mig_node n );
+  bool try_associativity( mig_node n );
+  bool try_compl_associativity( mig_node n );
+
+private:
+  const mig_graph&                                                         mig;
+  bool                                                                     verbose;
+
+  std::vector<mig_children_t>                                              children;
+  std::vector<bool>                                                        gate;
+  std::vector<unsigned>                                                    levels;
+  std::vector<unsigned>                                                    required;   /* w.r.t. max_level at the start of the pass */
+  std::vector<bool>                                                        output;     /* drives a primary output */
+  std::vector<std::vector<mig_node>>                                       fanouts;
+  std::unordered_map<mig_children_t, mig_node, mig_children_hash, mig_children_equal> strash;
+  unsigned                                                                 max_level = 0u;
+
+public:
+  bool                                                                     use_distributivity       = true;
+  bool                                                                     use_associativity        = true;
+  bool                                                                     use_compl_associativity  = true;
+
+  /* statistics */
+  unsigned                                                                 distributivity_count       = 0u;
+  unsigned                                                                 associativity_count        = 0u;
+  unsigned                                                                 compl_associativity_count  = 0u;
+};
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+inline mig_children_t sorted_children( const mig_function& a, const mig_function& b, const mig_function& c )
+{
+  mig_children_t ch = {{a, b, c}};
+  boost::sort( ch );
+  return ch;
+}
+
+inline std::pair<unsigned, unsigned> three_without( unsigned x )
+{
+  return std::make_pair( x == 0u ? 1u : 0u, x == 2u ? 1u : 2u );
+}
+
+inline unsigned max3( unsigned a, unsigned b, unsigned c )
+{
+  return std::max( a, std::max( b, c ) );
+}
+
+/* required time of nodes that do not reach an output */
+const auto unreached = std::numeric_limits<unsigned>::max();
+
+mig_depth_rewriting_manager::mig_depth_rewriting_manager( const mig_graph& mig, bool verbose )
+  : mig( mig ),
+    verbose( verbose ),
+    children( num_vertices( mig ) ),
+    gate( num_vertices( mig ), false ),
+    levels( num_vertices( mig ), 0u ),
+    required( num_vertices( mig ), unreached ),
+    output( num_vertices( mig ), false ),
+    fanouts( num_vertices( mig ) )
+{
+  std::vector<mig_node> topsort( num_vertices( mig ) );
+  boost::topological_sort( mig, topsort.begin() );
+
+  strash.reserve( num_vertices( mig ) );
+
+  for ( auto n : topsort )
+  {
+    if ( out_degree( n, mig ) == 0u ) { continue; }
+
+    const auto c = get_children( mig, n );
+    children[n] = sorted_children( c[0u], c[1u], c[2u] );
+    gate[n] = true;
+    levels[n] = 1u + max3( level( c[0u] ), level( c[1u] ), level( c[2u] ) );
+
+    for ( const auto& f : children[n] )
+    {
+      fanouts[f.node].push_back( n );
+    }
+    strash.insert( {children[n], n} );
+  }
+
+  for ( const auto& o : mig_info( mig ).outputs )
+  {
+    output[o.first.node] = true;
+    max_level = std::max( max_level, level( o.first ) );
+  }
+}
+
+mig_function mig_depth_rewriting_manager::create_maj( const mig_function& a, const mig_function& b, const mig_function& c )
+{
+  /* same special cases as in mig_create_maj */
+  if ( a == b )  { return a; }
+  if ( a == c )  { return a; }
+  if ( b == c )  { return b; }
+  if ( a == !b ) { return c; }
+  if ( a == !c ) { return b; }
+  if ( b == !c ) { return a; }
+
+  const auto key = sorted_children( a, b, c );
+  const auto it = strash.find( key );
+  if ( it != strash.end() )
+  {
+    return {it->second, false};
+  }
+
+  const mig_node n = children.size();
+  children.push_back( key );
+  gate.push_back( true );
+  levels.push_back( 1u + max3( level( a ), level( b ), level( c ) ) );
+  required.push_back( unreached );
+  output.push_back( false );
+  fanouts.emplace_back();
+
+  for ( const auto& f : key )
+  {
+    fanouts[f.node].push_back( n );
+  }
+  strash.insert( {key, n} );
+
+  return {n, false};
+}
+
+void mig_depth_rewriting_manager::replace_children( mig_node n, mig_children_t new_children )
+{
+  boost::sort( new_children );
+
+  const auto it = strash.find( children[n] );
+  if ( it != strash.end() && it->second == n )
+  {
+    strash.erase( it );
+  }
+
+  for ( const auto& f : children[n] )
+  {
+    auto& fo = fanouts[f.node];
+    fo.erase( boost::find( fo, n ) );
+  }
+
+  const auto old_children = children[n];
+  children[n] = new_children;
+
+  for ( const auto& f : children[n] )
+  {
+    fanouts[f.node].push_back( n );
+  }
+
+  /* if an equal gate already exists, both are merged when extracting the MIG */
+  strash.insert( {children[n], n} );
+
+  update_levels( n );
+  update_required( old_children, children[n] );
+}
+
+/* levels can only decrease, therefore a simple worklist converges */
+void mig_depth_rewriting_manager::update_levels( mig_node n )
+{
+  std::deque<mig_node> worklist( 1u, n );
+
+  while ( !worklist.empty() )
+  {
+    const auto m = worklist.front();
+    worklist.pop_front();
+
+    const auto& c = children[m];
+    const auto l = 1u + max3( level( c[0u] ), level( c[1u] ), level( c[2u] ) );
+    if ( l == levels[m] ) { continue; }
+
+    levels[m] = l;
+    worklist.insert( worklist.end(), fanouts[m].begin(), fanouts[m].end() );
+  }
+}
+
+unsigned mig_depth_rewriting_manager::required_from_fanouts( mig_node n ) const
+{
+  auto r = output[n] ? max_level : unreached;
+  for ( auto fo : fanouts[n] )
+  {
+    if ( required[fo] != unreached )
+    {
+      r = std::min( r, required[fo] - 1u );
+    }
+  }
+  return r;
+}
+
+void mig_depth_rewriting_manager::compute_required()
+{
+  boost::fill( required, unreached );
+
+  const auto order = topological_order();
+  for ( auto it = order.rbegin(); it != order.rend(); ++it )
+  {
+    required[*it] = required_from_fanouts( *it );
+  }
+}
+
+/* required times of the transitive fanin change when children are replaced;
+ * like update_levels, the worklist recomputes a node from its fanouts */
+void mig_depth_rewriting_manager::update_required( const mig_children_t& old_children, const mig_children_t& new_children )
+{
+  std::deque<mig_node> worklist;
+  for ( const auto& f : old_children ) { worklist.push_back( f.node ); }
+  for ( const auto& f : new_children ) { worklist.push_back( f.node ); }
+
+  while ( !worklist.empty() )
+  {
+    const auto m = worklist.front();
+    worklist.pop_front();
+
+    if ( !is_gate( m ) ) { continue; }
+
+    const auto r = required_from_fanouts( m );
+    if ( r == required[m] ) { continue; }
+
+    required[m] = r;
+    for ( const auto& f : children[m] )
+    {
+      worklist.push_back( f.node );
+    }
+  }
+}
+
+/* gates in the transitive fanin of the outputs, children before parents */
+std::vector<mig_node> mig_depth_rewriting_manager::topological_order() const
+{
+  std::vector<mig_node> order;
+  std::vector<bool> visited( children.size(), false );
+
+  /* iterative post-order traversal, nodes are pushed twice */
+  std::vector<std::pair<mig_node, bool>> stack;
+  for ( const auto& o : mig_info( mig ).outputs )
+  {
+    stack.push_back( std::make_pair( o.first.node, false ) );
+  }
+
+  while ( !stack.empty() )
+  {
+    const auto n = stack.back().first;
+    const auto expanded = stack.back().second;
+
+    if ( visited[n] || !is_gate( n ) )
+    {
+      stack.pop_back();
+      continue;
+    }
+
+    if ( !expanded )
+    {
+      stack.back().second = true;
+      for ( auto it = children[n].rbegin(); it != children[n].rend(); ++it )
+      {
+        if ( !visited[it->node] )
+        {
+          stack.push_back( std::make_pair( it->node, false ) );
+        }
+      }
+      continue;
+    }
+
+    stack.pop_back();
+    visited[n] = true;
+    order.push_back( n );
+  }
+
+  return order;
+}
+
+/* all nodes that lie on a path of maximum length, i.e., whose level equals
+ * their required time, ordered by increasing level */
+std::vector<mig_node> mig_depth_rewriting_manager::critical_nodes() const
+{
+  std::vector<mig_node> nodes;
+
+  for ( auto n = 0u; n < children.size(); ++n )
+  {
+    if ( is_gate( n ) && is_critical( n ) )
+    {
+      nodes.push_back( n );
+    }
+  }
+
+  boost::stable_sort( nodes, [this]( mig_node a, mig_node b ) { return levels[a] < levels[b]; } );
+  return nodes;
+}
+
+/**
+ * 〈xy〈uvz〉〉↦〈〈xyu〉〈xyv〉z〉
+ */
+bool mig_depth_rewriting_manager::try_distributivity( mig_node n )
+{
+  const auto ch = children[n];
+
+  for ( auto i = 0u; i < 3u; ++i )
+  {
+    if ( ch[i].complemented || !is_gate( ch[i].node ) ) { continue; }
+
+    const auto xy = three_without( i );
+    const auto x = ch[xy.first];
+    const auto y = ch[xy.second];
+    const auto gc = children[ch[i].node];
+
+    for ( auto j = 0u; j < 3u; ++j )
+    {
+      const auto z = gc[j];
+      if ( level( z ) < level( x ) + 2u || level( z ) < level( y ) + 2u ) { continue; }
+
+      const auto uv = three_without( j );
+      const auto u = gc[uv.first];
+      const auto v = gc[uv.second];
+
+      const auto lxy = std::max( level( x ), level( y ) );
+      const auto new_level = 1u + max3( 1u + std::max( lxy, level( u ) ), 1u + std::max( lxy, level( v ) ), level( z ) );
+      if ( new_level >= levels[n] ) { continue; }
+
+      const auto a = create_maj( x, y, u );
+      const auto b = create_maj( x, y, v );
+      if ( a.node == b.node || a.node == z.node ) { continue; }
+
+      replace_children( n, {{a, b, z}} );
+      ++distributivity_count;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * 〈xu〈yuz〉〉↦〈zu〈yux〉〉
+ */
+bool mig_depth_rewriting_manager::try_associativity( mig_node n )
+{
+  const auto ch = children[n];
+
+  for ( auto i = 0u; i < 3u; ++i )
+  {
+    if ( ch[i].complemented || !is_gate( ch[i].node ) ) { continue; }
+
+    const auto gc = children[ch[i].node];
+
+    for ( auto j = 0u; j < 3u; ++j )
+    {
+      if ( i == j ) { continue; }
+
+      const auto u = ch[j];
+      const auto x = ch[3u - i - j];
+
+      const auto it = boost::find( gc, u );
+      if ( it == gc.end() ) { continue; }
+
+      const auto yz = three_without( std::distance( gc.begin(), it ) );
+
+      for ( const auto& p : {std::make_pair( gc[yz.first], gc[yz.second] ), std::make_pair( gc[yz.second], gc[yz.first] )} )
+      {
+        const auto y = p.first;
+        const auto z = p.second;
+
+        if ( level( z ) < level( x ) + 2u ) { continue; }
+
+        const auto new_level = 1u + max3( level( z ), level( u ), 1u + max3( level( y ), level( u ), level( x ) ) );
+        if ( new_level >= levels[n] ) { continue; }
+
+        const auto t = create_maj( y, u, x );
+        if ( t.node == z.node || t.node == u.node ) { continue; }
+
+        replace_children( n, {{z, u, t}} );
+        ++associativity_count;
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+/**
+ * 〈xu〈yu'z〉〉↦〈xu〈yxz〉〉
+ */
+bool mig_depth_rewriting_manager::try_compl_associativity( mig_node n )
+{
+  const auto ch = children[n];
+
+  for ( auto i = 0u; i < 3u; ++i )
+  {
+    if ( ch[i].complemented || !is_gate( ch[i].node ) ) { continue; }
+
+    const auto gc = children[ch[i].node];
+
+    for ( auto j = 0u; j < 3u; ++j )
+    {
+      if ( i == j ) { continue; }
+
+      const auto u = ch[j];
+      const auto x = ch[3u - i - j];
+
+      const auto it = boost::find( gc, !u );
+      if ( it == gc.end() || level( u ) < level( x ) + 2u ) { continue; }
+
+      const auto yz = three_without( std::distance( gc.begin(), it ) );
+      const auto y = gc[yz.first];
+      const auto z = gc[yz.second];
+
+      const auto new_level = 1u + max3( level( x ), level( u ), 1u + max3( level( y ), level( x ), level( z ) ) );
+      if ( new_level >= levels[n] ) { continue; }
+
+      const auto t = create_maj( y, x, z );
+      if ( t.node == x.node || t.node == u.node ) { continue; }
+
+      replace_children( n, {{x, u, t}} );
+      ++compl_associativity_count;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool mig_depth_rewriting_manager::run_pass()
+{
+  const auto old_level = max_level;
+
+  compute_required();
+
+  for ( auto n : critical_nodes() )
+  {
+    /* an earlier rewrite may have taken the node off the critical paths */
+    if ( !is_critical( n ) ) { continue; }
+
+    if ( use_distributivity && try_distributivity( n ) ) { continue; }
+    if ( use_associativity && try_associativity( n ) ) { continue; }
+    if ( use_compl_associativity && try_compl_associativity( n ) ) { continue; }
+  }
+
+  max_level = 0u;
+  for ( const auto& output : mig_info( mig ).outputs )
+  {
+    max_level = std::max( max_level, level( output.first ) );
+  }
+
+  if ( verbose )
+  {
+    std::cout << boost::format( "[i] depth: %d -> %d" ) % old_level % max_level << std::endl;
+  }
+
+  return max_level < old_level;
+}
+
+mig_graph mig_depth_rewriting_manager::extract() const
+{
+  const auto& info = mig_info( mig );
+
+  mig_graph mig_new;
+  mig_initialize( mig_new, info.model_name );
+  mig_reserve( mig_new, children.size() );
+
+  auto& info_new = mig_info( mig_new );
+  info_new.constant_used = info.constant_used;
+
+  std::vector<mig_function> old_to_new( children.size() );
+  old_to_new[info.constant] = {info_new.constant, false};
+
+  for ( const auto& input : info.inputs )
+  {
+    old_to_new[input] = mig_create_pi( mig_new, info.node_names.at( input ) );
+  }
+
+  /* iterative, such that deep MIGs do not overflow the stack */
+  for ( auto n : topological_order() )
+  {
+    const auto& c = children[n];
+    old_to_new[n] = mig_create_maj( mig_new,
+                                    make_function( old_to_new[c[0u].node], c[0u].complemented ),
+                                    make_function( old_to_new[c[1u].node], c[1u].complemented ),
+                                    make_function( old_to_new[c[2u].node], c[2u].complemented ) );
+  }
+
+  for ( const auto& output : info.outputs )
+  {
+    mig_create_po( mig_new, make_function( old_to_new[output.first.node], output.first.complemented ), output.second );
+  }
+
+  return mig_new;
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+mig_graph mig_incremental_depth_rewriting( const mig_graph& mig,
+                                           const properties::ptr& settings,
+                                           const properties::ptr& statistics )
+{
+  /* settings */
+  const auto effort                   = get( settings, "effort",  0u ); /* 0u: until no gain */
+  const auto use_distributivity       = get( settings, "use_distributivity", true );
+  const auto use_associativity        = get( settings, "use_associativity", true );
+  const auto use_compl_associativity  = get( settings, "use_compl_associativity", true );
+  const auto verbose                  = get( settings, "verbose", false );
+
+  /* timer */
+  properties_timer t( statistics );
+
+  mig_depth_rewriting_manager mgr( mig, verbose );
+  mgr.use_distributivity      = use_distributivity;
+  mgr.use_associativity       = use_associativity;
+  mgr.use_compl_associativity = use_compl_associativity;
+
+  auto pass_count = 0u;
+  while ( effort == 0u || pass_count < effort )
+  {
+    ++pass_count;
+    if ( !mgr.run_pass() ) { break; }
+  }
+
+  set( statistics, "pass_count",                 pass_count );
+  set( statistics, "distributivity_count",       mgr.distributivity_count );
+  set( statistics, "associativity_count",        mgr.associativity_count );
+  set( statistics, "compl_associativity_count",  mgr.compl_associativity_count );
+
+  return mgr.extract();
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,62 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file mig_depth_rewriting.hpp
+ *
+ * @brief Incremental depth rewriting for MIGs
+ *
+ * Rewrites nodes on critical paths in-place using distributivity,
+ * associativity, and complementary associativity, while keeping node levels
+ * and required times up to date incrementally.  The MIG is only rebuilt once
+ * at the end, and passes stop as soon as the depth no longer decreases.
+ *
+ * @author agent
+ * @since  2.3
+ */
+
+#ifndef MIG_DEPTH_REWRITING_HPP
+#define MIG_DEPTH_REWRITING_HPP
+
+#include <core/properties.hpp>
+#include <classical/mig/mig.hpp>
+
+namespace cirkit
+{
+
+mig_graph mig_incremental_depth_rewriting( const mig_graph& mig,
+                                           const properties::ptr& settings = properties::ptr(),
+                                           const properties::ptr& statistics = properties::ptr() );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
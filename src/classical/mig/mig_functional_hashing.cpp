@@ -26,7 +26,9 @@
 
 #include "mig_functional_hashing.hpp"
 
+#include <future>
 #include <iostream>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -41,6 +43,7 @@
 #include <core/utils/graph_utils.hpp>
 #include <core/utils/range_utils.hpp>
 #include <core/utils/terminal.hpp>
+#include <core/utils/thread_pool.hpp>
 #include <core/utils/timer.hpp>
 #include <classical/functions/cuts/stack.hpp>
 #include <classical/functions/cuts/traits.hpp>
@@ -175,6 +178,29 @@ struct npn_hash_table_entry_t
 
 using npn_hash_table_t = std::vector<npn_hash_table_entry_t>;
 
+/* NPN hash table with its counters, in parallel mode each chunk of FFRs
+ * gets its own table, whose counters are merged into the manager's */
+struct npn_cache_t
+{
+  explicit npn_cache_t( unsigned size ) : table( size ) {}
+
+  npn_hash_table_t table;
+  double           runtime    = 0.0;
+  unsigned long    cache_hit  = 0ul;
+  unsigned long    cache_miss = 0ul;
+};
+
+/* replacement chosen for a node inside an FFR (nodes without entry are copied) */
+struct ffr_decision_t
+{
+  std::vector<mig_node>   leafs;
+  boost::dynamic_bitset<> phase;
+  std::vector<unsigned>   perm;
+  std::string             expr;
+};
+
+using ffr_decisions_t = std::map<mig_node, ffr_decision_t>;
+
 class mig_functional_hashing_manager
 {
 public:
@@ -184,7 +210,8 @@ public:
 
 private:
   int find_best_cut( const mig_node& node, const std::map<aig_node, structural_cut>& cuts,
-                     boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm, std::string& expr );
+                     boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm, std::string& expr,
+                     npn_cache_t& cache, bool verbose ) const;
 
   mig_function optimize_node( const std::vector<mig_node>& ffr_leafs, const mig_node& node,
                               const std::map<aig_node, structural_cut>& cuts );
@@ -192,7 +219,15 @@ private:
   mig_function optimize_node( const mig_node& node,
                               const std::map<aig_node, structural_cut>& cuts );
 
-  tt compute_npn( const tt& tt, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm );
+  tt compute_npn( const tt& tt, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm, npn_cache_t& cache ) const;
+
+  // top-down, parallel over FFRs
+  void run_parallel_ffrs();
+  void collect_decisions( const std::vector<mig_node>& ffr_leafs, const mig_node& node,
+                          const std::map<aig_node, structural_cut>& cuts, npn_cache_t& cache,
+                          ffr_decisions_t& decisions ) const;
+  mig_function apply_decisions( const std::vector<mig_node>& ffr_leafs, const mig_node& node,
+                                const ffr_decisions_t& decisions );
 
   bool is_fanout_free_cut( const mig_node& node, const boost::dynamic_bitset<>& cut ) const;
 
@@ -221,19 +256,19 @@ public:
   std::map<mig_node, mig_edge_vec_t> ingoing;
   std::vector<unsigned>              depths;
   unsigned                           max_depth;
-  npn_hash_table_t                   npn_table;
+  npn_cache_t                        npn_cache;
   bool                               progress;
   bool                               depth_heuristic;
   unsigned                           max_candidates = 10u;
   bool                               allow_area_inc = false;
   bool                               allow_depth_inc = false;
   bool                               sort_area_first = true;
+  bool                               parallel = false;
+  unsigned                           num_threads = 0u;
+  unsigned                           ffr_chunk_size = 256u;
   bool                               verbose;
   double                             runtime_ffr = 0.0;
   double                             runtime_cut = 0.0;
-  double                             runtime_npn = 0.0;
-  unsigned long                      cache_hit = 0ul;
-  unsigned long                      cache_miss = 0ul;
   properties::ptr                    ffr_statistics;
 };
 
@@ -247,7 +282,7 @@ mig_functional_hashing_manager::mig_functional_hashing_manager( const mig_graph&
     use_ffrs( use_ffrs ),
     top_down( top_down ),
     topsort( boost::num_vertices( mig ) ),
-    npn_table( npn_hash_table_size ),
+    npn_cache( npn_hash_table_size ),
     verbose( verbose )
 {
   mig_initialize( mig_new, info.model_name );
@@ -301,7 +336,11 @@ void mig_functional_hashing_manager::run()
 {
   if ( top_down )
   {
-    if ( use_ffrs )
+    if ( use_ffrs && parallel )
+    {
+      run_parallel_ffrs();
+    }
+    else if ( use_ffrs )
     {
       null_stream ns;
       std::ostream null_out( &ns );
@@ -382,7 +421,8 @@ void mig_functional_hashing_manager::run()
 }
 
 int mig_functional_hashing_manager::find_best_cut( const mig_node& node, const std::map<mig_node, structural_cut>& cuts,
-                                                   boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm, std::string& expr )
+                                                   boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm, std::string& expr,
+                                                   npn_cache_t& cache, bool verbose ) const
 {
   auto best_gain  = 0u;
   auto best_index = -1;
@@ -405,7 +445,7 @@ int mig_functional_hashing_manager::find_best_cut( const mig_node& node, const s
 
     boost::dynamic_bitset<> local_phase;
     std::vector<unsigned>   local_perm;
-    const auto npn = compute_npn( tt, local_phase, local_perm );
+    const auto npn = compute_npn( tt, local_phase, local_perm, cache );
 
     /* better result? */
     const auto best_area  = std::get<0>( mig_functional_hashing_constants::min_depth_mig_sizes.at( npn.to_ulong() ) );
@@ -452,7 +492,7 @@ mig_function mig_functional_hashing_manager::optimize_node( const std::vector<mi
   boost::dynamic_bitset<> phase;
   std::vector<unsigned>   perm;
   std::string             expr;
-  auto best_cut = find_best_cut( node, cuts, phase, perm, expr );
+  auto best_cut = find_best_cut( node, cuts, phase, perm, expr, npn_cache, verbose );
 
   /* there is no better realization */
   if ( best_cut == -1 )
@@ -497,7 +537,7 @@ mig_function mig_functional_hashing_manager::optimize_node( const mig_node& node
   boost::dynamic_bitset<> phase;
   std::vector<unsigned>   perm;
   std::string             expr;
-  auto best_cut = find_best_cut( node, cuts, phase, perm, expr );
+  auto best_cut = find_best_cut( node, cuts, phase, perm, expr, npn_cache, verbose );
 
   /* there is no better realization */
   if ( best_cut == -1 )
@@ -542,28 +582,28 @@ mig_function mig_functional_hashing_manager::optimize_node( const mig_node& node
   return f;
 }
 
-tt mig_functional_hashing_manager::compute_npn( const tt& tt, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm )
+tt mig_functional_hashing_manager::compute_npn( const tt& tt, boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm, npn_cache_t& cache ) const
 {
   boost::dynamic_bitset<> npn;
 
   /* compute NPN and use hash table if possible */
-  if ( !npn_table.empty() )
+  if ( !cache.table.empty() )
   {
     const auto ttu      = tt.to_ulong();
-    const auto hash_key = ttu % npn_table.size();
-    auto& entry   = npn_table[hash_key];
+    const auto hash_key = ttu % cache.table.size();
+    auto& entry   = cache.table[hash_key];
 
     if ( entry.tt == ttu )
     {
-      ++cache_hit;
+      ++cache.cache_hit;
       npn = boost::dynamic_bitset<>( 16u, entry.npn );
       perm = std::vector<unsigned>( entry.perm );
       phase = boost::dynamic_bitset<>( entry.phase );
     }
     else
     {
-      ++cache_miss;
-      increment_timer t( &runtime_npn );
+      ++cache.cache_miss;
+      increment_timer t( &cache.runtime );
       npn = exact_npn_canonization( tt, phase, perm );
 
       entry.tt    = ttu;
@@ -574,13 +614,189 @@ tt mig_functional_hashing_manager::compute_npn( const tt& tt, boost::dynamic_bit
   }
   else
   {
-    increment_timer t( &runtime_npn );
+    increment_timer t( &cache.runtime );
     npn = exact_npn_canonization( tt, phase, perm );
   }
 
   return npn;
 }
 
+void mig_functional_hashing_manager::run_parallel_ffrs()
+{
+  null_stream ns;
+  std::ostream null_out( &ns );
+  boost::progress_display show_progress( ffrs_topsort.size(), progress ? std::cout : null_out );
+
+  const auto threads = num_threads == 0u ? std::max( std::thread::hardware_concurrency(), 1u ) : num_threads;
+  const auto chunk   = std::max( ffr_chunk_size, 1u );
+  const auto window  = chunk * threads;
+
+  /* decisions only depend on the original MIG, so they are computed in
+   * parallel for a window of FFRs; the window is then applied to mig_new in
+   * topological order, which keeps the result independent of scheduling */
+  struct chunk_result_t
+  {
+    explicit chunk_result_t( unsigned npn_hash_table_size ) : cache( npn_hash_table_size ) {}
+
+    std::vector<ffr_decisions_t> decisions;
+    npn_cache_t                  cache;
+    double                       runtime_cut = 0.0;
+  };
+
+  /* nodes mapped before the parallel phase (constant and inputs); workers
+   * only read this snapshot, old_to_new is only written by this thread */
+  std::vector<bool> premapped( boost::num_vertices( mig ) );
+  for ( const auto& p : old_to_new )
+  {
+    premapped[p.first] = true;
+  }
+
+  const auto process_chunk = [this, &premapped]( unsigned begin, unsigned end ) {
+    chunk_result_t result( npn_cache.table.size() );
+    result.decisions.resize( end - begin );
+
+    for ( auto i = begin; i < end; ++i )
+    {
+      const auto& id = ffrs_topsort[i];
+
+      /* inputs and the constant are already mapped */
+      if ( premapped[id] ) { continue; }
+
+      const auto& ffr_leafs = ffrs.at( id );
+
+      boost::dynamic_bitset<> boundary( boost::num_vertices( mig ) );
+      for ( const auto& ffr_leaf : ffr_leafs )
+      {
+        boundary.set( ffr_leaf );
+      }
+
+      auto sce_settings = std::make_shared<properties>();
+      auto sce_statistics = std::make_shared<properties>();
+      sce_settings->set( "boundary", boundary );
+      sce_settings->set( "start_nodes", std::vector<mig_node>( {id} ) );
+      const auto cuts = structural_cut_enumeration( mig, 5u, sce_settings, sce_statistics );
+
+      result.runtime_cut += sce_statistics->get<double>( "runtime" );
+
+      collect_decisions( ffr_leafs, id, cuts, result.cache, result.decisions[i - begin] );
+    }
+
+    return result;
+  };
+
+  thread_pool pool( threads );
+
+  for ( auto wbegin = 0u; wbegin < ffrs_topsort.size(); wbegin += window )
+  {
+    const auto wend = std::min<unsigned>( wbegin + window, ffrs_topsort.size() );
+
+    std::vector<std::future<chunk_result_t>> futures;
+    for ( auto cbegin = wbegin; cbegin < wend; cbegin += chunk )
+    {
+      futures.push_back( pool.enqueue( process_chunk, cbegin, std::min( cbegin + chunk, wend ) ) );
+    }
+
+    auto pos = wbegin;
+    for ( auto& future : futures )
+    {
+      const auto result = future.get();
+
+      runtime_cut           += result.runtime_cut;
+      npn_cache.runtime     += result.cache.runtime;
+      npn_cache.cache_hit   += result.cache.cache_hit;
+      npn_cache.cache_miss  += result.cache.cache_miss;
+
+      for ( const auto& decisions : result.decisions )
+      {
+        ++show_progress;
+
+        const auto& id = ffrs_topsort[pos++];
+
+        L( "[i] apply ffr at " << id );
+
+        if ( old_to_new.find( id ) != old_to_new.end() ) { continue; }
+
+        old_to_new.insert( {id, apply_decisions( ffrs.at( id ), id, decisions )} );
+      }
+    }
+  }
+}
+
+void mig_functional_hashing_manager::collect_decisions( const std::vector<mig_node>& ffr_leafs, const mig_node& node,
+                                                        const std::map<aig_node, structural_cut>& cuts, npn_cache_t& cache,
+                                                        ffr_decisions_t& decisions ) const
+{
+  /* mirrors optimize_node, but only records the chosen cuts */
+  if ( boost::find( ffr_leafs, node ) != ffr_leafs.end() ) { return; }
+  if ( decisions.find( node ) != decisions.end() ) { return; }
+
+  ffr_decision_t decision;
+  const auto best_cut = find_best_cut( node, cuts, decision.phase, decision.perm, decision.expr, cache, false );
+
+  if ( best_cut == -1 )
+  {
+    for ( const auto& child : get_children( mig, node ) )
+    {
+      collect_decisions( ffr_leafs, child.node, cuts, cache, decisions );
+    }
+    return;
+  }
+
+  foreach_bit( cuts.at( node ).at( best_cut ), [&]( unsigned child ) {
+      if ( child != 0u )
+      {
+        decision.leafs.push_back( child );
+      }
+    } );
+
+  for ( const auto& child : decision.leafs )
+  {
+    collect_decisions( ffr_leafs, child, cuts, cache, decisions );
+  }
+
+  decisions.insert( {node, std::move( decision )} );
+}
+
+mig_function mig_functional_hashing_manager::apply_decisions( const std::vector<mig_node>& ffr_leafs, const mig_node& node,
+                                                              const ffr_decisions_t& decisions )
+{
+  /* node is leaf of the FFR */
+  if ( boost::find( ffr_leafs, node ) != ffr_leafs.end() )
+  {
+    return old_to_new.at( node );
+  }
+
+  const auto it = decisions.find( node );
+
+  /* there is no better realization */
+  if ( it == decisions.end() )
+  {
+    auto children = get_children( mig, node );
+    return mig_create_maj( mig_new,
+                           apply_decisions( ffr_leafs, children[0].node, decisions ) ^ children[0].complemented,
+                           apply_decisions( ffr_leafs, children[1].node, decisions ) ^ children[1].complemented,
+                           apply_decisions( ffr_leafs, children[2].node, decisions ) ^ children[2].complemented );
+  }
+
+  const auto& decision = it->second;
+
+  std::map<char, mig_function> var_to_function;
+  const auto vars = std::string( "abcd" );
+
+  const auto invperm = inv( decision.perm );
+
+  for ( auto index = 0u; index < decision.leafs.size(); ++index )
+  {
+    const auto childf = apply_decisions( ffr_leafs, decision.leafs[index], decisions );
+    var_to_function.insert( {vars[invperm[index]], decision.phase.test( index ) ? !childf : childf} );
+  }
+
+  auto mfs_settings = std::make_shared<properties>();
+  mfs_settings->set( "variable_map", var_to_function );
+
+  return make_function( mig_from_string( mig_new, decision.expr, mfs_settings ), decision.phase.test( decision.phase.size() - 1u ) );
+}
+
 bool mig_functional_hashing_manager::is_fanout_free_cut( const mig_node& node, const boost::dynamic_bitset<>& cut ) const
 {
   const auto cone = cut_cone( node, cut, mig );
@@ -722,7 +938,7 @@ void mig_functional_hashing_manager::depth_preserving_functional_hashing( const
 
         boost::dynamic_bitset<> phase;
         std::vector<unsigned>   perm;
-        const auto npn = compute_npn( tt, phase, perm );
+        const auto npn = compute_npn( tt, phase, perm, npn_cache );
 
         const auto best_area = std::get<0>( mig_functional_hashing_constants::min_depth_mig_sizes.at( npn.to_ulong() ) );
 
@@ -872,6 +1088,9 @@ mig_graph mig_functional_hashing( const mig_graph& mig,
   const auto allow_area_inc      = get( settings, "allow_area_inc",      false );
   const auto allow_depth_inc     = get( settings, "allow_depth_inc",     false );
   const auto sort_area_first     = get( settings, "sort_area_first",     true );
+  const auto parallel            = get( settings, "parallel",            false );
+  const auto num_threads         = get( settings, "num_threads",         0u );
+  const auto ffr_chunk_size      = get( settings, "ffr_chunk_size",      256u );
   const auto verbose             = get( settings, "verbose",             false );
 
   /* timing */
@@ -885,14 +1104,17 @@ mig_graph mig_functional_hashing( const mig_graph& mig,
   mgr.allow_area_inc  = allow_area_inc;
   mgr.allow_depth_inc = allow_depth_inc;
   mgr.sort_area_first = sort_area_first;
+  mgr.parallel        = parallel;
+  mgr.num_threads     = num_threads;
+  mgr.ffr_chunk_size  = ffr_chunk_size;
 
   mgr.run();
 
   set( statistics, "runtime_ffr", mgr.runtime_ffr );
   set( statistics, "runtime_cut", mgr.runtime_cut );
-  set( statistics, "runtime_npn", mgr.runtime_npn );
-  set( statistics, "cache_hit",   mgr.cache_hit );
-  set( statistics, "cache_miss",  mgr.cache_miss );
+  set( statistics, "runtime_npn", mgr.npn_cache.runtime );
+  set( statistics, "cache_hit",   mgr.npn_cache.cache_hit );
+  set( statistics, "cache_miss",  mgr.npn_cache.cache_miss );
 
   return mgr.mig_new;
 }
@@ -254,6 +254,7 @@ void mig_rewriting_manager::swap_current( const std::string& method )
 
   const auto& info_old = mig_info( mig_old );
   mig_initialize( mig_current, info_old.model_name );
+  mig_reserve( mig_current, num_vertices( mig_old ) );
 
   auto& info_current = mig_info( mig_current );
   info_current.constant_used = info_old.constant_used;
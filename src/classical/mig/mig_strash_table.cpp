@@ -0,0 +1,142 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#include "mig_strash_table.hpp"
+
+#include <cassert>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+void mig_strash_table::rehash( std::size_t new_capacity )
+{
+  assert( ( new_capacity & ( new_capacity - 1u ) ) == 0u );
+
+  std::vector<slot_t> old_slots( new_capacity, slot_t{{empty, empty, empty}, empty} );
+  old_slots.swap( slots );
+
+  const auto mask = slots.size() - 1u;
+  for ( const auto& s : old_slots )
+  {
+    if ( s.key[0] == empty ) { continue; }
+
+    auto pos = hash( s.key[0], s.key[1], s.key[2] ) & mask;
+    while ( slots[pos].key[0] != empty )
+    {
+      pos = ( pos + 1u ) & mask;
+    }
+    slots[pos] = s;
+  }
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+const mig_strash_table::literal_t mig_strash_table::empty;
+
+mig_strash_table::mig_strash_table( std::size_t num_entries )
+{
+  reserve( num_entries );
+}
+
+mig_strash_table::literal_t mig_strash_table::find( literal_t a, literal_t b, literal_t c ) const
+{
+  if ( slots.empty() ) { return empty; }
+
+  const auto mask = slots.size() - 1u;
+  auto pos = hash( a, b, c ) & mask;
+
+  while ( true )
+  {
+    const auto& s = slots[pos];
+    if ( s.key[0] == empty ) { return empty; }
+    if ( s.key[0] == a && s.key[1] == b && s.key[2] == c ) { return s.value; }
+    pos = ( pos + 1u ) & mask;
+  }
+}
+
+void mig_strash_table::insert( literal_t a, literal_t b, literal_t c, literal_t value )
+{
+  assert( a != empty );
+
+  /* keep load factor at most 1/2 */
+  if ( ( num_entries + 1u ) << 1u > slots.size() )
+  {
+    rehash( slots.empty() ? 64u : slots.size() << 1u );
+  }
+
+  const auto mask = slots.size() - 1u;
+  auto pos = hash( a, b, c ) & mask;
+
+  while ( slots[pos].key[0] != empty )
+  {
+    assert( slots[pos].key[0] != a || slots[pos].key[1] != b || slots[pos].key[2] != c );
+    pos = ( pos + 1u ) & mask;
+  }
+
+  slots[pos] = slot_t{{a, b, c}, value};
+  ++num_entries;
+}
+
+void mig_strash_table::reserve( std::size_t num_entries )
+{
+  if ( num_entries == 0u ) { return; }
+
+  auto capacity = slots.empty() ? 64u : slots.size();
+  while ( capacity < ( num_entries << 1u ) )
+  {
+    capacity <<= 1u;
+  }
+
+  if ( capacity != slots.size() )
+  {
+    rehash( capacity );
+  }
+}
+
+void mig_strash_table::clear()
+{
+  slots.clear();
+  num_entries = 0u;
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
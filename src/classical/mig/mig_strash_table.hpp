@@ -0,0 +1,103 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * @file mig_strash_table.hpp
+ *
+ * @brief Open addressing hash table for structural hashing in MIGs
+ *
+ * Keys are three packed literals (node << 1 | complement) of 32 bits each,
+ * values are packed literals.  Entries are never removed, therefore linear
+ * probing without tombstones suffices.
+ *
+ * @author agent
+ * @since  2.3
+ */
+
+#ifndef MIG_STRASH_TABLE_HPP
+#define MIG_STRASH_TABLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cirkit
+{
+
+class mig_strash_table
+{
+public:
+  using literal_t = std::uint32_t;
+
+  static const literal_t empty = ~literal_t( 0 );
+
+  explicit mig_strash_table( std::size_t num_entries = 0u );
+
+  /* returns empty if key is not contained */
+  literal_t find( literal_t a, literal_t b, literal_t c ) const;
+
+  /* key must not be contained */
+  void insert( literal_t a, literal_t b, literal_t c, literal_t value );
+
+  /* makes room for num_entries entries without rehashing */
+  void reserve( std::size_t num_entries );
+  void clear();
+
+  inline std::size_t size() const     { return num_entries; }
+  inline std::size_t capacity() const { return slots.size(); }
+
+private:
+  struct slot_t
+  {
+    literal_t key[3];
+    literal_t value;
+  };
+
+  static inline std::size_t hash( literal_t a, literal_t b, literal_t c )
+  {
+    std::uint64_t h = static_cast<std::uint64_t>( a ) * 0x9e3779b97f4a7c15ull;
+    h ^= static_cast<std::uint64_t>( b ) * 0xc2b2ae3d27d4eb4full;
+    h ^= static_cast<std::uint64_t>( c ) * 0x165667b19e3779f9ull;
+    return static_cast<std::size_t>( h ^ ( h >> 32u ) );
+  }
+
+  void rehash( std::size_t new_capacity );
+
+private:
+  std::vector<slot_t> slots;
+  std::size_t         num_entries = 0u;
+};
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
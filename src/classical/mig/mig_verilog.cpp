@@ -216,6 +216,7 @@ mig_graph read_mighty_verilog( const std::string& filename,
 
   assert( wires.size() == boost::num_vertices( wire_dependency_graph ) );
   std::vector<unsigned> topsort( wires.size() );
+  mig_reserve( mig, wires.size() );
   boost::topological_sort( wire_dependency_graph, topsort.begin() );
 
   for ( const auto& w : topsort )
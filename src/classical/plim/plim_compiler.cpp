@@ -26,16 +26,23 @@
 
 #include "plim_compiler.hpp"
 
+#include <algorithm>
+#include <future>
 #include <map>
+#include <memory>
 #include <queue>
+#include <set>
 #include <stack>
+#include <thread>
 #include <unordered_map>
 
 #include <boost/dynamic_bitset.hpp>
+#include <boost/format.hpp>
 
 #include <core/utils/graph_utils.hpp>
 #include <core/utils/range_utils.hpp>
 #include <core/utils/terminal.hpp>
+#include <core/utils/thread_pool.hpp>
 #include <core/utils/timer.hpp>
 #include <classical/functions/compute_levels.hpp>
 #include <classical/utils/memristor_costs.hpp>
@@ -62,19 +69,25 @@ template<typename IndexType>
 class auto_index_generator
 {
 public:
-  enum class request_strategy { lifo, fifo };
+  enum class request_strategy { lifo, fifo, lowest };
 
   auto_index_generator( request_strategy strategy )
-    : strategy( strategy )
+    : strategy( strategy ),
+      is_free( 1u, false )
   {
   }
 
   IndexType request()
   {
-    if ( !free.empty() )
-    {
-      IndexType index;
+    IndexType index;
 
+    if ( strategy == request_strategy::lowest && !free_lowest.empty() )
+    {
+      index = *free_lowest.begin();
+      free_lowest.erase( free_lowest.begin() );
+    }
+    else if ( !free.empty() )
+    {
       if ( strategy == request_strategy::lifo )
       {
         index = free.back();
@@ -85,24 +98,39 @@ public:
         index = free.front();
         free.pop_front();
       }
-
-      return index;
     }
     else
     {
-      return IndexType::from_index( ++max );
+      index = IndexType::from_index( ++max );
+      is_free.push_back( false );
     }
+
+    is_free[index.index()] = false;
+    return index;
   }
 
+  /* releasing an index twice would hand out the same index to two users */
   void release( IndexType i )
   {
-    free.push_back( i );
+    if ( is_free[i.index()] ) { return; }
+    is_free[i.index()] = true;
+
+    if ( strategy == request_strategy::lowest )
+    {
+      free_lowest.insert( i );
+    }
+    else
+    {
+      free.push_back( i );
+    }
   }
 
 private:
   request_strategy strategy;
   unsigned max = 0u;
   std::deque<IndexType> free;
+  std::set<IndexType> free_lowest;
+  std::vector<bool> is_free;
 };
 
 struct compilation_compare
@@ -152,6 +180,7 @@ struct compilation_compare
 
   inline unsigned fanout_count( mig_node a ) const { return _fanout_count[a]; }
   inline unsigned remove_fanout( mig_node a ) { return --_fanout_count[a]; }
+  inline unsigned releasing_fanins( mig_node a ) const { return number_of_releasing_fanins( a ); }
 
 private:
   unsigned number_of_releasing_fanins( mig_node a ) const
@@ -178,10 +207,12 @@ private:
     {
       for ( const auto& e : it->second )
       {
-        const auto parent = boost::source( e, mig );
-        const auto level = levels.at( parent );
-        min = std::min( min, level );
-        max = std::max( max, level );
+        /* parents that do not lead to an output have no level */
+        const auto it_level = levels.find( boost::source( e, mig ) );
+        if ( it_level == levels.end() ) { continue; }
+
+        min = std::min( min, it_level->second );
+        max = std::max( max, it_level->second );
       }
     }
 
@@ -215,6 +246,188 @@ inline std::pair<unsigned, unsigned> three_without( unsigned x )
   return std::make_pair( x == 0u ? 1u : 0u, x == 2u ? 1u : 2u );
 }
 
+/* one point in the space of compilation schedules */
+struct plim_schedule_t
+{
+  unsigned generator_strategy   = 0u; /* 0u: LIFO, 1u: FIFO, 2u: lowest index */
+  bool     enable_cost_function = true;
+  unsigned lookahead            = 0u;
+  double   release_weight       = 1.0;
+  double   level_weight         = 0.0;
+};
+
+/* scores candidates by the number of RRAMs they release, by how early their
+ * parents are needed, and by the (discounted) score of the parents that
+ * become ready once the candidate is computed, up to a fixed depth; scores
+ * are cached and only recomputed for candidates near the computed node */
+class lookahead_selector
+{
+public:
+  using parent_map_t = std::map<mig_node, std::vector<mig_edge>>;
+
+  lookahead_selector( const mig_graph& mig, const parent_map_t& parent_edges, const compilation_compare& cmp,
+                      const boost::dynamic_bitset<>& computed, const plim_schedule_t& schedule )
+    : mig( mig ),
+      parent_edges( parent_edges ),
+      cmp( cmp ),
+      computed( computed ),
+      schedule( schedule ),
+      urgency( num_vertices( mig ), 0.0 ),
+      scores( num_vertices( mig ), 0.0 ),
+      queued( num_vertices( mig ) ),
+      marked( num_vertices( mig ) )
+  {
+    unsigned max_level;
+    const auto levels = compute_levels( mig, max_level );
+
+    /* nodes whose first parent is on a low level are needed early, parents
+       that do not lead to an output have no level and are never urgent */
+    for ( const auto& p : parent_edges )
+    {
+      auto min = max_level;
+      for ( const auto& e : p.second )
+      {
+        const auto it = levels.find( boost::source( e, mig ) );
+        if ( it != levels.end() )
+        {
+          min = std::min( min, it->second );
+        }
+      }
+      urgency[p.first] = max_level == 0u ? 0.0 : static_cast<double>( max_level - min ) / max_level;
+    }
+  }
+
+  inline bool empty() const { return queue.empty(); }
+
+  void push( mig_node n )
+  {
+    std::vector<mig_node> assumed;
+    scores[n] = score( n, schedule.lookahead, assumed );
+    queued.set( n );
+    queue.insert( {scores[n], n} );
+  }
+
+  /* removes the best candidate and returns it */
+  mig_node pop()
+  {
+    assert( !queue.empty() );
+
+    const auto n = queue.begin()->second;
+    queue.erase( queue.begin() );
+    queued.reset( n );
+    return n;
+  }
+
+  /* node has been computed and the fanout counts of its children have been
+   * updated; this changes the score of candidates that are children,
+   * parents, or siblings of node or its children, and of all candidates that
+   * reach one of them within the lookahead depth */
+  void update( mig_node node )
+  {
+    std::vector<mig_node> affected;
+    const auto mark = [&]( mig_node n ) {
+      if ( !marked[n] ) { marked.set( n ); affected.push_back( n ); }
+    };
+    const auto mark_neighbours = [&]( mig_node n ) {
+      for ( const auto& c : boost::make_iterator_range( boost::adjacent_vertices( n, mig ) ) ) { mark( c ); }
+      const auto it = parent_edges.find( n );
+      if ( it == parent_edges.end() ) { return; }
+      for ( const auto& e : it->second )
+      {
+        const auto parent = boost::source( e, mig );
+        mark( parent );
+        for ( const auto& c : boost::make_iterator_range( boost::adjacent_vertices( parent, mig ) ) ) { mark( c ); }
+      }
+    };
+
+    mark_neighbours( node );
+    for ( const auto& c : boost::make_iterator_range( boost::adjacent_vertices( node, mig ) ) )
+    {
+      mark_neighbours( c );
+    }
+
+    /* scores include the scores of parents, so changes propagate downwards */
+    auto begin = 0u;
+    for ( auto d = 0u; d < schedule.lookahead; ++d )
+    {
+      const auto end = affected.size();
+      for ( auto i = begin; i < end; ++i )
+      {
+        for ( const auto& c : boost::make_iterator_range( boost::adjacent_vertices( affected[i], mig ) ) ) { mark( c ); }
+      }
+      begin = end;
+    }
+
+    for ( const auto& n : affected )
+    {
+      marked.reset( n );
+      if ( !queued[n] ) { continue; }
+
+      queue.erase( {scores[n], n} );
+      push( n );
+    }
+  }
+
+private:
+  double score( mig_node n, unsigned depth, std::vector<mig_node>& assumed ) const
+  {
+    auto sc = schedule.release_weight * cmp.releasing_fanins( n ) + schedule.level_weight * urgency[n];
+
+    if ( depth == 0u ) { return sc; }
+
+    const auto it = parent_edges.find( n );
+    if ( it == parent_edges.end() ) { return sc; }
+
+    assumed.push_back( n );
+    std::vector<mig_node> visited;
+    for ( const auto& e : it->second )
+    {
+      const auto parent = boost::source( e, mig );
+      if ( computed[parent] || boost::find( visited, parent ) != visited.end() ) { continue; }
+      visited.push_back( parent );
+
+      if ( is_ready( parent, assumed ) )
+      {
+        sc += 0.5 * score( parent, depth - 1u, assumed );
+      }
+    }
+    assumed.pop_back();
+
+    return sc;
+  }
+
+  bool is_ready( mig_node n, const std::vector<mig_node>& assumed ) const
+  {
+    for ( const auto& adj : boost::make_iterator_range( boost::adjacent_vertices( n, mig ) ) )
+    {
+      if ( !computed[adj] && boost::find( assumed, adj ) == assumed.end() ) { return false; }
+    }
+    return true;
+  }
+
+  /* best score first, ties are broken by the smaller node */
+  struct score_compare
+  {
+    bool operator()( const std::pair<double, mig_node>& a, const std::pair<double, mig_node>& b ) const
+    {
+      return a.first > b.first || ( a.first == b.first && a.second < b.second );
+    }
+  };
+
+private:
+  const mig_graph&               mig;
+  const parent_map_t&            parent_edges;
+  const compilation_compare&     cmp;
+  const boost::dynamic_bitset<>& computed;
+  const plim_schedule_t&         schedule;
+  std::vector<double>            urgency;
+  std::vector<double>            scores;
+  boost::dynamic_bitset<>        queued;
+  boost::dynamic_bitset<>        marked;
+
+  std::set<std::pair<double, mig_node>, score_compare> queue;
+};
+
 }
 
 namespace std
@@ -235,22 +448,15 @@ namespace cirkit
 {
 
 /******************************************************************************
- * Public functions                                                           *
+ * Private functions                                                          *
  ******************************************************************************/
 
-plim_program
-compile_for_plim( const mig_graph& mig,
-                  const properties::ptr& settings,
-                  const properties::ptr& statistics )
+static plim_program compile_with_schedule( const mig_graph& mig,
+                                           const std::map<mig_node, std::vector<mig_edge>>& parent_edges,
+                                           const plim_schedule_t& schedule,
+                                           bool verbose, bool progress )
 {
-  /* settings */
-  const auto verbose              = get( settings, "verbose", false );
-  const auto progress             = get( settings, "progress", false );
-  const auto enable_cost_function = get( settings, "enable_cost_function", true );
-  const auto generator_strategy   = get( settings, "generator_strategy", 0u ); /* 0u: LIFO, 1u: FIFO */
-
-  /* timing */
-  properties_timer t( statistics );
+  using generator_t = auto_index_generator<memristor_index>;
 
   plim_program program;
 
@@ -258,10 +464,10 @@ compile_for_plim( const mig_graph& mig,
 
   boost::dynamic_bitset<>                 computed( num_vertices( mig ) );
   std::unordered_map<mig_function, memristor_index> func_to_rram;
-  auto_index_generator<memristor_index> memristor_generator(
-      generator_strategy == 0u
-          ? auto_index_generator<memristor_index>::request_strategy::lifo
-          : auto_index_generator<memristor_index>::request_strategy::fifo );
+  generator_t memristor_generator(
+      schedule.generator_strategy == 0u
+          ? generator_t::request_strategy::lifo
+          : ( schedule.generator_strategy == 1u ? generator_t::request_strategy::fifo : generator_t::request_strategy::lowest ) );
 
   /* constant and all PIs are computed */
   computed.set( info.constant );
@@ -273,9 +479,29 @@ compile_for_plim( const mig_graph& mig,
 
   /* keep a priority queue for candidates
      invariant: candidates elements' children are all computed */
-  compilation_compare cmp( mig, enable_cost_function );
+  compilation_compare cmp( mig, schedule.enable_cost_function );
   std::priority_queue<mig_node, std::vector<mig_node>, compilation_compare> candidates( cmp );
 
+  /* with lookahead, scores change with every step and a priority queue
+     cannot be used; the selector keeps its candidates in an ordered set and
+     rescores them when a neighbour is computed */
+  std::unique_ptr<lookahead_selector> selector;
+  if ( schedule.enable_cost_function && schedule.lookahead > 0u )
+  {
+    selector.reset( new lookahead_selector( mig, parent_edges, cmp, computed, schedule ) );
+  }
+
+  const auto push_candidate = [&]( mig_node n ) {
+    if ( selector )
+    {
+      selector->push( n );
+    }
+    else
+    {
+      candidates.push( n );
+    }
+  };
+
   /* find initial candidates */
   for ( const auto& node : boost::make_iterator_range( vertices( mig ) ) )
   {
@@ -284,24 +510,30 @@ compile_for_plim( const mig_graph& mig,
 
     if ( all_children_computed( node, mig, computed ) )
     {
-      candidates.push( node );
+      push_candidate( node );
     }
   }
 
-  const auto parent_edges = precompute_ingoing_edges( mig );
-
   null_stream ns;
   std::ostream null_out( &ns );
   boost::progress_display show_progress( num_vertices( mig ), progress ? std::cout : null_out );
 
   /* synthesis loop */
-  while ( !candidates.empty() )
+  while ( !candidates.empty() || ( selector && !selector->empty() ) )
   {
     ++show_progress;
 
     /* pick the best candidate */
-    auto candidate = candidates.top();
-    candidates.pop();
+    mig_node candidate;
+    if ( selector )
+    {
+      candidate = selector->pop();
+    }
+    else
+    {
+      candidate = candidates.top();
+      candidates.pop();
+    }
 
     L( "[i] compute node " << candidate );
 
@@ -527,6 +759,11 @@ compile_for_plim( const mig_graph& mig,
 
     /* update computed and find new candidates */
     computed.set( candidate );
+    if ( selector )
+    {
+      selector->update( candidate );
+    }
+
     const auto it = parent_edges.find( candidate );
     if ( it != parent_edges.end() ) /* if it has parents */
     {
@@ -536,7 +773,7 @@ compile_for_plim( const mig_graph& mig,
 
         if ( !computed[parent] && all_children_computed( parent, mig, computed ) )
         {
-          candidates.push( parent );
+          push_candidate( parent );
         }
       }
     }
@@ -546,6 +783,116 @@ compile_for_plim( const mig_graph& mig,
        "    - dst:     " << i_dst << std::endl );
   }
 
+  return program;
+}
+
+/* a small portfolio of schedules, the first one is the default schedule */
+static std::vector<plim_schedule_t> make_schedules( const plim_schedule_t& base )
+{
+  std::vector<plim_schedule_t> schedules( 1u, base );
+
+  for ( auto strategy : {0u, 2u} )
+  {
+    for ( auto lookahead : {0u, 1u, 2u} )
+    {
+      for ( const auto& weights : std::vector<std::pair<double, double>>{{1.0, 0.0}, {1.0, 1.0}, {1.0, 4.0}} )
+      {
+        plim_schedule_t s;
+        s.generator_strategy = strategy;
+        s.lookahead          = lookahead;
+        s.release_weight     = weights.first;
+        s.level_weight       = weights.second;
+
+        /* without lookahead, weights are not used by the priority queue */
+        if ( lookahead == 0u && weights.second != 0.0 ) { continue; }
+
+        /* already covered by the default schedule */
+        if ( s.generator_strategy == base.generator_strategy && s.lookahead == base.lookahead &&
+             s.release_weight == base.release_weight && s.level_weight == base.level_weight ) { continue; }
+
+        schedules.push_back( s );
+      }
+    }
+  }
+
+  return schedules;
+}
+
+/* objective 0u: RRAM count first, 1u: step count first */
+static bool is_better( const plim_program& a, const plim_program& b, unsigned objective )
+{
+  const auto ka = objective == 0u ? std::make_pair( a.rram_count(), a.step_count() ) : std::make_pair( a.step_count(), a.rram_count() );
+  const auto kb = objective == 0u ? std::make_pair( b.rram_count(), b.step_count() ) : std::make_pair( b.step_count(), b.rram_count() );
+  return ka < kb;
+}
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+plim_program
+compile_for_plim( const mig_graph& mig,
+                  const properties::ptr& settings,
+                  const properties::ptr& statistics )
+{
+  /* settings */
+  const auto verbose     = get( settings, "verbose", false );
+  const auto progress    = get( settings, "progress", false );
+  const auto portfolio   = get( settings, "portfolio", false );
+  const auto num_threads = get( settings, "num_threads", 0u );
+  const auto objective   = get( settings, "objective", 0u ); /* 0u: RRAM count, 1u: step count */
+
+  plim_schedule_t base;
+  base.enable_cost_function = get( settings, "enable_cost_function", true );
+  base.generator_strategy   = get( settings, "generator_strategy", 0u ); /* 0u: LIFO, 1u: FIFO, 2u: lowest index */
+  base.lookahead            = get( settings, "lookahead", 0u );
+  base.release_weight       = get( settings, "release_weight", 1.0 );
+  base.level_weight         = get( settings, "level_weight", 0.0 );
+
+  /* timing */
+  properties_timer t( statistics );
+
+  const auto parent_edges = precompute_ingoing_edges( mig );
+
+  plim_program program;
+  auto best_schedule = 0u;
+
+  if ( !portfolio || !base.enable_cost_function )
+  {
+    program = compile_with_schedule( mig, parent_edges, base, verbose, progress );
+  }
+  else
+  {
+    const auto schedules = make_schedules( base );
+    const auto threads   = num_threads == 0u ? std::max( std::thread::hardware_concurrency(), 1u ) : num_threads;
+
+    std::vector<std::future<plim_program>> futures;
+    {
+      thread_pool pool( threads );
+      for ( const auto& schedule : schedules )
+      {
+        futures.push_back( pool.enqueue( compile_with_schedule, std::cref( mig ), std::cref( parent_edges ), std::cref( schedule ), false, false ) );
+      }
+
+      /* ties are broken by schedule order, which makes the result deterministic */
+      for ( auto i = 0u; i < futures.size(); ++i )
+      {
+        auto candidate = futures[i].get();
+
+        L( boost::format( "[i] schedule %2d: strategy = %d, lookahead = %d, weights = (%.1f, %.1f), steps = %d, RRAMs = %d" )
+           % i % schedules[i].generator_strategy % schedules[i].lookahead % schedules[i].release_weight % schedules[i].level_weight
+           % candidate.step_count() % candidate.rram_count() );
+
+        if ( i == 0u || is_better( candidate, program, objective ) )
+        {
+          program = std::move( candidate );
+          best_schedule = i;
+        }
+      }
+    }
+  }
+
+  set( statistics, "best_schedule", best_schedule );
   set( statistics, "step_count", (int)program.step_count() );
   set( statistics, "rram_count", (int)program.rram_count() );
 
@@ -18,7 +18,10 @@
 
 #include "abcsat.hpp"
 
+#include <algorithm>
+
 #include <core/utils/timer.hpp>
+#include <classical/sat/portfolio.hpp>
 
 namespace cirkit
 {
@@ -31,6 +34,32 @@ namespace cirkit
  * Private functions                                                          *
  ******************************************************************************/
 
+/* ABC's solver cannot be stopped from outside, therefore an interruptible
+ * solver runs in slices of conflicts and checks the flag in between */
+abc::lbool solve_with_limits( abc_solver& solver, int * begin, int * end )
+{
+  const auto budget = solver->conf_budget > 0 ? solver->conf_budget : 0;
+
+  if ( !solver->interruptible )
+  {
+    return abc::sat_solver_solve( solver->solver, begin, end, budget, 0, 0, 0 );
+  }
+
+  const auto slice = 10000;
+  auto remaining = budget;
+
+  while ( !solver->interrupted )
+  {
+    const auto limit = budget ? std::min( slice, remaining ) : slice;
+    const auto result = abc::sat_solver_solve( solver->solver, begin, end, limit, 0, 0, 0 );
+
+    if ( result != abc::l_Undef ) { return result; }
+    if ( budget && ( remaining -= limit ) == 0 ) { break; }
+  }
+
+  return abc::l_Undef;
+}
+
 /******************************************************************************
  * Public functions                                                           *
  ******************************************************************************/
@@ -39,6 +68,7 @@ template<>
 abc_solver make_solver<abc_solver>( properties::ptr settings )
 {
   std::unique_ptr<abc_solver_t> solver( new abc_solver_t );
+  solver->interruptible = get( settings, "interruptible", false );
   return solver;
 }
 
@@ -58,7 +88,7 @@ solver_result_t solve<abc_solver>( abc_solver& solver, solver_execution_statisti
 
     if ( assumptions.empty() )
     {
-      result = abc::sat_solver_solve( solver->solver, nullptr, nullptr, 0, 0, 0, 0 );
+      result = solve_with_limits( solver, nullptr, nullptr );
     }
     else
     {
@@ -77,12 +107,13 @@ solver_result_t solve<abc_solver>( abc_solver& solver, solver_execution_statisti
         lits.push_back( ( var << 1u ) | ( parsed_lit < 0 ) );
       }
 
-      result = abc::sat_solver_solve( solver->solver, &lits[0], &lits[0] + lits.size(), 0, 0, 0, 0 );
+      result = lits.empty() ? solve_with_limits( solver, nullptr, nullptr ) : solve_with_limits( solver, &lits[0], &lits[0] + lits.size() );
     }
   }
 
   statistics.num_vars    = abc::sat_solver_nvars( solver->solver );
   statistics.num_clauses = abc::sat_solver_nclauses( solver->solver );
+  statistics.limit_reached = ( result == abc::l_Undef );
 
   if ( result == abc::l_True && !solver->genmodel )
   {
@@ -114,6 +145,24 @@ void solver_gen_model<abc_solver>( abc_solver& solver, bool genmodel )
   solver->genmodel = genmodel;
 }
 
+template<>
+void solver_set_conf_budget<abc_solver>( abc_solver& solver, int budget )
+{
+  solver->conf_budget = budget;
+}
+
+template<>
+void solver_interrupt<abc_solver>( abc_solver& solver, bool interrupt )
+{
+  solver->interrupted = interrupt;
+}
+
+template<>
+std::unique_ptr<portfolio_member> make_portfolio_member<abc_solver>( const properties::ptr& settings )
+{
+  return std::unique_ptr<portfolio_member>( new portfolio_member_impl<abc_solver>( "abc", settings ) );
+}
+
 template<>
 void solver_add_blocking_var( abc_solver& solver, int var )
 {
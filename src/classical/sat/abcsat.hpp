@@ -28,6 +28,7 @@
 #ifndef ABCSAT_HPP
 #define ABCSAT_HPP
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -47,6 +48,9 @@ struct abc_solver_t
   abc::sat_solver * solver;
   std::vector<int>  blocking_vars;
   bool              genmodel = true;
+  int               conf_budget = -1;      /* -1 : unlimited */
+  bool              interruptible = false; /* solve in conflict-limited slices */
+  std::atomic<bool> interrupted{false};
 };
 
 using abc_solver = std::unique_ptr<abc_solver_t>;
@@ -93,6 +97,12 @@ solver_result_t solve<abc_solver>( abc_solver& solver, solver_execution_statisti
 template<>
 void solver_gen_model<abc_solver>( abc_solver& solver, bool genmodel );
 
+template<>
+void solver_set_conf_budget<abc_solver>( abc_solver& solver, int budget );
+
+template<>
+void solver_interrupt<abc_solver>( abc_solver& solver, bool interrupt );
+
 template<>
 void solver_add_blocking_var( abc_solver& solver, int var );
 
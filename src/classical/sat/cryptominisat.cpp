@@ -26,8 +26,11 @@
 
 #include "cryptominisat.hpp"
 
+#include <limits>
+
 #include <core/utils/range_utils.hpp>
 #include <core/utils/timer.hpp>
+#include <classical/sat/portfolio.hpp>
 
 namespace cirkit
 {
@@ -48,7 +51,7 @@ template<>
 cryptominisat_solver make_solver<cryptominisat_solver>( properties::ptr settings )
 {
   std::unique_ptr<CMSat::SATSolver> solver( new CMSat::SATSolver );
-  solver->set_num_threads( 4 );
+  solver->set_num_threads( get( settings, "num_threads", 4u ) );
   return { std::move( solver ), std::vector<int>(), true, 0, 0, -1 };
 }
 
@@ -66,11 +69,9 @@ solver_traits<cryptominisat_solver>::xor_clause_adder add_xor_clause( cryptomini
 template<>
 solver_result_t solve<cryptominisat_solver>( cryptominisat_solver& solver, solver_execution_statistics& statistics, const std::vector<int>& assumptions )
 {
-  /* budget */
-  if ( solver.conf_budget > 0 )
-  {
-    assert( false && "cryptominisat has no support for budget configurations" );
-  }
+  /* budget, CryptoMiniSat counts the conflicts of all calls */
+  const int64_t conflicts = solver.solver->get_sum_conflicts();
+  solver.solver->set_max_confl( solver.conf_budget > 0 ? conflicts + solver.conf_budget : std::numeric_limits<int64_t>::max() );
 
   {
     reference_timer t( &statistics.runtime );
@@ -89,8 +90,11 @@ solver_result_t solve<cryptominisat_solver>( cryptominisat_solver& solver, solve
 
     statistics.num_vars    = solver.solver->nVars();
     statistics.num_clauses = solver.num_clauses + solver.num_x_clauses;
+    statistics.num_conflicts = solver.solver->get_sum_conflicts() - conflicts;
 
     using CMSat::lbool;
+    statistics.limit_reached = ( result == l_Undef );
+
     if ( result == l_True && !solver.genmodel )
     {
       return solver_result_t( {boost::dynamic_bitset<>(), boost::dynamic_bitset<>(), } );
@@ -123,6 +127,28 @@ void solver_gen_model<cryptominisat_solver>( cryptominisat_solver& solver, bool
   solver.genmodel = genmodel;
 }
 
+template<>
+void solver_set_conf_budget<cryptominisat_solver>( cryptominisat_solver& solver, int budget )
+{
+  solver.conf_budget = budget;
+}
+
+template<>
+void solver_interrupt<cryptominisat_solver>( cryptominisat_solver& solver, bool interrupt )
+{
+  /* the request is reset by the next solve call */
+  if ( interrupt )
+  {
+    solver.solver->interrupt_asap();
+  }
+}
+
+template<>
+std::unique_ptr<portfolio_member> make_portfolio_member<cryptominisat_solver>( const properties::ptr& settings )
+{
+  return std::unique_ptr<portfolio_member>( new portfolio_member_impl<cryptominisat_solver>( "cryptominisat", settings ) );
+}
+
 template<>
 void solver_add_blocking_var( cryptominisat_solver& solver, int var )
 {
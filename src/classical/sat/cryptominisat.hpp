@@ -159,6 +159,12 @@ solver_result_t solve<cryptominisat_solver>( cryptominisat_solver& solver, solve
 template<>
 void solver_gen_model<cryptominisat_solver>( cryptominisat_solver& solver, bool genmodel );
 
+template<>
+void solver_set_conf_budget<cryptominisat_solver>( cryptominisat_solver& solver, int budget );
+
+template<>
+void solver_interrupt<cryptominisat_solver>( cryptominisat_solver& solver, bool interrupt );
+
 template<>
 void solver_add_blocking_var( cryptominisat_solver& solver, int var );
 
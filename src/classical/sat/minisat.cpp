@@ -28,6 +28,7 @@
 
 #include <core/utils/range_utils.hpp>
 #include <core/utils/timer.hpp>
+#include <classical/sat/portfolio.hpp>
 
 namespace cirkit
 {
@@ -61,16 +62,14 @@ solver_traits<minisat_solver>::clause_adder add_clause( minisat_solver& solver )
 template<>
 solver_result_t solve<minisat_solver>( minisat_solver& solver, solver_execution_statistics& statistics, const std::vector<int>& assumptions )
 {
-  auto result = false;
+  auto result = Minisat::lbool( (uint8_t)2 ); /* undef */
 
   {
     reference_timer t( &statistics.runtime );
 
     /* budget */
-    auto limited = false;
     if ( solver.conf_budget > 0 )
     {
-      limited = true;
       solver.solver->setConfBudget( solver.conf_budget );
     }
     else
@@ -78,43 +77,30 @@ solver_result_t solve<minisat_solver>( minisat_solver& solver, solver_execution_
       solver.solver->budgetOff();
     }
 
-    if ( assumptions.empty() )
-    {
-      if ( limited )
-      {
-        Minisat::vec<Minisat::Lit> dummy;
-        result = ( solver.solver->solveLimited( dummy ) == Minisat::lbool((uint8_t)0) );
-      }
-      else
-      {
-        result = solver.solver->solve();
-      }
-    }
-    else
+    /* solveLimited also stops when interrupted */
+    const auto nvars = solver.solver->nVars();
+    int var;
+    Minisat::vec<Minisat::Lit> lits;
+
+    for ( auto parsed_lit : assumptions )
     {
-      const auto nvars = solver.solver->nVars();
-      int var;
-      Minisat::vec<Minisat::Lit> lits( assumptions.size() );
-
-      for ( auto parsed_lit : index( assumptions ) )
-      {
-        var = abs( parsed_lit.value ) - 1;
-        if ( var >= nvars ) { continue; }
-        lits[parsed_lit.index] = ( parsed_lit.value > 0 ) ? Minisat::mkLit( var ) : ~Minisat::mkLit( var );
-      }
-      result = limited ? ( solver.solver->solveLimited( lits ) == Minisat::lbool((uint8_t)0) ) : solver.solver->solve( lits );
+      var = abs( parsed_lit ) - 1;
+      if ( var >= nvars ) { continue; }
+      lits.push( ( parsed_lit > 0 ) ? Minisat::mkLit( var ) : ~Minisat::mkLit( var ) );
     }
+    result = solver.solver->solveLimited( lits );
   }
 
   statistics.num_vars      = solver.solver->nVars();
   statistics.num_clauses   = solver.solver->nClauses();
   statistics.num_conflicts = solver.solver->conflicts;
+  statistics.limit_reached = ( result == Minisat::lbool( (uint8_t)2 ) );
 
-  if ( result && !solver.genmodel )
+  if ( result == Minisat::lbool( (uint8_t)0 ) && !solver.genmodel )
   {
     return solver_result_t( {boost::dynamic_bitset<>(), boost::dynamic_bitset<>(), } );
   }
-  else if ( result )
+  else if ( result == Minisat::lbool( (uint8_t)0 ) )
   {
     boost::dynamic_bitset<> bits( solver.solver->nVars() );
     boost::dynamic_bitset<> care( solver.solver->nVars() );
@@ -142,6 +128,31 @@ void solver_gen_model<minisat_solver>( minisat_solver& solver, bool genmodel )
   solver.genmodel = genmodel;
 }
 
+template<>
+void solver_set_conf_budget<minisat_solver>( minisat_solver& solver, int budget )
+{
+  solver.conf_budget = budget;
+}
+
+template<>
+void solver_interrupt<minisat_solver>( minisat_solver& solver, bool interrupt )
+{
+  if ( interrupt )
+  {
+    solver.solver->interrupt();
+  }
+  else
+  {
+    solver.solver->clearInterrupt();
+  }
+}
+
+template<>
+std::unique_ptr<portfolio_member> make_portfolio_member<minisat_solver>( const properties::ptr& settings )
+{
+  return std::unique_ptr<portfolio_member>( new portfolio_member_impl<minisat_solver>( "minisat", settings ) );
+}
+
 template<>
 void solver_add_blocking_var( minisat_solver& solver, int var )
 {
@@ -0,0 +1,251 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "portfolio.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include <boost/algorithm/string/split.hpp>
+#include <boost/algorithm/string/classification.hpp>
+
+#include <core/utils/timer.hpp>
+
+namespace cirkit
+{
+
+/******************************************************************************
+ * Types                                                                      *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Private functions                                                          *
+ ******************************************************************************/
+
+/******************************************************************************
+ * Public functions                                                           *
+ ******************************************************************************/
+
+template<>
+portfolio_solver make_solver<portfolio_solver>( properties::ptr settings )
+{
+  const auto members               = get( settings, "members", std::string( "minisat,abc,cryptominisat" ) );
+  const auto cryptominisat_threads = get( settings, "cryptominisat_threads", 1u );
+
+  portfolio_solver solver;
+  solver.conf_budget = get( settings, "conf_budget", -1 );
+  solver.time_budget = get( settings, "time_budget", 0.0 );
+
+  std::vector<std::string> names;
+  boost::split( names, members, boost::is_any_of( "," ), boost::token_compress_on );
+
+  for ( const auto& name : names )
+  {
+    if ( name == "minisat" )
+    {
+      solver.members.push_back( make_portfolio_member<minisat_solver>( settings ) );
+    }
+    else if ( name == "abc" )
+    {
+      auto member_settings = std::make_shared<properties>();
+      member_settings->set( "interruptible", true );
+      solver.members.push_back( make_portfolio_member<abc_solver>( member_settings ) );
+    }
+    else if ( name == "cryptominisat" )
+    {
+      auto member_settings = std::make_shared<properties>();
+      member_settings->set( "num_threads", cryptominisat_threads );
+      solver.members.push_back( make_portfolio_member<cryptominisat_solver>( member_settings ) );
+    }
+    else if ( !name.empty() )
+    {
+      std::cout << "[w] unknown portfolio member " << name << std::endl;
+    }
+  }
+
+  assert( !solver.members.empty() );
+
+  return solver;
+}
+
+template<>
+solver_traits<portfolio_solver>::clause_adder add_clause( portfolio_solver& solver )
+{
+  return solver_traits<portfolio_solver>::clause_adder( solver );
+}
+
+template<>
+solver_result_t solve<portfolio_solver>( portfolio_solver& solver, solver_execution_statistics& statistics, const std::vector<int>& assumptions )
+{
+  std::mutex mutex;
+  std::condition_variable finished;
+
+  /* both guarded by mutex */
+  std::vector<bool> cancelled( solver.members.size(), false );
+  std::vector<bool> done( solver.members.size(), false );
+
+  auto running = solver.members.size();
+  auto winner = -1;
+  solver_result_t result;
+  solver_execution_statistics winner_statistics, last_statistics;
+
+  {
+    reference_timer t( &statistics.runtime );
+
+    for ( auto& member : solver.members )
+    {
+      member->interrupt( false );
+    }
+
+    std::vector<std::thread> threads;
+    for ( auto i = 0u; i < solver.members.size(); ++i )
+    {
+      threads.emplace_back( [&, i]() {
+          solver_execution_statistics member_statistics;
+          solver_result_t member_result;
+
+          auto skip = false;
+          {
+            std::lock_guard<std::mutex> lock( mutex );
+            skip = cancelled[i];
+          }
+
+          if ( !skip )
+          {
+            member_result = solver.members[i]->solve( member_statistics, assumptions, solver.conf_budget );
+          }
+
+          std::lock_guard<std::mutex> lock( mutex );
+          --running;
+          done[i] = true;
+          if ( !skip )
+          {
+            last_statistics = member_statistics;
+          }
+          if ( !skip && winner == -1 && !member_statistics.limit_reached )
+          {
+            winner = i;
+            result = member_result;
+            winner_statistics = member_statistics;
+          }
+          finished.notify_one();
+        } );
+    }
+
+    {
+      std::unique_lock<std::mutex> lock( mutex );
+      const auto done_waiting = [&]() { return winner != -1 || running == 0u; };
+
+      if ( solver.time_budget > 0.0 )
+      {
+        finished.wait_for( lock, std::chrono::duration<double>( solver.time_budget ), done_waiting );
+      }
+      else
+      {
+        finished.wait( lock, done_waiting );
+      }
+
+      /* cancel the remaining members; a member may reset the interrupt when
+       * it enters its solve call, so the interrupt is repeated until all
+       * threads have finished */
+      std::fill( cancelled.begin(), cancelled.end(), true );
+      while ( running != 0u )
+      {
+        for ( auto i = 0u; i < solver.members.size(); ++i )
+        {
+          if ( !done[i] )
+          {
+            solver.members[i]->interrupt( true );
+          }
+        }
+        finished.wait_for( lock, std::chrono::milliseconds( 10 ), [&]() { return running == 0u; } );
+      }
+    }
+
+    for ( auto& thread : threads )
+    {
+      thread.join();
+    }
+  }
+
+  const auto& s = winner == -1 ? last_statistics : winner_statistics;
+  statistics.num_vars      = s.num_vars;
+  statistics.num_clauses   = s.num_clauses;
+  statistics.num_conflicts = s.num_conflicts;
+  statistics.limit_reached = winner == -1;
+
+  solver.winner = winner == -1 ? std::string() : solver.members[winner]->name();
+
+  return result;
+}
+
+template<>
+void solver_gen_model<portfolio_solver>( portfolio_solver& solver, bool genmodel )
+{
+  for ( auto& member : solver.members )
+  {
+    member->gen_model( genmodel );
+  }
+}
+
+template<>
+void solver_set_conf_budget<portfolio_solver>( portfolio_solver& solver, int budget )
+{
+  solver.conf_budget = budget;
+}
+
+template<>
+void solver_interrupt<portfolio_solver>( portfolio_solver& solver, bool interrupt )
+{
+  for ( auto& member : solver.members )
+  {
+    member->interrupt( interrupt );
+  }
+}
+
+template<>
+void solver_add_blocking_var( portfolio_solver& solver, int var )
+{
+  solver.blocking_vars.push_back( var );
+}
+
+template<>
+void solver_clear_blocking_vars( portfolio_solver& solver )
+{
+  solver.blocking_vars.clear();
+}
+
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,201 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file portfolio.hpp
+ *
+ * @brief Portfolio of SAT solvers running in parallel
+ *
+ * The portfolio is a solver behind the generic interface in sat_solver.hpp.
+ * Clauses are added to all members, each solve call runs the members in
+ * separate threads, and the first definite answer is returned after the
+ * other members have been interrupted.
+ *
+ * Settings for make_solver:
+ * - members (std::string, "minisat,abc,cryptominisat"): comma-separated list
+ * - cryptominisat_threads (unsigned, 1): threads of the CryptoMiniSat member
+ * - conf_budget (int, -1): conflict budget for each member and call
+ * - time_budget (double, 0.0): time budget in seconds for each call (0: unlimited)
+ *
+ * If no member answers within the budgets, the result is empty and
+ * limit_reached is set in the statistics.
+ *
+ * @author agent
+ * @since  2.3
+ */
+
+#ifndef PORTFOLIO_HPP
+#define PORTFOLIO_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <classical/sat/sat_solver.hpp>
+
+namespace cirkit
+{
+
+/* the members are implemented in the translation units of the backends,
+ * since the solver headers cannot be included together */
+struct minisat_solver;
+struct cryptominisat_solver;
+struct abc_solver_t;
+using abc_solver = std::unique_ptr<abc_solver_t>;
+
+class portfolio_member
+{
+public:
+  virtual ~portfolio_member() {}
+
+  virtual const std::string& name() const = 0;
+  virtual bool add( const clause_t& clause ) = 0;
+  virtual solver_result_t solve( solver_execution_statistics& statistics, const std::vector<int>& assumptions, int conf_budget ) = 0;
+  virtual void interrupt( bool interrupt ) = 0;
+  virtual void gen_model( bool genmodel ) = 0;
+};
+
+template<class S>
+class portfolio_member_impl : public portfolio_member
+{
+public:
+  portfolio_member_impl( const std::string& name, const properties::ptr& settings )
+    : _name( name ),
+      solver( make_solver<S>( settings ) )
+  {
+  }
+
+  const std::string& name() const { return _name; }
+
+  bool add( const clause_t& clause )
+  {
+    return add_clause( solver )( clause );
+  }
+
+  solver_result_t solve( solver_execution_statistics& statistics, const std::vector<int>& assumptions, int conf_budget )
+  {
+    solver_set_conf_budget( solver, conf_budget );
+    return cirkit::solve( solver, statistics, assumptions );
+  }
+
+  void interrupt( bool interrupt )
+  {
+    solver_interrupt( solver, interrupt );
+  }
+
+  void gen_model( bool genmodel )
+  {
+    solver_gen_model( solver, genmodel );
+  }
+
+private:
+  std::string _name;
+  S           solver;
+};
+
+template<class S>
+std::unique_ptr<portfolio_member> make_portfolio_member( const properties::ptr& settings );
+
+template<>
+std::unique_ptr<portfolio_member> make_portfolio_member<minisat_solver>( const properties::ptr& settings );
+
+template<>
+std::unique_ptr<portfolio_member> make_portfolio_member<abc_solver>( const properties::ptr& settings );
+
+template<>
+std::unique_ptr<portfolio_member> make_portfolio_member<cryptominisat_solver>( const properties::ptr& settings );
+
+struct portfolio_solver
+{
+  std::vector<std::unique_ptr<portfolio_member>> members;
+  std::vector<int>                               blocking_vars;
+  int                                            conf_budget; /* -1 : unlimited */
+  double                                         time_budget; /* 0 : unlimited */
+  std::string                                    winner;      /* member that answered the last call */
+};
+
+struct portfolio_clause_adder
+{
+  explicit portfolio_clause_adder( portfolio_solver& solver ) : solver( solver ) {}
+
+  template<typename C>
+  bool add( const C& clause )
+  {
+    clause_t lits( solver.blocking_vars );
+    lits.insert( lits.end(), clause.begin(), clause.end() );
+
+    auto result = true;
+    for ( auto& member : solver.members )
+    {
+      result = member->add( lits ) && result;
+    }
+    return result;
+  }
+
+private:
+  portfolio_solver& solver;
+};
+
+template<>
+class solver_traits<portfolio_solver>
+{
+public:
+  using clause_adder = base_clause_adder<portfolio_clause_adder>;
+};
+
+template<>
+portfolio_solver make_solver<portfolio_solver>( properties::ptr settings );
+
+template<>
+solver_traits<portfolio_solver>::clause_adder add_clause( portfolio_solver& solver );
+
+template<>
+solver_result_t solve<portfolio_solver>( portfolio_solver& solver, solver_execution_statistics& statistics, const std::vector<int>& assumptions );
+
+template<>
+void solver_gen_model<portfolio_solver>( portfolio_solver& solver, bool genmodel );
+
+template<>
+void solver_set_conf_budget<portfolio_solver>( portfolio_solver& solver, int budget );
+
+template<>
+void solver_interrupt<portfolio_solver>( portfolio_solver& solver, bool interrupt );
+
+template<>
+void solver_add_blocking_var( portfolio_solver& solver, int var );
+
+template<>
+void solver_clear_blocking_vars( portfolio_solver& solver );
+
+}
+
+#endif
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
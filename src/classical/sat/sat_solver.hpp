@@ -61,6 +61,15 @@
  *   solver_gen_model( solver, genmodel )                                     *
  *     Allows to turn off model generation, if one is only interested in the  *
  *     SAT/UNSAT answer.                                                      *
+ *                                                                            *
+ *   solver_set_conf_budget( solver, budget )                                 *
+ *     Limits the number of conflicts of each solve call (-1: unlimited).     *
+ *                                                                            *
+ *   solver_interrupt( solver, [interrupt] )                                  *
+ *     Asks a running solve call from another thread to stop as soon as       *
+ *     possible.  Call with false to clear the request before solving again.  *
+ *     If a call stops due to the budget or an interrupt, the result is       *
+ *     empty and limit_reached is set in the statistics.                      *
  ******************************************************************************/
 
 #ifndef SAT_SOLVER_HPP
@@ -94,6 +103,7 @@ struct solver_execution_statistics
   double parse_time;
   double runtime;
   uint64_t num_conflicts;
+  bool limit_reached = false;
 };
 
 template<class S>
@@ -140,6 +150,18 @@ void solver_gen_model( S& solver, bool genmodel )
   assert( false && "not implemented" );
 }
 
+template<class S>
+void solver_set_conf_budget( S& solver, int budget )
+{
+  assert( false && "not implemented" );
+}
+
+template<class S>
+void solver_interrupt( S& solver, bool interrupt = true )
+{
+  assert( false && "not implemented" );
+}
+
 template<class S>
 void solver_add_blocking_var( S& solver, int var )
 {
@@ -36,14 +36,16 @@
 #ifndef ADD_AIG_HPP
 #define ADD_AIG_HPP
 
-#include <boost/graph/depth_first_search.hpp>
-#include <boost/range/algorithm.hpp>
-#include <boost/range/algorithm_ext/iota.hpp>
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <boost/range/iterator_range.hpp>
 
 #include <core/utils/range_utils.hpp>
 
 #include <classical/aig.hpp>
-#include <classical/utils/aig_dfs.hpp>
 #include <classical/utils/aig_utils.hpp>
 
 #include <classical/sat/sat_solver.hpp>
@@ -52,67 +54,152 @@
 namespace cirkit
 {
 
+/**
+ * @brief Incremental CNF encoder for AIGs
+ *
+ * Inputs get the consecutive variables starting at sid.  Calling
+ * encode for a function adds the Tseytin clauses for the nodes in its
+ * cone of influence that have not been encoded yet and returns the
+ * corresponding literal, i.e., several queries on one solver share the
+ * encoding of common logic.  Node variables are stored in a vector
+ * indexed by the node, which grows if nodes are added to the AIG after
+ * construction.
+ *
+ * If blocking_var_map is given, each gate is encoded with blocking_and
+ * and its blocking variable is taken from the map or allocated and
+ * stored next to the gate variable.
+ */
 template<class S>
-class add_aig_visitor : public aig_dfs_visitor
+class aig_cnf_encoder
 {
 public:
-  add_aig_visitor( const aig_graph& aig, S& solver, int& sid, const std::vector<int>& piids, std::map<aig_node, int>& node_var_map, bool blocking_vars, std::map<aig_node, int>& blocking_var_map )
-    : aig_dfs_visitor( aig ),
-      solver( solver ),
-      cur_var( sid ),
-      piids( piids ),
-      node_var_map( node_var_map ),
-      blocking_vars( blocking_vars ),
-      blocking_var_map( blocking_var_map )
+  aig_cnf_encoder( S& solver, const aig_graph& aig, int sid, std::map<aig_node, int>* blocking_var_map = nullptr )
+    : solver( solver ),
+      aig( aig ),
+      sid( sid ),
+      blocking_var_map( blocking_var_map ),
+      node_to_var( boost::num_vertices( aig ), 0 )
   {
+    for ( const auto& input : aig_info( aig ).inputs )
+    {
+      node_to_var[input] = this->sid++;
+    }
   }
 
-  void finish_input( const aig_node& node, const std::string& name, const aig_graph& aig )
+  /* inputs added after construction are mapped to fresh variables on demand */
+  int input( unsigned i )
   {
-    unsigned pos = std::distance( graph_info.inputs.begin(), boost::find( graph_info.inputs, node ) );
-    node_var_map[node] = piids[pos];
+    return encode( aig_info( aig ).inputs[i] );
   }
 
-  void finish_constant( const aig_node& node, const aig_graph& aig )
+  int encode( const aig_function& f )
   {
-    node_var_map[node] = cur_var;
-    add_clause( solver )( {-cur_var} );
-    cur_var++;
+    const auto var = encode( f.node );
+    return f.complemented ? -var : var;
   }
 
-  void finish_aig_node( const aig_node& node, const aig_function& left, const aig_function& right, const aig_graph& aig )
+  /* variable of an encoded node, 0 if it has not been encoded */
+  int var( const aig_node& node ) const
   {
-    node_var_map[node] = cur_var;
-    int a = node_var_map[left.node];
-    int b = node_var_map[right.node];
-    assert( node != left.node );
-    assert( node != right.node );
-    assert( cur_var != a );
-    assert( cur_var != b );
+    return node < node_to_var.size() ? node_to_var[node] : 0;
+  }
 
-    if ( blocking_vars )
+  inline int next_var() const { return sid; }
+
+  /* a fresh variable that is not used for any node */
+  inline int new_var() { return sid++; }
+
+private:
+  int encode( const aig_node& root )
+  {
+    if ( node_to_var.size() < boost::num_vertices( aig ) )
     {
-      if ( blocking_var_map.find( node ) == blocking_var_map.end() )
-      {
-        blocking_var_map[node] = cur_var + 1u;
-      }
-      blocking_and( solver, blocking_var_map[node], left.complemented ? -a : a, right.complemented ? -b : b, cur_var );
-      cur_var += 2u;
+      node_to_var.resize( boost::num_vertices( aig ), 0 );
     }
-    else
+
+    if ( node_to_var[root] != 0 ) { return node_to_var[root]; }
+
+    /* iterative post-order traversal, nodes are pushed twice */
+    std::vector<std::pair<aig_node, bool>> stack( 1u, std::make_pair( root, false ) );
+
+    while ( !stack.empty() )
     {
-      logic_and( solver, left.complemented ? -a : a, right.complemented ? -b : b, cur_var );
-      cur_var++;
+      const auto node = stack.back().first;
+      const auto expanded = stack.back().second;
+
+      if ( node_to_var[node] != 0 )
+      {
+        stack.pop_back();
+        continue;
+      }
+
+      if ( boost::out_degree( node, aig ) == 0u )
+      {
+        /* inputs that exist at construction are already mapped */
+        node_to_var[node] = sid;
+        if ( node == aig_info( aig ).constant )
+        {
+          add_clause( solver )( {-sid} );
+        }
+        ++sid;
+        stack.pop_back();
+        continue;
+      }
+
+      if ( !expanded )
+      {
+        /* children are pushed in reverse order, such that they are numbered
+           in the same order as in a recursive depth-first search */
+        stack.back().second = true;
+        const auto size = stack.size();
+        for ( const auto& edge : boost::make_iterator_range( boost::out_edges( node, aig ) ) )
+        {
+          const auto child = boost::target( edge, aig );
+          if ( node_to_var[child] == 0 )
+          {
+            stack.push_back( std::make_pair( child, false ) );
+          }
+        }
+        std::reverse( stack.begin() + size, stack.end() );
+        continue;
+      }
+
+      stack.pop_back();
+
+      int lits[2];
+      auto i = 0u;
+      for ( const auto& edge : boost::make_iterator_range( boost::out_edges( node, aig ) ) )
+      {
+        const auto child = aig_to_function( aig, edge );
+        lits[i++] = child.complemented ? -node_to_var[child.node] : node_to_var[child.node];
+      }
+
+      node_to_var[node] = sid;
+      if ( blocking_var_map )
+      {
+        if ( blocking_var_map->find( node ) == blocking_var_map->end() )
+        {
+          ( *blocking_var_map )[node] = sid + 1;
+        }
+        blocking_and( solver, ( *blocking_var_map )[node], lits[0], lits[1], sid );
+        sid += 2;
+      }
+      else
+      {
+        logic_and( solver, lits[0], lits[1], sid );
+        ++sid;
+      }
     }
+
+    return node_to_var[root];
   }
 
-public:
+private:
   S& solver;
-  int& cur_var;
-  const std::vector<int>& piids;
-  std::map<aig_node, int>& node_var_map;
-  bool blocking_vars;
-  std::map<aig_node, int>& blocking_var_map;
+  const aig_graph& aig;
+  int sid;
+  std::map<aig_node, int>* blocking_var_map;
+  std::vector<int> node_to_var;
 };
 
 template<class S>
@@ -125,36 +212,43 @@ int add_aig( S& solver, const aig_graph& aig, int sid, std::vector<int>& piids,
   auto blocking_var_map = get( statistics, "blocking_var_map", std::map<aig_node, int>() );
 
   const auto& graph_info = aig_info( aig );
-  std::map<aig_node, int> node_var_map;
-  std::map<aig_node, boost::default_color_type> colors;
+
+  aig_cnf_encoder<S> encoder( solver, aig, sid, blocking_vars ? &blocking_var_map : nullptr );
 
   piids.resize( graph_info.inputs.size() );
   poids.resize( graph_info.outputs.size() );
 
-  boost::iota( piids, sid );
-  sid += piids.size();
+  for ( auto i = 0u; i < piids.size(); ++i )
+  {
+    piids[i] = encoder.input( i );
+  }
 
+  /* complemented outputs get a fresh variable right after their cone */
   for ( const auto& output : index( graph_info.outputs ) )
   {
-    auto node = output.value.first.node;
-    auto complement = output.value.first.complemented;
-
-    add_aig_visitor<S> visitor( aig, solver, sid, piids, node_var_map, blocking_vars, blocking_var_map );
-    boost::depth_first_visit( aig, node, visitor, boost::make_assoc_property_map( colors ) );
-
-    if ( complement )
+    const auto lit = encoder.encode( output.value.first );
+    if ( lit < 0 )
     {
-      int new_output = poids[output.index] = sid++;
-      not_equals( solver, node_var_map[node], new_output );
+      poids[output.index] = encoder.new_var();
+      not_equals( solver, -lit, poids[output.index] );
     }
     else
     {
-      poids[output.index] = node_var_map[node];
+      poids[output.index] = lit;
     }
   }
+  sid = encoder.next_var();
 
   if ( statistics )
   {
+    std::map<aig_node, int> node_var_map;
+    for ( const auto& node : boost::make_iterator_range( boost::vertices( aig ) ) )
+    {
+      if ( const auto var = encoder.var( node ) )
+      {
+        node_var_map[node] = var;
+      }
+    }
     statistics->set( "node_var_map", node_var_map );
 
     if ( blocking_vars )
@@ -26,7 +26,10 @@
 
 #include "visit_solutions.hpp"
 
+#include <stack>
+
 #include <core/utils/range_utils.hpp>
+#include <classical/utils/aig_utils.hpp>
 
 namespace cirkit
 {
@@ -39,6 +42,17 @@ namespace cirkit
  * Private functions                                                          *
  ******************************************************************************/
 
+bool simulate_node( const aig_graph& aig, const aig_node& node, std::vector<int>& values )
+{
+  if ( values[node] == -1 )
+  {
+    const auto children = get_children( aig, node );
+    values[node] = ( simulate_node( aig, children[0u].node, values ) != children[0u].complemented ) &&
+                   ( simulate_node( aig, children[1u].node, values ) != children[1u].complemented );
+  }
+  return values[node] == 1;
+}
+
 /******************************************************************************
  * Public functions                                                           *
  ******************************************************************************/
@@ -55,6 +69,64 @@ boost::dynamic_bitset<> extract_solution( const solver_result_t& result, const s
   return sol;
 }
 
+cube justify_solution( const aig_graph& aig, const aig_function& f, const boost::dynamic_bitset<>& assignment )
+{
+  const auto& info = aig_info( aig );
+
+  std::vector<int> values( boost::num_vertices( aig ), -1 );
+  values[info.constant] = 0;
+
+  std::vector<int> input_index( boost::num_vertices( aig ), -1 );
+  for ( const auto& input : index( info.inputs ) )
+  {
+    values[input.value] = assignment[input.index] ? 1 : 0;
+    input_index[input.value] = input.index;
+  }
+
+  simulate_node( aig, f.node, values );
+
+  boost::dynamic_bitset<> bits( info.inputs.size() ), care( info.inputs.size() );
+  std::vector<bool> visited( boost::num_vertices( aig ) );
+
+  std::stack<aig_node> stack;
+  stack.push( f.node );
+  visited[f.node] = true;
+
+  while ( !stack.empty() )
+  {
+    const auto node = stack.top();
+    stack.pop();
+
+    if ( input_index[node] != -1 )
+    {
+      bits[input_index[node]] = values[node] == 1;
+      care.set( input_index[node] );
+      continue;
+    }
+
+    if ( boost::out_degree( node, aig ) == 0u ) { continue; }
+
+    const auto children = get_children( aig, node );
+    if ( values[node] == 1 )
+    {
+      for ( const auto& c : children )
+      {
+        if ( !visited[c.node] ) { visited[c.node] = true; stack.push( c.node ); }
+      }
+    }
+    else
+    {
+      /* one controlling child suffices, prefer one that is justified anyway */
+      const auto ctrl0 = ( values[children[0u].node] == 1 ) == children[0u].complemented;
+      const auto ctrl1 = ( values[children[1u].node] == 1 ) == children[1u].complemented;
+      const auto& c = ( ctrl0 && ( !ctrl1 || visited[children[0u].node] || !visited[children[1u].node] ) ) ? children[0u] : children[1u];
+      if ( !visited[c.node] ) { visited[c.node] = true; stack.push( c.node ); }
+    }
+  }
+
+  return cube( bits, care );
+}
+
 }
 
 // Local Variables:
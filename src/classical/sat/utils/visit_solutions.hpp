@@ -40,6 +40,9 @@
 
 #include <boost/dynamic_bitset.hpp>
 
+#include <core/cube.hpp>
+#include <classical/aig.hpp>
+#include <classical/dd/bdd.hpp>
 #include <classical/sat/sat_solver.hpp>
 
 namespace cirkit
@@ -47,6 +50,23 @@ namespace cirkit
 
 boost::dynamic_bitset<> extract_solution( const solver_result_t& result, const std::vector<int>& vars );
 
+/**
+ * @brief Justifies the value of f under an input assignment
+ *
+ * Returns a cube over the inputs of aig which is contained in the
+ * assignment and for which f has the same value as for the
+ * assignment.  The cube is obtained by backward justification from f:
+ * both children of a true AND gate need to be justified, but only one
+ * controlling child of a false one.
+ */
+cube justify_solution( const aig_graph& aig, const aig_function& f, const boost::dynamic_bitset<>& assignment );
+
+/**
+ * Visits all solutions over vars.  Each solution is blocked by a clause
+ * guarded by the activation variable sid, which is returned as the
+ * next free variable, such that the blocking clauses are disabled when
+ * the function returns.
+ */
 template<typename Solver, typename Fn>
 int foreach_solution( Solver& solver, const std::vector<int>& vars, int sid, const Fn&& f, const std::vector<int>& assumptions = std::vector<int>() )
 {
@@ -54,6 +74,9 @@ int foreach_solution( Solver& solver, const std::vector<int>& vars, int sid, con
   std::vector<int> local_assumptions = assumptions;
   solver_execution_statistics stats;
 
+  const auto act = sid++;
+  local_assumptions.push_back( -act );
+
   while ( ( result = solve( solver, stats, local_assumptions ) ) != boost::none )
   {
     const auto solution = extract_solution( result, vars );
@@ -67,10 +90,8 @@ int foreach_solution( Solver& solver, const std::vector<int>& vars, int sid, con
     {
       blocking[i + 1u] = solution[i] ? -vars[i] : vars[i];
     }
-    blocking[0] = sid++;
+    blocking[0] = act;
     add_clause( solver )( blocking );
-
-    local_assumptions.push_back( -blocking[0] );
   }
 
   return sid;
@@ -87,6 +108,120 @@ int all_sat( Solver& solver, const std::vector<int>& vars, int sid, boost::dynam
     }, assumptions );
 }
 
+/**
+ * Visits the solutions of the AIG function f as a cover of cubes over
+ * the inputs of aig.  The solver must contain the encoding of aig
+ * (e.g., from add_aig), where piids are the input variables and fid is
+ * the variable of f.
+ *
+ * Each model is shrunk to a cube by justify_solution.  If prime is
+ * true, each remaining literal is dropped if the solver proves that
+ * the smaller cube still implies f, which makes the cube a prime
+ * implicant.  The whole cube is blocked afterwards, i.e., the number of
+ * SAT calls depends on the number of cubes rather than on the number of
+ * minterms.  Cubes are not disjoint in general.
+ *
+ * Blocking clauses are guarded by the activation variable sid as in
+ * foreach_solution.
+ */
+template<typename Solver, typename Fn>
+int foreach_cube( Solver& solver, const aig_graph& aig, const aig_function& f, const std::vector<int>& piids, int fid, int sid,
+                  const Fn&& fn, bool prime = true, const std::vector<int>& assumptions = std::vector<int>() )
+{
+  solver_result_t result;
+  std::vector<int> local_assumptions = assumptions;
+  solver_execution_statistics stats;
+
+  const auto act = sid++;
+  local_assumptions.push_back( -act );
+  local_assumptions.push_back( fid );
+
+  while ( ( result = solve( solver, stats, local_assumptions ) ) != boost::none )
+  {
+    const auto c = justify_solution( aig, f, extract_solution( result, piids ) );
+    const auto bits = c.bits();
+    auto care = c.care();
+
+    if ( prime )
+    {
+      std::vector<unsigned> lits;
+      for ( auto i = care.find_first(); i != boost::dynamic_bitset<>::npos; i = care.find_next( i ) )
+      {
+        lits.push_back( i );
+      }
+
+      for ( auto j = 0u; j < lits.size(); )
+      {
+        std::vector<int> check = assumptions;
+        check.push_back( -fid );
+        for ( auto k = 0u; k < lits.size(); ++k )
+        {
+          if ( k == j ) { continue; }
+          check.push_back( bits[lits[k]] ? piids[lits[k]] : -piids[lits[k]] );
+        }
+
+        if ( solve( solver, stats, check ) == boost::none )
+        {
+          care.reset( lits[j] );
+          lits.erase( lits.begin() + j );
+        }
+        else
+        {
+          ++j;
+        }
+      }
+    }
+
+    if ( !fn( cube( bits & care, care ) ) )
+    {
+      break;
+    }
+
+    std::vector<int> blocking( 1u, act );
+    for ( auto i = care.find_first(); i != boost::dynamic_bitset<>::npos; i = care.find_next( i ) )
+    {
+      blocking.push_back( bits[i] ? -piids[i] : piids[i] );
+    }
+    add_clause( solver )( blocking );
+  }
+
+  return sid;
+}
+
+template<typename Solver>
+int all_sat( Solver& solver, const aig_graph& aig, const aig_function& f, const std::vector<int>& piids, int fid, int sid,
+             cube_vec_t& cubes, bool prime = true, const std::vector<int>& assumptions = std::vector<int>() )
+{
+  return foreach_cube( solver, aig, f, piids, fid, sid, [&]( const cube& c ) {
+      cubes.push_back( c );
+      return true;
+    }, prime, assumptions );
+}
+
+/**
+ * Collects the solutions of f into a BDD, where input i of aig
+ * corresponds to variable i in manager.
+ */
+template<typename Solver>
+int all_sat( Solver& solver, const aig_graph& aig, const aig_function& f, const std::vector<int>& piids, int fid, int sid,
+             bdd_manager& manager, bdd& result, bool prime = true, const std::vector<int>& assumptions = std::vector<int>() )
+{
+  result = manager.bdd_bot();
+
+  return foreach_cube( solver, aig, f, piids, fid, sid, [&]( const cube& c ) {
+      auto b = manager.bdd_top();
+      for ( auto i = 0u; i < c.length(); ++i )
+      {
+        if ( c.care()[i] )
+        {
+          b = b && ( c.bits()[i] ? manager.bdd_var( i ) : !manager.bdd_var( i ) );
+        }
+      }
+      result = result || b;
+      return true;
+    }, prime, assumptions );
+}
+
 }
 
 #endif
@@ -84,6 +84,7 @@ mig_graph xmg_create_mig_topological( const xmg_graph& circ )
 {
   mig_graph mig;
   mig_initialize( mig );
+  mig_reserve( mig, circ.size() );
 
   std::vector<mig_function> node_to_function( circ.size() );
   node_to_function[0] = mig_get_constant( mig, false );
@@ -28,6 +28,8 @@
 
 #include <iostream>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <boost/format.hpp>
 
@@ -42,6 +44,18 @@ namespace cirkit
  * Private functions                                                          *
  ******************************************************************************/
 
+template<typename T>
+bool try_log_value( command::log_map_t& map, const std::string& key, const boost::any& value )
+{
+  if ( value.type() != typeid( T ) )
+  {
+    return false;
+  }
+
+  map[key] = boost::any_cast<T>( value );
+  return true;
+}
+
 /******************************************************************************
  * Public functions                                                           *
  ******************************************************************************/
@@ -57,6 +71,32 @@ bool cirkit_command::run( const std::vector<std::string>& args )
   return command::run( args );
 }
 
+command::log_opt_t cirkit_command::log_statistics() const
+{
+  if ( !statistics )
+  {
+    return boost::none;
+  }
+
+  log_map_t map;
+
+  for ( const auto& p : *statistics )
+  {
+    try_log_value<double>( map, p.first, p.second ) ||
+      try_log_value<unsigned>( map, p.first, p.second ) ||
+      try_log_value<unsigned long>( map, p.first, p.second ) ||
+      try_log_value<unsigned long long>( map, p.first, p.second ) ||
+      try_log_value<int>( map, p.first, p.second ) ||
+      try_log_value<bool>( map, p.first, p.second ) ||
+      try_log_value<std::string>( map, p.first, p.second ) ||
+      try_log_value<std::vector<unsigned>>( map, p.first, p.second ) ||
+      try_log_value<std::vector<int>>( map, p.first, p.second ) ||
+      try_log_value<std::vector<double>>( map, p.first, p.second );
+  }
+
+  return log_opt_t( map );
+}
+
 properties::ptr cirkit_command::make_settings() const
 {
   auto settings = std::make_shared<properties>();
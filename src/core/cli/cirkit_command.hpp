@@ -52,6 +52,9 @@ public:
 
   virtual bool run( const std::vector<std::string>& args );
 
+  /* all statistics of supported value types */
+  virtual log_opt_t log_statistics() const;
+
 protected:
   /* pre-defined options */
   inline void be_verbose() { opts.add_options()( "verbose,v", "be verbose" ); }
@@ -69,7 +69,8 @@ bool bdd_command::execute()
 
   if ( is_set( "characteristic" ) )
   {
-    auto bdd = bdds.current();
+    const auto& entries = env->store<bdd_function_t>();
+    const auto bdd = entries.current();
 
     if ( is_set( "new" ) )
     {
@@ -27,6 +27,7 @@
 #include "bitset_utils.hpp"
 
 #include <chrono>
+#include <cstdint>
 
 #include <boost/assign/std/vector.hpp>
 
@@ -120,6 +121,35 @@ std::string to_string( const boost::dynamic_bitset<>& b )
   return s;
 }
 
+void write_bitset_binary( std::ostream& os, const boost::dynamic_bitset<>& b )
+{
+  const std::uint64_t size = b.size();
+  std::vector<boost::dynamic_bitset<>::block_type> blocks( b.num_blocks() );
+  boost::to_block_range( b, blocks.begin() );
+
+  os.write( reinterpret_cast<const char*>( &size ), sizeof( size ) );
+  os.write( reinterpret_cast<const char*>( blocks.data() ), blocks.size() * sizeof( boost::dynamic_bitset<>::block_type ) );
+}
+
+boost::dynamic_bitset<> read_bitset_binary( std::istream& is )
+{
+  std::uint64_t size;
+  if ( !is.read( reinterpret_cast<char*>( &size ), sizeof( size ) ) )
+  {
+    throw std::string( "[e] cannot read bitset size" );
+  }
+
+  boost::dynamic_bitset<> b( size );
+  std::vector<boost::dynamic_bitset<>::block_type> blocks( b.num_blocks() );
+  if ( !is.read( reinterpret_cast<char*>( blocks.data() ), blocks.size() * sizeof( boost::dynamic_bitset<>::block_type ) ) )
+  {
+    throw std::string( "[e] cannot read bitset blocks" );
+  }
+  boost::from_block_range( blocks.begin(), blocks.end(), b );
+
+  return b;
+}
+
 }
 
 // Local Variables:
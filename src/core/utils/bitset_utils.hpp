@@ -111,6 +111,10 @@ IntType to_multiprecision( const boost::dynamic_bitset<>& bs, bool reverse = fal
 
 std::string to_string( const boost::dynamic_bitset<>& b );
 
+/* size and blocks in host byte order, reading throws a string on a short stream */
+void write_bitset_binary( std::ostream& os, const boost::dynamic_bitset<>& b );
+boost::dynamic_bitset<> read_bitset_binary( std::istream& is );
+
 }
 
 #endif
@@ -0,0 +1,148 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE add_aig
+
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <classical/aig.hpp>
+#include <classical/sat/minisat.hpp>
+#include <classical/sat/utils/add_aig.hpp>
+
+using namespace cirkit;
+
+BOOST_AUTO_TEST_CASE(incremental)
+{
+  aig_graph aig;
+  aig_initialize( aig );
+
+  const auto a = aig_create_pi( aig, "a" );
+  const auto b = aig_create_pi( aig, "b" );
+  const auto c = aig_create_pi( aig, "c" );
+
+  const auto f1 = aig_create_xor( aig, a, b );
+  const auto f2 = aig_create_and( aig, aig_create_or( aig, a, b ), !aig_create_and( aig, a, b ) );
+  const auto g  = aig_create_maj( aig, a, b, c );
+
+  auto solver = make_solver<minisat_solver>();
+  aig_cnf_encoder<minisat_solver> encoder( solver, aig, 1 );
+
+  BOOST_CHECK_EQUAL( encoder.input( 0u ), 1 );
+  BOOST_CHECK_EQUAL( encoder.input( 2u ), 3 );
+
+  /* cone of influence of f1 only */
+  const auto l1 = encoder.encode( f1 );
+  const auto after_f1 = encoder.next_var();
+  BOOST_CHECK_EQUAL( encoder.var( g.node ), 0 );
+
+  /* f2 adds its three gates */
+  const auto l2 = encoder.encode( f2 );
+  BOOST_CHECK_EQUAL( encoder.next_var(), after_f1 + 3 );
+  BOOST_CHECK( encoder.var( aig_create_and( aig, a, b ).node ) != 0 );
+
+  solver_execution_statistics stats;
+  BOOST_CHECK( solve( solver, stats, {l1, -l2} ) == boost::none );
+  BOOST_CHECK( solve( solver, stats, {-l1, l2} ) == boost::none );
+
+  /* encoding again adds nothing, nodes created later are encoded on demand */
+  const auto next = encoder.next_var();
+  BOOST_CHECK_EQUAL( encoder.encode( !f1 ), -l1 );
+  BOOST_CHECK_EQUAL( encoder.next_var(), next );
+
+  const auto h = aig_create_and( aig, g, c );
+  const auto lh = encoder.encode( h );
+  BOOST_CHECK( solve( solver, stats, {lh, -encoder.input( 2u )} ) == boost::none );
+  BOOST_CHECK( solve( solver, stats, {lh, encoder.input( 0u ), encoder.input( 1u )} ) != boost::none );
+}
+
+BOOST_AUTO_TEST_CASE(outputs)
+{
+  aig_graph aig;
+  aig_initialize( aig );
+
+  const auto a = aig_create_pi( aig, "a" );
+  const auto b = aig_create_pi( aig, "b" );
+
+  aig_create_po( aig, aig_create_and( aig, a, b ), "f" );
+  aig_create_po( aig, !aig_create_and( aig, a, b ), "g" );
+  aig_create_po( aig, aig_get_constant( aig, true ), "one" );
+
+  auto solver = make_solver<minisat_solver>();
+  std::vector<int> piids, poids;
+  const auto sid = add_aig( solver, aig, 1, piids, poids );
+
+  BOOST_CHECK_EQUAL( piids.size(), 2u );
+  BOOST_CHECK_EQUAL( poids.size(), 3u );
+
+  /* a complemented output gets a fresh variable right after its cone */
+  BOOST_CHECK_EQUAL( poids[0u], 3 );
+  BOOST_CHECK_EQUAL( poids[1u], 4 );
+  BOOST_CHECK_EQUAL( poids[2u], 6 );
+  BOOST_CHECK_EQUAL( sid, 7 );
+
+  solver_execution_statistics stats;
+  BOOST_CHECK( solve( solver, stats, {poids[0u], poids[1u]} ) == boost::none );
+  BOOST_CHECK( solve( solver, stats, {-poids[0u], -poids[1u]} ) == boost::none );
+  BOOST_CHECK( solve( solver, stats, {-poids[2u]} ) == boost::none );
+}
+
+BOOST_AUTO_TEST_CASE(late_inputs)
+{
+  aig_graph aig;
+  aig_initialize( aig );
+
+  const auto a = aig_create_pi( aig, "a" );
+
+  auto solver = make_solver<minisat_solver>();
+  aig_cnf_encoder<minisat_solver> encoder( solver, aig, 1 );
+
+  /* an input added after construction is not a constant */
+  const auto b = aig_create_pi( aig, "b" );
+  const auto lf = encoder.encode( aig_create_and( aig, a, b ) );
+
+  BOOST_CHECK_EQUAL( encoder.input( 0u ), 1 );
+  BOOST_CHECK( encoder.input( 1u ) != 0 );
+  BOOST_CHECK_EQUAL( encoder.input( 1u ), encoder.var( b.node ) );
+
+  solver_execution_statistics stats;
+  BOOST_CHECK( solve( solver, stats, {lf} ) != boost::none );
+  BOOST_CHECK( solve( solver, stats, {lf, -encoder.input( 1u )} ) == boost::none );
+
+  /* inputs can also be requested before they are used */
+  aig_create_pi( aig, "c" );
+  const auto lc = encoder.input( 2u );
+  BOOST_CHECK( solve( solver, stats, {lc} ) != boost::none );
+  BOOST_CHECK( solve( solver, stats, {-lc} ) != boost::none );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
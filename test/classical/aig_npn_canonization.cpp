@@ -0,0 +1,85 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE aig_npn_canonization
+
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/test/included/unit_test.hpp>
+
+#include <core/properties.hpp>
+#include <classical/aig.hpp>
+#include <classical/functions/aig_npn_canonization.hpp>
+
+#include "generators.h"
+
+using namespace cirkit;
+using namespace cirkit::test;
+
+BOOST_AUTO_TEST_CASE(parallel)
+{
+  for ( auto seed = 0u; seed < 5u; ++seed )
+  {
+    const auto aig = create_random_aig( 6u, 20u, seed );
+
+    for ( auto sifting = 0u; sifting < 2u; ++sifting )
+    {
+      boost::dynamic_bitset<> phase, phase_par;
+      std::vector<unsigned> perm, perm_par;
+
+      const auto settings = std::make_shared<properties>();
+      const auto statistics = std::make_shared<properties>();
+      const auto run = [&]( boost::dynamic_bitset<>& phase, std::vector<unsigned>& perm ) {
+        if ( sifting )
+        {
+          aig_npn_canonization_sifting_shared_miter( aig, phase, perm, settings, statistics );
+        }
+        else
+        {
+          aig_npn_canonization_flip_swap_shared_miter( aig, phase, perm, settings, statistics );
+        }
+      };
+
+      run( phase, perm );
+      settings->set( "num_threads", 3u );
+      run( phase_par, perm_par );
+
+      BOOST_CHECK( phase == phase_par );
+      BOOST_CHECK( perm == perm_par );
+
+      /* SAT calls of the workers overlap, their run-time is measured in wall time */
+      BOOST_CHECK( statistics->get<double>( "sat_runtime" ) <= statistics->get<double>( "runtime_wall" ) );
+    }
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
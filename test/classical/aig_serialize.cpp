@@ -0,0 +1,130 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE aig_serialize
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/range/iterator_range.hpp>
+#include <boost/test/included/unit_test.hpp>
+
+#include <classical/aig.hpp>
+#include <classical/io/aig_serialize.hpp>
+
+#include "generators.h"
+
+using namespace cirkit;
+using namespace cirkit::test;
+
+using fanins_t = std::vector<std::pair<aig_node, bool>>;
+
+fanins_t fanins( const aig_graph& aig, const aig_node& node )
+{
+  const auto& complementmap = boost::get( boost::edge_complement, aig );
+
+  fanins_t result;
+  for ( const auto& edge : boost::make_iterator_range( boost::out_edges( node, aig ) ) )
+  {
+    result.push_back( {boost::target( edge, aig ), complementmap[edge]} );
+  }
+  return result;
+}
+
+BOOST_AUTO_TEST_CASE(round_trip)
+{
+  auto aig = create_random_aig( 8u, 200u, 42u );
+
+  auto& info = boost::get_property( aig, boost::graph_name );
+  info.model_name = "random";
+  info.enable_local_optimization = false;
+  info.node_names[info.inputs.size() + 5u] = "inner";
+  info.unateness.resize( 16u );
+  info.unateness.set( 3u );
+  info.input_symmetries.push_back( {info.inputs[0u], info.inputs[1u]} );
+  info.trans_words.push_back( {info.inputs[2u], info.inputs[3u]} );
+  boost::get( boost::vertex_annotation, aig )[info.inputs.size() + 7u]["level"] = "3";
+  aig_create_lat( aig, {info.inputs[0u], true}, "l" );
+
+  std::stringstream ss;
+  write_aig_serialized( aig, ss );
+
+  aig_graph copy;
+  read_aig_serialized( copy, ss );
+
+  const auto& copy_info = boost::get_property( copy, boost::graph_name );
+
+  BOOST_REQUIRE_EQUAL( boost::num_vertices( copy ), boost::num_vertices( aig ) );
+  BOOST_CHECK_EQUAL( boost::num_edges( copy ), boost::num_edges( aig ) );
+  for ( const auto& node : boost::make_iterator_range( boost::vertices( aig ) ) )
+  {
+    BOOST_CHECK( fanins( copy, node ) == fanins( aig, node ) );
+    BOOST_CHECK_EQUAL( boost::get( boost::vertex_name, copy )[node], boost::get( boost::vertex_name, aig )[node] );
+    BOOST_CHECK( boost::get( boost::vertex_annotation, copy )[node] == boost::get( boost::vertex_annotation, aig )[node] );
+  }
+
+  BOOST_CHECK_EQUAL( copy_info.model_name, info.model_name );
+  BOOST_CHECK_EQUAL( copy_info.constant, info.constant );
+  BOOST_CHECK_EQUAL( copy_info.constant_used, info.constant_used );
+  BOOST_CHECK_EQUAL( copy_info.enable_strashing, info.enable_strashing );
+  BOOST_CHECK_EQUAL( copy_info.enable_local_optimization, info.enable_local_optimization );
+  BOOST_CHECK( copy_info.node_names == info.node_names );
+  BOOST_CHECK( copy_info.outputs == info.outputs );
+  BOOST_CHECK( copy_info.inputs == info.inputs );
+  BOOST_CHECK( copy_info.cos == info.cos );
+  BOOST_CHECK( copy_info.cis == info.cis );
+  BOOST_CHECK( copy_info.strash == info.strash );
+  BOOST_CHECK( copy_info.latch == info.latch );
+  BOOST_CHECK( copy_info.unateness == info.unateness );
+  BOOST_CHECK( copy_info.input_symmetries == info.input_symmetries );
+  BOOST_CHECK( copy_info.trans_words == info.trans_words );
+
+  /* strashing still works on the copy */
+  const auto& gate = *info.strash.begin();
+  BOOST_CHECK( aig_create_and( copy, gate.first.first, gate.first.second ) == gate.second );
+  BOOST_CHECK_EQUAL( boost::num_vertices( copy ), boost::num_vertices( aig ) );
+}
+
+BOOST_AUTO_TEST_CASE(invalid_stream)
+{
+  aig_graph aig;
+
+  std::stringstream garbage( "aag 0 0 0 0 0" );
+  BOOST_CHECK_THROW( read_aig_serialized( aig, garbage ), std::string );
+
+  std::stringstream ss;
+  write_aig_serialized( create_random_aig( 4u, 20u, 1u ), ss );
+  std::stringstream truncated( ss.str().substr( 0u, ss.str().size() / 2u ) );
+  BOOST_CHECK_THROW( read_aig_serialized( aig, truncated ), std::string );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
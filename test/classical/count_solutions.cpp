@@ -0,0 +1,115 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE count_solutions
+
+#include <random>
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <classical/dd/bdd.hpp>
+#include <classical/dd/count_solutions.hpp>
+
+using namespace cirkit;
+
+bool evaluate( bdd f, unsigned assignment )
+{
+  while ( f.index > 1u )
+  {
+    f = ( ( assignment >> f.var() ) & 1u ) ? f.high() : f.low();
+  }
+  return f.is_top();
+}
+
+BOOST_AUTO_TEST_CASE(simple)
+{
+  std::mt19937 gen( 42 );
+
+  const auto n = 10u;
+  bdd_manager mgr( n, 16u );
+
+  std::vector<bdd> fs;
+  for ( auto i = 0u; i < n; ++i )
+  {
+    fs.push_back( mgr.bdd_var( i ) );
+  }
+  fs.push_back( mgr.bdd_bot() );
+  fs.push_back( mgr.bdd_top() );
+
+  for ( auto i = 0u; i < 200u; ++i )
+  {
+    const auto a = fs[gen() % fs.size()];
+    const auto b = fs[gen() % fs.size()];
+
+    switch ( gen() % 4u )
+    {
+    case 0u: fs.push_back( a && b ); break;
+    case 1u: fs.push_back( a || b ); break;
+    case 2u: fs.push_back( a ^ b );  break;
+    case 3u: fs.push_back( !a );     break;
+    }
+  }
+
+  const auto counts = count_solutions( fs );
+  BOOST_CHECK_EQUAL( counts.size(), fs.size() );
+
+  for ( auto i = 0u; i < fs.size(); ++i )
+  {
+    auto expected = 0u;
+    for ( auto assignment = 0u; assignment < ( 1u << n ); ++assignment )
+    {
+      if ( evaluate( fs[i], assignment ) ) { ++expected; }
+    }
+
+    BOOST_CHECK_EQUAL( counts[i], expected );
+    BOOST_CHECK_EQUAL( count_solutions( fs[i] ), expected );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(wide)
+{
+  const auto n = 130u;
+  bdd_manager mgr( n, 12u );
+
+  const boost::multiprecision::uint256_t one = 1;
+
+  const auto f = mgr.bdd_var( 0u ) && !mgr.bdd_var( 129u );
+  const auto g = mgr.bdd_var( 5u ) || mgr.bdd_var( 70u );
+
+  const auto counts = count_solutions( std::vector<bdd>{ f, g, mgr.bdd_top(), mgr.bdd_bot() } );
+  BOOST_CHECK_EQUAL( counts[0u], one << 128u );
+  BOOST_CHECK_EQUAL( counts[1u], 3u * ( one << 128u ) );
+  BOOST_CHECK_EQUAL( counts[2u], one << 130u );
+  BOOST_CHECK_EQUAL( counts[3u], 0u );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,126 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE error_estimation
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <core/properties.hpp>
+#include <classical/aig.hpp>
+#include <classical/approximate/error_estimation.hpp>
+
+#include "generators.h"
+
+using namespace cirkit;
+using namespace cirkit::test;
+
+BOOST_AUTO_TEST_CASE(simple)
+{
+  const auto n = 8u, cut = 3u;
+
+  /* exact metrics */
+  auto errors = 0u, sum = 0u, max = 0u;
+  for ( auto a = 0u; a < ( 1u << n ); ++a )
+  {
+    for ( auto b = 0u; b < ( 1u << n ); ++b )
+    {
+      const auto mask = ( 1u << cut ) - 1u;
+      const auto exact = a + b;
+      const auto approx = ( ( a & mask ) + ( b & mask ) ) % ( 1u << cut ) + ( ( ( a >> cut ) + ( b >> cut ) ) << cut );
+      const auto diff = static_cast<unsigned>( std::abs( static_cast<int>( exact ) - static_cast<int>( approx ) ) );
+      if ( diff ) { ++errors; }
+      sum += diff;
+      max = std::max( max, diff );
+    }
+  }
+  const auto total = static_cast<double>( 1u << ( 2u * n ) );
+
+  const auto settings = std::make_shared<properties>();
+  settings->set( "num_threads", 2u );
+  const auto statistics = std::make_shared<properties>();
+
+  const auto est = estimate_error( create_adder( n, n ), create_adder( n, cut ), settings, statistics );
+
+  BOOST_CHECK( est.samples >= ( 1ull << 16u ) );
+  BOOST_CHECK( std::abs( est.error_rate - errors / total ) <= 2.0 * est.error_rate_width );
+  BOOST_CHECK( std::abs( est.average_case - sum / total ) <= 2.0 * est.average_case_width );
+  BOOST_CHECK_EQUAL( est.worst_case, max );
+  BOOST_CHECK( est.error_rate_width <= 0.001 );
+
+  /* same results with a different number of threads */
+  settings->set( "num_threads", 3u );
+  settings->set( "max_samples", est.samples );
+  settings->set( "min_samples", est.samples );
+  const auto est2 = estimate_error( create_adder( n, n ), create_adder( n, cut ), settings, statistics );
+  BOOST_CHECK_EQUAL( est2.samples, est.samples );
+  BOOST_CHECK_EQUAL( est2.error_rate, est.error_rate );
+
+  /* no error */
+  const auto est3 = estimate_error( create_adder( n, n ), create_adder( n, n ) );
+  BOOST_CHECK_EQUAL( est3.error_rate, 0.0 );
+  BOOST_CHECK_EQUAL( est3.average_case, 0.0 );
+  BOOST_CHECK_EQUAL( est3.worst_case, 0u );
+}
+
+BOOST_AUTO_TEST_CASE(early_stop)
+{
+  const auto n = 16u, cut = 8u;
+
+  /* loose intervals stop the simulation long before max_samples */
+  const auto settings = std::make_shared<properties>();
+  settings->set( "error_rate_width", 0.01 );
+  settings->set( "average_case_width", 0.05 );
+  settings->set( "min_samples", 1ull << 10u );
+  settings->set( "max_samples", 1ull << 24u );
+  settings->set( "block_words", 1u );
+
+  std::vector<error_estimate> estimates;
+  for ( auto num_threads : {1u, 4u, 4u} )
+  {
+    settings->set( "num_threads", num_threads );
+    estimates.push_back( estimate_error( create_adder( n, n ), create_adder( n, cut ), settings ) );
+  }
+
+  BOOST_CHECK( estimates[0u].samples < ( 1ull << 24u ) );
+  for ( const auto& est : estimates )
+  {
+    BOOST_CHECK_EQUAL( est.samples, estimates[0u].samples );
+    BOOST_CHECK_EQUAL( est.error_rate, estimates[0u].error_rate );
+    BOOST_CHECK_EQUAL( est.average_case, estimates[0u].average_case );
+    BOOST_CHECK_EQUAL( est.worst_case, estimates[0u].worst_case );
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
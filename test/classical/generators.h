@@ -0,0 +1,132 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <random>
+#include <vector>
+
+#include <boost/format.hpp>
+
+#include <classical/aig.hpp>
+#include <classical/mig/mig.hpp>
+
+namespace cirkit {
+namespace test {
+
+/* n-bit adder, where the carry into bit cut is dropped (no cut for cut = n) */
+inline aig_graph create_adder( unsigned n, unsigned cut )
+{
+  aig_graph aig;
+  aig_initialize( aig );
+
+  std::vector<aig_function> a, b;
+  for ( auto i = 0u; i < n; ++i )
+  {
+    a.push_back( aig_create_pi( aig, boost::str( boost::format( "a%d" ) % i ) ) );
+  }
+  for ( auto i = 0u; i < n; ++i )
+  {
+    b.push_back( aig_create_pi( aig, boost::str( boost::format( "b%d" ) % i ) ) );
+  }
+
+  auto carry = aig_get_constant( aig, false );
+  for ( auto i = 0u; i < n; ++i )
+  {
+    if ( i == cut ) { carry = aig_get_constant( aig, false ); }
+
+    aig_create_po( aig, aig_create_xor( aig, aig_create_xor( aig, a[i], b[i] ), carry ), boost::str( boost::format( "s%d" ) % i ) );
+    carry = aig_create_maj( aig, a[i], b[i], carry );
+  }
+  aig_create_po( aig, carry, boost::str( boost::format( "s%d" ) % n ) );
+
+  return aig;
+}
+
+/* random single-output AIG with n inputs and the given number of gates */
+inline aig_graph create_random_aig( unsigned n, unsigned gates, unsigned seed )
+{
+  std::default_random_engine gen( seed );
+  std::uniform_int_distribution<unsigned> dist( 0u, 1u );
+
+  aig_graph aig;
+  aig_initialize( aig );
+
+  std::vector<aig_function> fs;
+  for ( auto i = 0u; i < n; ++i )
+  {
+    fs.push_back( aig_create_pi( aig, boost::str( boost::format( "x%d" ) % i ) ) );
+  }
+
+  for ( auto i = 0u; i < gates; ++i )
+  {
+    std::uniform_int_distribution<unsigned> child( 0u, fs.size() - 1u );
+    const auto a = fs[child( gen )];
+    const auto b = fs[child( gen )];
+    fs.push_back( aig_create_and( aig, dist( gen ) ? !a : a, dist( gen ) ? !b : b ) );
+  }
+  aig_create_po( aig, fs.back(), "f" );
+
+  return aig;
+}
+
+/* random MIG with n inputs and the given number of gates, outputs are
+ * taken from every third of the last gates */
+inline mig_graph create_random_mig( unsigned n, unsigned gates, unsigned outputs, unsigned seed )
+{
+  std::default_random_engine gen( seed );
+  std::uniform_int_distribution<unsigned> polarity( 0u, 1u );
+
+  mig_graph mig;
+  mig_initialize( mig );
+
+  std::vector<mig_function> fs;
+  for ( auto i = 0u; i < n; ++i )
+  {
+    fs.push_back( mig_create_pi( mig, boost::str( boost::format( "x%d" ) % i ) ) );
+  }
+
+  for ( auto i = 0u; i < gates; ++i )
+  {
+    std::uniform_int_distribution<unsigned> child( 0u, fs.size() - 1u );
+    const auto a = fs[child( gen )], b = fs[child( gen )], c = fs[child( gen )];
+    fs.push_back( mig_create_maj( mig, polarity( gen ) ? !a : a, polarity( gen ) ? !b : b, polarity( gen ) ? !c : c ) );
+  }
+
+  for ( auto i = 0u; i < outputs; ++i )
+  {
+    mig_create_po( mig, fs[fs.size() - 1u - 3u * i], boost::str( boost::format( "f%d" ) % i ) );
+  }
+
+  return mig;
+}
+
+}
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,116 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE mig_depth_rewriting
+
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <core/properties.hpp>
+#include <classical/mig/mig.hpp>
+#include <classical/mig/mig_depth_rewriting.hpp>
+#include <classical/mig/mig_rewriting.hpp>
+#include <classical/mig/mig_simulate.hpp>
+#include <classical/mig/mig_utils.hpp>
+
+#include "generators.h"
+
+using namespace cirkit;
+using namespace cirkit::test;
+
+std::vector<tt> simulate( const mig_graph& mig )
+{
+  std::vector<tt> result;
+  for ( const auto& output : mig_info( mig ).outputs )
+  {
+    auto t = simulate_mig_function( mig, output.first, mig_tt_simulator() );
+    tt_extend( t, mig_info( mig ).inputs.size() );
+    result.push_back( t );
+  }
+  return result;
+}
+
+unsigned depth( const mig_graph& mig )
+{
+  unsigned max_level;
+  compute_levels( mig, max_level );
+  return max_level;
+}
+
+BOOST_AUTO_TEST_CASE(incremental)
+{
+  for ( auto seed = 0u; seed < 10u; ++seed )
+  {
+    const auto mig = create_random_mig( 6u, 80u, 4u, seed );
+    const auto expected = simulate( mig );
+
+    const auto statistics = std::make_shared<properties>();
+    const auto incremental = mig_incremental_depth_rewriting( mig, properties::ptr(), statistics );
+    const auto baseline = mig_depth_rewriting( mig );
+
+    BOOST_CHECK( simulate( incremental ) == expected );
+    BOOST_CHECK( depth( incremental ) <= depth( mig ) );
+
+    /* the old strategy does not preserve the function of every random MIG, so only compare against its sound results */
+    if ( simulate( baseline ) == expected )
+    {
+      BOOST_CHECK( depth( incremental ) <= depth( baseline ) );
+    }
+  }
+}
+
+/* the MIG is rebuilt without recursion */
+BOOST_AUTO_TEST_CASE(deep_chain)
+{
+  mig_graph mig;
+  mig_initialize( mig );
+
+  const auto a = mig_create_pi( mig, "a" );
+  const auto b = mig_create_pi( mig, "b" );
+  auto f = mig_create_pi( mig, "c" );
+  for ( auto i = 0u; i < 100000u; ++i )
+  {
+    f = mig_create_maj( mig, i % 2u ? a : b, !f, i % 3u ? a : !b );
+  }
+  mig_create_po( mig, f, "f" );
+
+  const auto expected = simulate( mig );
+
+  const auto settings = std::make_shared<properties>();
+  settings->set( "effort", 1u );
+  const auto incremental = mig_incremental_depth_rewriting( mig, settings );
+
+  BOOST_CHECK( simulate( incremental ) == expected );
+  BOOST_CHECK( depth( incremental ) <= depth( mig ) );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,93 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE mig_functional_hashing
+
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <core/properties.hpp>
+#include <classical/mig/mig.hpp>
+#include <classical/mig/mig_functional_hashing.hpp>
+#include <classical/mig/mig_simulate.hpp>
+
+#include "generators.h"
+
+using namespace cirkit;
+using namespace cirkit::test;
+
+std::vector<tt> simulate( const mig_graph& mig )
+{
+  std::vector<tt> result;
+  for ( const auto& output : mig_info( mig ).outputs )
+  {
+    auto t = simulate_mig_function( mig, output.first, mig_tt_simulator() );
+    tt_extend( t, mig_info( mig ).inputs.size() );
+    result.push_back( t );
+  }
+  return result;
+}
+
+mig_graph run( const mig_graph& mig, bool parallel, unsigned num_threads )
+{
+  const auto settings = std::make_shared<properties>();
+  settings->set( "parallel", parallel );
+  settings->set( "num_threads", num_threads );
+  settings->set( "ffr_chunk_size", 2u );
+  return mig_functional_hashing( mig, settings );
+}
+
+BOOST_AUTO_TEST_CASE(parallel_ffrs)
+{
+  for ( auto seed = 0u; seed < 5u; ++seed )
+  {
+    const auto mig = create_random_mig( 6u, 60u, 4u, seed );
+    const auto expected = simulate( mig );
+
+    const auto serial = run( mig, false, 1u );
+    const auto one    = run( mig, true, 1u );
+    const auto four   = run( mig, true, 4u );
+    const auto again  = run( mig, true, 4u );
+
+    BOOST_CHECK( simulate( serial ) == expected );
+    BOOST_CHECK( simulate( one ) == expected );
+    BOOST_CHECK( simulate( four ) == expected );
+
+    /* the parallel result does not depend on the number of threads or the schedule */
+    BOOST_CHECK_EQUAL( boost::num_vertices( one ), boost::num_vertices( four ) );
+    BOOST_CHECK_EQUAL( boost::num_edges( one ), boost::num_edges( four ) );
+    BOOST_CHECK_EQUAL( boost::num_vertices( four ), boost::num_vertices( again ) );
+    BOOST_CHECK_EQUAL( boost::num_edges( four ), boost::num_edges( again ) );
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
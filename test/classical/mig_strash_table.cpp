@@ -0,0 +1,80 @@
+#define BOOST_TEST_MODULE mig_strash_table
+
+#include <iostream>
+#include <map>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include <boost/format.hpp>
+#include <boost/test/included/unit_test.hpp>
+
+#include <core/utils/timer.hpp>
+#include <classical/mig/mig_strash_table.hpp>
+
+BOOST_AUTO_TEST_CASE(simple)
+{
+  using boost::unit_test::framework::master_test_suite;
+  using namespace cirkit;
+
+  using key_t = std::tuple<unsigned, unsigned, unsigned>;
+
+  const auto n = ( master_test_suite().argc == 2u ) ? std::stoul( master_test_suite().argv[1] ) : 1000000ul;
+
+  std::mt19937 gen( 42 );
+  std::uniform_int_distribution<unsigned> dist( 0u, 2u * n );
+
+  std::vector<key_t> keys;
+  keys.reserve( n );
+  for ( auto i = 0u; i < n; ++i )
+  {
+    keys.push_back( std::make_tuple( dist( gen ), dist( gen ), dist( gen ) ) );
+  }
+
+  std::map<key_t, unsigned> map;
+  mig_strash_table table;
+
+  double map_runtime, table_runtime;
+
+  {
+    reference_timer t( &map_runtime );
+    for ( auto i = 0u; i < n; ++i )
+    {
+      const auto it = map.find( keys[i] );
+      if ( it == map.end() )
+      {
+        map[keys[i]] = i;
+      }
+    }
+  }
+
+  {
+    reference_timer t( &table_runtime );
+    for ( auto i = 0u; i < n; ++i )
+    {
+      unsigned a, b, c;
+      std::tie( a, b, c ) = keys[i];
+      if ( table.find( a, b, c ) == mig_strash_table::empty )
+      {
+        table.insert( a, b, c, i );
+      }
+    }
+  }
+
+  BOOST_CHECK( table.size() == map.size() );
+  for ( const auto& p : map )
+  {
+    unsigned a, b, c;
+    std::tie( a, b, c ) = p.first;
+    BOOST_CHECK( table.find( a, b, c ) == p.second );
+  }
+
+  std::cout << boost::format( "[i] std::map:          %.2f secs" ) % map_runtime << std::endl
+            << boost::format( "[i] mig_strash_table:  %.2f secs" ) % table_runtime << std::endl;
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
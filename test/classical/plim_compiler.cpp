@@ -0,0 +1,126 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE plim_compiler
+
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <core/properties.hpp>
+#include <classical/mig/mig.hpp>
+#include <classical/mig/mig_simulate.hpp>
+#include <classical/plim/plim_compiler.hpp>
+
+#include "generators.h"
+
+using namespace cirkit;
+using namespace cirkit::test;
+
+/* runs the program on all input assignments at once, inputs are stored in
+ * the first RRAMs, and checks that the function of every gate is written to
+ * some RRAM (RRAMs of outputs with fanout may be reused later on) */
+bool is_valid( const mig_graph& mig, const plim_program& program )
+{
+  const auto& info = mig_info( mig );
+  const auto n = info.inputs.size();
+
+  std::vector<tt> rrams( program.rram_count() + 1u, tt( 1u << n ) );
+  for ( auto i = 0u; i < n; ++i )
+  {
+    rrams[i + 1u] = tt_nth_var( i );
+    tt_extend( rrams[i + 1u], n );
+  }
+
+  const auto value = [&]( const plim_program::operand_t& op ) -> tt {
+    if ( const auto* b = boost::get<bool>( &op ) )
+    {
+      return *b ? ~tt( 1u << n ) : tt( 1u << n );
+    }
+    return rrams[boost::get<memristor_index>( op ).index()];
+  };
+
+  std::set<tt> written;
+  for ( const auto& i : program.instructions() )
+  {
+    const auto a = value( std::get<0>( i ) );
+    const auto b = ~value( std::get<1>( i ) );
+    auto& z = rrams[std::get<2>( i ).index()];
+    z = ( a & b ) | ( a & z ) | ( b & z );
+    written.insert( z );
+  }
+
+  for ( const auto& node : boost::make_iterator_range( boost::vertices( mig ) ) )
+  {
+    if ( boost::out_degree( node, mig ) == 0u ) { continue; }
+
+    auto t = simulate_mig_function( mig, {node, false}, mig_tt_simulator() );
+    tt_extend( t, n );
+    if ( !written.count( t ) ) { return false; }
+  }
+
+  return true;
+}
+
+plim_program compile( const mig_graph& mig, unsigned lookahead, bool portfolio )
+{
+  const auto settings = std::make_shared<properties>();
+  settings->set( "lookahead", lookahead );
+  settings->set( "level_weight", 1.0 );
+  settings->set( "portfolio", portfolio );
+  settings->set( "num_threads", 2u );
+  return compile_for_plim( mig, settings );
+}
+
+BOOST_AUTO_TEST_CASE(lookahead)
+{
+  for ( auto seed = 0u; seed < 5u; ++seed )
+  {
+    const auto mig = create_random_mig( 6u, 80u, 4u, seed );
+
+    const auto baseline = compile( mig, 0u, false );
+    BOOST_CHECK( is_valid( mig, baseline ) );
+
+    for ( auto lookahead = 1u; lookahead <= 2u; ++lookahead )
+    {
+      BOOST_CHECK( is_valid( mig, compile( mig, lookahead, false ) ) );
+
+      /* the portfolio contains the given schedule and keeps the best program */
+      const auto best = compile( mig, lookahead, true );
+      BOOST_CHECK( is_valid( mig, best ) );
+      BOOST_CHECK( std::make_pair( best.rram_count(), best.step_count() ) <= std::make_pair( baseline.rram_count(), baseline.step_count() ) );
+    }
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
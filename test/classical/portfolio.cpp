@@ -0,0 +1,140 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE portfolio
+
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <core/properties.hpp>
+#include <classical/sat/portfolio.hpp>
+
+using namespace cirkit;
+
+/* variable of pigeon i in hole j */
+int pigeon_var( unsigned i, unsigned j, unsigned holes )
+{
+  return i * holes + j + 1;
+}
+
+/* n + 1 pigeons into n holes, the instance is satisfiable if extra hole is true */
+template<class S>
+int add_pigeon_hole( S& solver, unsigned n )
+{
+  const auto extra = static_cast<int>( ( n + 1u ) * n + 1u );
+
+  for ( auto i = 0u; i <= n; ++i )
+  {
+    std::vector<int> clause( 1u, extra );
+    for ( auto j = 0u; j < n; ++j )
+    {
+      clause.push_back( pigeon_var( i, j, n ) );
+    }
+    add_clause( solver )( clause );
+  }
+
+  for ( auto j = 0u; j < n; ++j )
+  {
+    for ( auto i1 = 0u; i1 <= n; ++i1 )
+    {
+      for ( auto i2 = i1 + 1u; i2 <= n; ++i2 )
+      {
+        add_clause( solver )( {-pigeon_var( i1, j, n ), -pigeon_var( i2, j, n )} );
+      }
+    }
+  }
+
+  return extra;
+}
+
+BOOST_AUTO_TEST_CASE(simple)
+{
+  for ( const auto& members : {"minisat", "minisat,abc,cryptominisat", "abc,cryptominisat"} )
+  {
+    const auto settings = std::make_shared<properties>();
+    settings->set( "members", std::string( members ) );
+
+    auto solver = make_solver<portfolio_solver>( settings );
+    const auto extra = add_pigeon_hole( solver, 4u );
+
+    solver_execution_statistics stats;
+    BOOST_CHECK( solve( solver, stats, {-extra} ) == boost::none );
+    BOOST_CHECK( !stats.limit_reached );
+    BOOST_CHECK( !solver.winner.empty() );
+
+    const auto result = solve( solver, stats, {extra} );
+    BOOST_CHECK( result != boost::none );
+    BOOST_CHECK( result->first[extra - 1] );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(budget)
+{
+  const auto settings = std::make_shared<properties>();
+  settings->set( "members", std::string( "minisat,minisat" ) );
+  settings->set( "conf_budget", 1 );
+
+  auto solver = make_solver<portfolio_solver>( settings );
+  BOOST_CHECK_EQUAL( solver.members.size(), 2u );
+
+  const auto extra = add_pigeon_hole( solver, 6u );
+
+  solver_execution_statistics stats;
+  BOOST_CHECK( solve( solver, stats, {-extra} ) == boost::none );
+  BOOST_CHECK( stats.limit_reached );
+  BOOST_CHECK( solver.winner.empty() );
+
+  solver_set_conf_budget( solver, -1 );
+  BOOST_CHECK( solve( solver, stats, {extra} ) != boost::none );
+  BOOST_CHECK( !stats.limit_reached );
+}
+
+BOOST_AUTO_TEST_CASE(time_budget)
+{
+  const auto settings = std::make_shared<properties>();
+  settings->set( "members", std::string( "minisat,abc,cryptominisat" ) );
+  settings->set( "time_budget", 0.001 );
+
+  auto solver = make_solver<portfolio_solver>( settings );
+  const auto extra = add_pigeon_hole( solver, 10u );
+
+  /* members may be cancelled before they enter their solve call */
+  for ( auto i = 0u; i < 20u; ++i )
+  {
+    solver_execution_statistics stats;
+    BOOST_CHECK( solve( solver, stats, {-extra} ) == boost::none );
+    BOOST_CHECK( stats.limit_reached );
+    BOOST_CHECK( stats.runtime < 5.0 );
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,125 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE visit_solutions
+
+#include <vector>
+
+#include <boost/format.hpp>
+#include <boost/test/included/unit_test.hpp>
+
+#include <classical/aig.hpp>
+#include <classical/dd/bdd.hpp>
+#include <classical/sat/minisat.hpp>
+#include <classical/sat/utils/add_aig.hpp>
+#include <classical/sat/utils/visit_solutions.hpp>
+
+using namespace cirkit;
+
+/* x0 x1 + x2 x3 + ... */
+aig_graph create_sum_of_products( unsigned n )
+{
+  aig_graph aig;
+  aig_initialize( aig );
+
+  std::vector<aig_function> xs;
+  for ( auto i = 0u; i < 2u * n; ++i )
+  {
+    xs.push_back( aig_create_pi( aig, boost::str( boost::format( "x%d" ) % i ) ) );
+  }
+
+  auto f = aig_get_constant( aig, false );
+  for ( auto i = 0u; i < n; ++i )
+  {
+    f = aig_create_or( aig, f, aig_create_and( aig, xs[2u * i], xs[2u * i + 1u] ) );
+  }
+  aig_create_po( aig, f, "f" );
+
+  return aig;
+}
+
+BOOST_AUTO_TEST_CASE(simple)
+{
+  const auto n = 10u;
+  const auto aig = create_sum_of_products( n );
+  const auto& f = aig_info( aig ).outputs.front().first;
+
+  /* cubes */
+  {
+    auto solver = make_solver<minisat_solver>();
+    std::vector<int> piids, poids;
+    const auto sid = add_aig( solver, aig, 1, piids, poids );
+
+    cube_vec_t cubes;
+    all_sat( solver, aig, f, piids, poids.front(), sid, cubes );
+
+    BOOST_CHECK_EQUAL( cubes.size(), n );
+    for ( const auto& c : cubes )
+    {
+      BOOST_CHECK_EQUAL( c.dimension(), 2u );
+    }
+  }
+
+  /* BDD */
+  {
+    auto solver = make_solver<minisat_solver>();
+    std::vector<int> piids, poids;
+    const auto sid = add_aig( solver, aig, 1, piids, poids );
+
+    bdd_manager manager( 2u * n, 16u );
+    bdd result;
+    all_sat( solver, aig, f, piids, poids.front(), sid, manager, result, false );
+
+    auto expected = manager.bdd_bot();
+    for ( auto i = 0u; i < n; ++i )
+    {
+      expected = expected || ( manager.bdd_var( 2u * i ) && manager.bdd_var( 2u * i + 1u ) );
+    }
+    BOOST_CHECK( result.equals( expected ) );
+  }
+
+  /* minterms are still enumerated without blocking clauses remaining active */
+  {
+    const auto small = create_sum_of_products( 2u );
+    auto solver = make_solver<minisat_solver>();
+    std::vector<int> piids, poids;
+    auto sid = add_aig( solver, small, 1, piids, poids );
+
+    for ( auto k = 0u; k < 2u; ++k )
+    {
+      boost::dynamic_bitset<> tt;
+      sid = all_sat( solver, piids, sid, tt, {poids.front()} );
+      BOOST_CHECK_EQUAL( tt.count(), 7u );
+    }
+  }
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
@@ -0,0 +1,77 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE worst_case
+
+#include <cstdlib>
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <core/properties.hpp>
+#include <classical/aig.hpp>
+#include <classical/approximate/worst_case.hpp>
+
+#include "generators.h"
+
+using namespace cirkit;
+using namespace cirkit::test;
+
+BOOST_AUTO_TEST_CASE(simple)
+{
+  const auto n = 6u;
+
+  for ( auto cut = 1u; cut < n; ++cut )
+  {
+    auto max = 0u;
+    for ( auto a = 0u; a < ( 1u << n ); ++a )
+    {
+      for ( auto b = 0u; b < ( 1u << n ); ++b )
+      {
+        const auto mask = ( 1u << cut ) - 1u;
+        const auto exact = a + b;
+        const auto approx = ( ( a & mask ) + ( b & mask ) ) % ( 1u << cut ) + ( ( ( a >> cut ) + ( b >> cut ) ) << cut );
+        max = std::max( max, static_cast<unsigned>( std::abs( static_cast<int>( exact ) - static_cast<int>( approx ) ) ) );
+      }
+    }
+
+    const auto statistics = std::make_shared<properties>();
+    const auto wc = worst_case_native( create_adder( n, n ), create_adder( n, cut ), properties::ptr(), statistics );
+
+    BOOST_CHECK_EQUAL( wc, max );
+    BOOST_CHECK( statistics->get<unsigned>( "sat_calls" ) <= n + 2u );
+  }
+
+  /* no error */
+  BOOST_CHECK_EQUAL( worst_case_native( create_adder( n, n ), create_adder( n, n ) ), 0u );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
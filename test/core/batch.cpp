@@ -0,0 +1,170 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE batch
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/included/unit_test.hpp>
+
+#include <alice/alice.hpp>
+
+namespace alice
+{
+
+struct counter_t
+{
+  unsigned value = 0u;
+};
+
+template<>
+struct store_info<counter_t>
+{
+  static constexpr const char* key         = "counters";
+  static constexpr const char* option      = "counter";
+  static constexpr const char* mnemonic    = "";
+  static constexpr const char* name        = "counter";
+  static constexpr const char* name_plural = "counters";
+};
+
+}
+
+using namespace alice;
+
+/* reads a number from a file into a new counter */
+class load_command : public command
+{
+public:
+  load_command( const environment::ptr& env ) : command( env, "Load counter" )
+  {
+    add_positional_option( "filename" );
+    opts.add_options()
+      ( "filename", po::value( &filename ), "filename" )
+      ;
+  }
+
+protected:
+  bool execute()
+  {
+    std::ifstream in( filename.c_str() );
+    if ( !in.good() ) { return false; }
+
+    auto& store = env->store<counter_t>();
+    store.extend();
+    in >> store.current().value;
+    return true;
+  }
+
+public:
+  log_opt_t log() const
+  {
+    return log_opt_t({{"value", env->store<counter_t>().current().value}});
+  }
+
+private:
+  std::string filename;
+};
+
+BOOST_AUTO_TEST_CASE(designs)
+{
+  namespace fs = boost::filesystem;
+
+  const auto dir = fs::temp_directory_path() / fs::unique_path();
+  fs::create_directories( dir );
+
+  const auto list = ( dir / "designs" ).string();
+  const auto log  = ( dir / "log.json" ).string();
+  const auto prof = ( dir / "profile.jsonl" ).string();
+  {
+    std::ofstream os( list.c_str() );
+    for ( auto i = 0u; i < 8u; ++i )
+    {
+      const auto design = ( dir / ( "d" + std::to_string( i ) + ".txt" ) ).string();
+      std::ofstream( design.c_str() ) << 10u * i;
+      os << design << std::endl;
+    }
+    os << ( dir / "missing.txt" ).string() << std::endl;
+  }
+
+  cli_main<counter_t> cli( "test" );
+  cli.insert_command( "load", cli.make_factory<load_command>() );
+
+  std::vector<std::string> args = {"test", "-b", list, "-j", "3", "-l", log, "-p", prof, "-c", "load {}; load {.}.txt"};
+  std::vector<char*> argv;
+  for ( auto& a : args )
+  {
+    argv.push_back( &a[0] );
+  }
+
+  /* one design is missing */
+  BOOST_CHECK_EQUAL( cli.run( argv.size(), &argv[0] ), 1 );
+
+  /* the main environment is not touched */
+  BOOST_CHECK( cli.env->store<counter_t>().empty() );
+
+  std::ifstream in( log.c_str() );
+  const std::string content( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() );
+
+  /* the profile has the records of all designs */
+  std::vector<std::string> records;
+  {
+    std::ifstream pin( prof.c_str() );
+    std::string line;
+    while ( getline( pin, line ) )
+    {
+      records.push_back( line );
+    }
+  }
+  fs::remove_all( dir );
+
+  BOOST_CHECK_EQUAL( records.size(), 17u );
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    const auto design = ( dir / ( "d" + std::to_string( i ) + ".txt" ) ).string();
+    BOOST_CHECK_EQUAL( std::count_if( records.begin(), records.end(), [&design]( const std::string& r ) { return r.find( "{\"design\": \"" + design + "\", " ) == 0u; } ), 2 );
+  }
+
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    BOOST_CHECK( content.find( "d" + std::to_string( i ) + ".txt\", \"status\": true" ) != std::string::npos );
+    BOOST_CHECK( content.find( "\"value\": " + std::to_string( 10u * i ) ) != std::string::npos );
+  }
+  BOOST_CHECK( content.find( "missing.txt\", \"status\": false" ) != std::string::npos );
+  BOOST_CHECK( content.find( "\"stores_after\": {\"counters\": 2}" ) != std::string::npos );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
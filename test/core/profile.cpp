@@ -0,0 +1,186 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE profile
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/included/unit_test.hpp>
+
+#include <alice/alice.hpp>
+#include <core/cli/cirkit_command.hpp>
+
+namespace alice
+{
+
+struct counter_t
+{
+  unsigned value = 0u;
+};
+
+template<>
+struct store_info<counter_t>
+{
+  static constexpr const char* key         = "counters";
+  static constexpr const char* option      = "counter";
+  static constexpr const char* mnemonic    = "";
+  static constexpr const char* name        = "counter";
+  static constexpr const char* name_plural = "counters";
+};
+
+}
+
+using namespace cirkit;
+
+class grow_command : public cirkit_command
+{
+public:
+  grow_command( const environment::ptr& env ) : cirkit_command( env, "Add counter" ) {}
+
+protected:
+  bool execute()
+  {
+    auto& store = env->store<counter_t>();
+    store.extend();
+    store.current().value = store.size();
+
+    statistics->set( "value", store.current().value );
+    statistics->set( "runtime", 0.5 );
+    statistics->set( "calls", 42ul );
+    statistics->set( "conflicts", 1ull << 40u );
+    statistics->set( "samples", std::vector<double>{0.25, 1.5} );
+    return true;
+  }
+};
+
+BOOST_AUTO_TEST_CASE(records)
+{
+  const auto filename = ( boost::filesystem::temp_directory_path() / boost::filesystem::unique_path() ).string();
+
+  cli_main<counter_t> cli( "test" );
+  cli.insert_command( "grow", std::make_shared<grow_command>( cli.env ) );
+
+  std::vector<std::string> args = {"test", "-p", filename, "-c", "grow; grow; profile"};
+  std::vector<char*> argv;
+  for ( auto& a : args )
+  {
+    argv.push_back( &a[0] );
+  }
+  BOOST_CHECK_EQUAL( cli.run( argv.size(), &argv[0] ), 0 );
+  cli.env->profiler.close();
+
+  const auto& records = cli.env->profile_records;
+  BOOST_REQUIRE_EQUAL( records.size(), 2u );
+
+  for ( auto i = 0u; i < 2u; ++i )
+  {
+    BOOST_CHECK_EQUAL( records[i].name, "grow" );
+    BOOST_CHECK( records[i].status );
+    BOOST_CHECK( records[i].wall >= 0.0 );
+    BOOST_CHECK_EQUAL( records[i].stores_before.at( "counters" ), i );
+    BOOST_CHECK_EQUAL( records[i].stores_after.at( "counters" ), i + 1u );
+    BOOST_REQUIRE( records[i].statistics );
+    BOOST_CHECK( boost::get<unsigned>( records[i].statistics->at( "value" ) ) == i + 1u );
+    BOOST_CHECK( boost::get<unsigned long>( records[i].statistics->at( "calls" ) ) == 42ul );
+    BOOST_CHECK( boost::get<unsigned long long>( records[i].statistics->at( "conflicts" ) ) == 1ull << 40u );
+    BOOST_CHECK( boost::get<std::vector<double>>( records[i].statistics->at( "samples" ) ) == std::vector<double>( {0.25, 1.5} ) );
+  }
+
+  std::ifstream in( filename.c_str() );
+  std::vector<std::string> lines;
+  std::string line;
+  while ( std::getline( in, line ) )
+  {
+    lines.push_back( line );
+  }
+  boost::filesystem::remove( filename );
+
+  BOOST_REQUIRE_EQUAL( lines.size(), 2u );
+  BOOST_CHECK( lines[1].find( "\"command\": \"grow\"" ) != std::string::npos );
+  BOOST_CHECK( lines[1].find( "\"stores_before\": {\"counters\": 1}" ) != std::string::npos );
+  BOOST_CHECK( lines[1].find( "\"statistics\": {\"calls\": 42, \"conflicts\": 1099511627776, \"runtime\": 0.5, \"samples\": [0.25, 1.5], \"value\": 2}" ) != std::string::npos );
+}
+
+BOOST_AUTO_TEST_CASE(read_records)
+{
+  const auto filename = ( boost::filesystem::temp_directory_path() / boost::filesystem::unique_path() ).string();
+
+  const auto run = []( cli_main<counter_t>& cli, std::vector<std::string> args ) {
+    std::vector<char*> argv;
+    for ( auto& a : args )
+    {
+      argv.push_back( &a[0] );
+    }
+    return cli.run( argv.size(), &argv[0] );
+  };
+
+  cli_main<counter_t> writer( "test" );
+  writer.insert_command( "grow", std::make_shared<grow_command>( writer.env ) );
+  BOOST_CHECK_EQUAL( run( writer, {"test", "-c", "grow; grow; grow; profile -w " + filename} ), 0 );
+
+  cli_main<counter_t> reader( "test" );
+  BOOST_CHECK_EQUAL( run( reader, {"test", "-c", "profile -r " + filename} ), 0 );
+  boost::filesystem::remove( filename );
+
+  BOOST_CHECK( reader.env->profile_records.empty() );
+
+  const auto log = reader.env->commands.at( "profile" )->log();
+  BOOST_REQUIRE( log );
+  BOOST_CHECK( boost::get<std::vector<std::string>>( log->at( "hotspots" ) ) == std::vector<std::string>( {"grow"} ) );
+  BOOST_CHECK( boost::get<std::vector<unsigned>>( log->at( "calls" ) ) == std::vector<unsigned>( {3u} ) );
+}
+
+BOOST_AUTO_TEST_CASE(limit)
+{
+  cli_main<counter_t> cli( "test" );
+  cli.insert_command( "grow", std::make_shared<grow_command>( cli.env ) );
+  BOOST_CHECK_EQUAL( cli.env->max_profile_records, 1000u );
+
+  std::vector<std::string> args = {"test", "-c", "grow; profile -l 2; grow; grow; grow; profile"};
+  std::vector<char*> argv;
+  for ( auto& a : args )
+  {
+    argv.push_back( &a[0] );
+  }
+  BOOST_CHECK_EQUAL( cli.run( argv.size(), &argv[0] ), 0 );
+
+  const auto& records = cli.env->profile_records;
+  BOOST_CHECK_EQUAL( cli.env->max_profile_records, 2u );
+  BOOST_REQUIRE_EQUAL( records.size(), 2u );
+  BOOST_CHECK_EQUAL( records[0].stores_before.at( "counters" ), 2u );
+  BOOST_CHECK_EQUAL( records[1].stores_before.at( "counters" ), 3u );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End:
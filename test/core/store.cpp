@@ -0,0 +1,220 @@
+/* CirKit: A circuit toolkit
+ * Copyright (C) 2009-2015  University of Bremen
+ * Copyright (C) 2015-2016  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE store
+
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+#include <boost/test/included/unit_test.hpp>
+
+#include <alice/command.hpp>
+
+namespace alice
+{
+
+using values_t = std::vector<unsigned>;
+
+template<>
+std::size_t store_entry_memory<values_t>( const values_t& v )
+{
+  return v.size() * sizeof( unsigned );
+}
+
+template<>
+bool store_can_spill<values_t>() { return true; }
+
+template<>
+void store_write_spill<values_t>( std::ostream& os, const values_t& v )
+{
+  for ( auto x : v ) { os << x << ' '; }
+}
+
+template<>
+values_t store_read_spill<values_t>( std::istream& is )
+{
+  return values_t( std::istream_iterator<unsigned>( is ), std::istream_iterator<unsigned>() );
+}
+
+}
+
+using namespace alice;
+
+BOOST_AUTO_TEST_CASE(copy_on_write)
+{
+  cli_store<values_t> store( "values" );
+
+  store.extend();
+  store.current().assign( 100u, 1u );
+  store.copy_current();
+
+  BOOST_CHECK_EQUAL( store.size(), 2u );
+  BOOST_CHECK_EQUAL( store.current_index(), 1 );
+
+  /* shared entries are counted once */
+  BOOST_CHECK_EQUAL( store.memory(), 400u );
+
+  const auto handle = store.handle( 0u );
+  BOOST_CHECK( handle == store.handle( 1u ) );
+
+  /* modification detaches */
+  store.current()[0u] = 2u;
+  BOOST_CHECK_EQUAL( store[0u][0u], 1u );
+  BOOST_CHECK_EQUAL( store[1u][0u], 2u );
+  BOOST_CHECK_EQUAL( store.memory(), 800u );
+
+  /* handles stay valid */
+  BOOST_CHECK_EQUAL( ( *handle )[0u], 1u );
+}
+
+BOOST_AUTO_TEST_CASE(read_without_copy)
+{
+  cli_store<values_t> store( "values" );
+
+  store.extend();
+  store.current().assign( 100u, 1u );
+  store.copy_current();
+
+  /* reading through a const store keeps the entries shared */
+  const auto& entries = store;
+  BOOST_CHECK_EQUAL( entries.current()[0u], 1u );
+  BOOST_CHECK_EQUAL( entries[0u][0u], 1u );
+  BOOST_CHECK( store.handle( 0u ) == store.handle( 1u ) );
+  BOOST_CHECK_EQUAL( store.memory(), 400u );
+
+  /* write access detaches */
+  store.current_mutable()[0u] = 2u;
+  BOOST_CHECK( store.handle( 0u ) != store.handle( 1u ) );
+  BOOST_CHECK_EQUAL( entries[0u][0u], 1u );
+  BOOST_CHECK_EQUAL( entries[1u][0u], 2u );
+
+  store.copy_current();
+  store.modify( 1u )[1u] = 3u;
+  BOOST_CHECK( store.handle( 1u ) != store.handle( 2u ) );
+  BOOST_CHECK_EQUAL( entries[2u][1u], 1u );
+}
+
+BOOST_AUTO_TEST_CASE(spill)
+{
+  cli_store<values_t> store( "values" );
+
+  for ( auto i = 0u; i < 5u; ++i )
+  {
+    store.extend();
+    store.current().assign( 256u, i );
+  }
+  BOOST_CHECK_EQUAL( store.memory(), 5u * 1024u );
+
+  /* touch entry 0 such that 1 and 2 are least recently used */
+  const auto& first = static_cast<const cli_store<values_t>&>( store )[0u];
+  BOOST_CHECK_EQUAL( first.size(), 256u );
+
+  store.set_memory_limit( 3u * 1024u );
+  store.enforce_memory_limit();
+
+  BOOST_CHECK( !store.is_spilled( 0u ) );
+  BOOST_CHECK( store.is_spilled( 1u ) );
+  BOOST_CHECK( store.is_spilled( 2u ) );
+  BOOST_CHECK( !store.is_spilled( 3u ) );
+  BOOST_CHECK( !store.is_spilled( 4u ) );
+  BOOST_CHECK_EQUAL( store.memory(), 3u * 1024u );
+  BOOST_CHECK_EQUAL( store.entry_memory( 1u ), 1024u );
+
+  /* reload on access */
+  BOOST_CHECK( store[1u] == values_t( 256u, 1u ) );
+  BOOST_CHECK( !store.is_spilled( 1u ) );
+
+  /* current entry is never spilled */
+  store.set_memory_limit( 1u );
+  store.enforce_memory_limit();
+  for ( auto i = 0u; i < 4u; ++i )
+  {
+    BOOST_CHECK( store.is_spilled( i ) );
+  }
+  BOOST_CHECK( !store.is_spilled( 4u ) );
+
+  for ( auto i = 0u; i < 5u; ++i )
+  {
+    BOOST_CHECK( store[i] == values_t( 256u, i ) );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(respill)
+{
+  cli_store<values_t> store( "values" );
+
+  for ( auto i = 0u; i < 3u; ++i )
+  {
+    store.extend();
+    store.current().assign( 256u, i );
+  }
+
+  store.set_memory_limit( 1u );
+  store.enforce_memory_limit();
+  const auto size = store.spill_file_size();
+  BOOST_CHECK( size > 0u );
+
+  /* unmodified entries are not written again */
+  for ( auto k = 0u; k < 3u; ++k )
+  {
+    BOOST_CHECK( static_cast<const cli_store<values_t>&>( store )[0u] == values_t( 256u, 0u ) );
+    store.enforce_memory_limit();
+    BOOST_CHECK( store.is_spilled( 0u ) );
+  }
+  BOOST_CHECK_EQUAL( store.spill_file_size(), size );
+
+  /* modified entries that still fit are rewritten into their slot */
+  for ( auto k = 0u; k < 3u; ++k )
+  {
+    store.modify( 0u ).assign( 256u, 7u );
+    store.enforce_memory_limit();
+    BOOST_CHECK( store.is_spilled( 0u ) );
+  }
+  BOOST_CHECK_EQUAL( store.spill_file_size(), size );
+  BOOST_CHECK( store[0u] == values_t( 256u, 7u ) );
+
+  /* a grown entry moves, and its old slot is taken by the next entry that fits */
+  store.modify( 0u ).assign( 1024u, 8u );
+  store.enforce_memory_limit();
+  const auto grown = store.spill_file_size();
+  BOOST_CHECK( grown > size );
+
+  store.modify( 1u ).assign( 256u, 9u );
+  store.enforce_memory_limit();
+  BOOST_CHECK_EQUAL( store.spill_file_size(), grown );
+
+  BOOST_CHECK( store[0u] == values_t( 1024u, 8u ) );
+  BOOST_CHECK( store[1u] == values_t( 256u, 9u ) );
+  BOOST_CHECK( store[2u] == values_t( 256u, 2u ) );
+}
+
+// Local Variables:
+// c-basic-offset: 2
+// eval: (c-set-offset 'substatement-open 0)
+// eval: (c-set-offset 'innamespace 0)
+// End: